@@ -64,6 +64,8 @@ std::vector<knp::core::messaging::SpikeMessage> run_mnist_inference(
     // Receives a link to the output channel object (out_channel) from
     // the model executor (model_executor) by the output channel ID (o_channel_uid).
     auto &out_channel = model_executor.get_loader().get_output_channel(o_channel_uid);
+    // Spikes are read after the whole inference, so the channel keeps all its steps.
+    out_channel.set_max_buffered_steps(testing_period);
 
     model_executor.get_backend()->stop_learning();
     std::vector<InferenceResult> result;
@@ -21,8 +21,8 @@
 
 #include "logging.h"
 
+#include <knp/core/all_projections.h>
 #include <knp/core/messaging/messaging.h>
-#include <knp/core/projection.h>
 #include <knp/framework/model_executor.h>
 #include <knp/synapse-traits/stdp_synaptic_resource_rule.h>
 
@@ -192,7 +192,8 @@ void add_aggregate_logger(
         all_senders_uids.push_back(pop_uid);
     }
     write_aggregated_log_header(log_stream, all_senders_names);
+    // The logger only uses its own state, so writing the log is moved out of the simulation thread.
     model_executor.add_observer<knp::core::messaging::SpikeMessage>(
         make_aggregate_observer(log_stream, aggregation_period, all_senders_names, spike_accumulator, current_index),
-        all_senders_uids);
+        all_senders_uids, 64, knp::framework::monitoring::OverflowPolicy::block);
 }
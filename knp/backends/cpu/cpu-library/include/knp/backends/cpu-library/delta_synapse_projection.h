@@ -22,6 +22,8 @@
 #include <knp/backends/cpu-library/impl/delta_synapse_projection_impl.h>
 
 #include <unordered_map>
+#include <utility>
+#include <vector>
 /**
  * @brief Namespace for CPU backends.
  */
@@ -34,13 +36,115 @@ namespace knp::backends::cpu
  * @param endpoint message endpoint used for message exchange.
  * @param future_messages message queue to process via endpoint.
  * @param step_n execution step.
+ * @return number of synaptic impacts sent by the projection.
  */
 template <class DeltaLikeSynapseType>
-void calculate_delta_synapse_projection(
+size_t calculate_delta_synapse_projection(
     knp::core::Projection<DeltaLikeSynapseType> &projection, knp::core::MessageEndpoint &endpoint,
     MessageQueue &future_messages, size_t step_n)
 {
-    calculate_delta_synapse_projection_impl<DeltaLikeSynapseType>(projection, endpoint, future_messages, step_n);
+    double spike_density = 0;
+    std::vector<uint32_t> spike_mask;
+    std::vector<size_t> activated_synapses;
+    return calculate_delta_synapse_projection_impl<DeltaLikeSynapseType>(
+        projection, endpoint, future_messages, step_n, ProjectionKernel::fan_out, spike_density, spike_mask,
+        activated_synapses, false);
+}
+
+
+/**
+ * @brief Make one execution step for a projection of delta synapses with a given kernel.
+ * @details Use `select_projection_kernel()` to choose the kernel by the spike density estimate, which is updated
+ * by the function.
+ * @tparam DeltaLikeSynapseType type of a synapse that requires synapse weight and delay as parameters.
+ * @param projection projection to update.
+ * @param endpoint message endpoint used for message exchange.
+ * @param future_messages message queue to process via endpoint.
+ * @param step_n execution step.
+ * @param kernel kernel that calculates impacts.
+ * @param spike_density spike density estimate of the projection.
+ * @param spike_mask spike mask buffer of the projection used by the dense kernel. Keep it between steps to avoid
+ * allocating it on each step.
+ * @param activated_synapses activated synapse buffer of the projection used by the fan-out kernel. Keep it between
+ * steps to avoid allocating it on each step.
+ * @param aggregate_impacts `true` to send impacts as an aggregated impact message.
+ * @return number of synaptic impacts sent by the projection.
+ */
+template <class DeltaLikeSynapseType>
+size_t calculate_delta_synapse_projection(
+    knp::core::Projection<DeltaLikeSynapseType> &projection, knp::core::MessageEndpoint &endpoint,
+    MessageQueue &future_messages, size_t step_n, ProjectionKernel kernel, double &spike_density,
+    std::vector<uint32_t> &spike_mask, std::vector<size_t> &activated_synapses, bool aggregate_impacts = false)
+{
+    return calculate_delta_synapse_projection_impl<DeltaLikeSynapseType>(
+        projection, endpoint, future_messages, step_n, kernel, spike_density, spike_mask, activated_synapses,
+        aggregate_impacts);
+}
+
+
+/**
+ * @brief Make one execution step for a compact projection.
+ * @tparam SynapseType projection synapse type.
+ * @param projection projection to calculate.
+ * @param endpoint message endpoint used for message exchange.
+ * @param future_messages message queue to process via endpoint.
+ * @param step_n execution step.
+ * @param aggregate_impacts `true` to send impacts as an aggregated impact message.
+ * @return number of synaptic impacts sent by the projection.
+ */
+template <class SynapseType>
+size_t calculate_compact_projection(
+    const knp::core::CompactProjection<SynapseType> &projection, knp::core::MessageEndpoint &endpoint,
+    MessageQueue &future_messages, size_t step_n, bool aggregate_impacts = false)
+{
+    SPDLOG_DEBUG("Calculating compact projection...");
+    const auto messages = endpoint.unload_messages<core::messaging::SpikeMessage>(projection.get_uid());
+    const auto out_iter = calculate_compact_projection_data(projection, messages, future_messages, step_n);
+    return send_current_impacts(endpoint, future_messages, out_iter, aggregate_impacts);
+}
+
+
+/**
+ * @brief Make one execution step for a procedural projection.
+ * @tparam SynapseType projection synapse type.
+ * @param projection projection to calculate.
+ * @param endpoint message endpoint used for message exchange.
+ * @param future_messages message queue to process via endpoint.
+ * @param step_n execution step.
+ * @param aggregate_impacts `true` to send impacts as an aggregated impact message.
+ * @return number of synaptic impacts sent by the projection.
+ */
+template <class SynapseType>
+size_t calculate_procedural_projection(
+    const knp::core::ProceduralProjection<SynapseType> &projection, knp::core::MessageEndpoint &endpoint,
+    MessageQueue &future_messages, size_t step_n, bool aggregate_impacts = false)
+{
+    SPDLOG_DEBUG("Calculating procedural projection...");
+    const auto messages = endpoint.unload_messages<core::messaging::SpikeMessage>(projection.get_uid());
+    const auto out_iter = calculate_procedural_projection_data(projection, messages, future_messages, step_n);
+    return send_current_impacts(endpoint, future_messages, out_iter, aggregate_impacts);
+}
+
+
+/**
+ * @brief Make one execution step for a convolution projection.
+ * @tparam SynapseType projection synapse type.
+ * @param projection projection to calculate.
+ * @param endpoint message endpoint used for message exchange.
+ * @param future_messages message queue to process via endpoint.
+ * @param step_n execution step.
+ * @param aggregate_impacts `true` to send impacts as an aggregated impact message.
+ * @return number of synaptic impacts sent by the projection.
+ */
+template <class SynapseType>
+size_t calculate_convolution_projection(
+    const knp::core::ConvolutionProjection<SynapseType> &projection, knp::core::MessageEndpoint &endpoint,
+    MessageQueue &future_messages, size_t step_n, bool aggregate_impacts = false)
+{
+    SPDLOG_DEBUG("Calculating convolution projection...");
+    const auto messages = endpoint.unload_messages<core::messaging::SpikeMessage>(projection.get_uid());
+    const auto out_iter = calculate_convolution_projection_data(projection, messages, future_messages, step_n);
+    return send_current_impacts(endpoint, future_messages, out_iter, aggregate_impacts);
 }
 
 
@@ -63,4 +167,52 @@ void calculate_projection_part(
     calculate_projection_part_impl(projection, message_in_data, future_messages, step_n, part_start, part_size, mutex);
 }
 
+
+/**
+ * @brief Calculate impacts of a part of projection synapses without adding them to the message queue.
+ * @details Parts can be calculated in parallel. If impacts of parts are added to the queue by `add_future_impacts()`
+ * in part order, impacts are ordered by synapse index as impacts of `calculate_projection_fan_out()`.
+ * @tparam DeltaLikeSynapse type of a synapse that requires synapse weight and delay as parameters.
+ * @param projection projection to receive the message.
+ * @param message_in_data processed spike data for the projection.
+ * @param impacts container to which impacts of the part are appended.
+ * @param step_n current step.
+ * @param part_start index of the starting synapse.
+ * @param part_size number of synapses to process.
+ */
+template <class DeltaLikeSynapse>
+void calculate_projection_part_impacts(
+    knp::core::Projection<DeltaLikeSynapse> &projection,
+    const std::unordered_map<knp::core::Step, size_t> &message_in_data, FutureImpacts &impacts, uint64_t step_n,
+    size_t part_start, size_t part_size)
+{
+    calculate_projection_part_impacts_impl(projection, message_in_data, impacts, step_n, part_start, part_size);
+}
+
+
+/**
+ * @brief Process synapses of spiked neurons found by the projection index.
+ * @details The function makes the same impacts as processing all parts of the projection by
+ * `calculate_projection_part()`, but is faster if few presynaptic neurons spiked. Impacts are ordered by synapse
+ * index.
+ * @tparam DeltaLikeSynapse type of a synapse that requires synapse weight and delay as parameters.
+ * @param projection projection to receive the message.
+ * @param message_in_data processed spike data for the projection.
+ * @param future_messages queue of future messages.
+ * @param step_n current step.
+ * @param activated_synapses buffer of activated synapses with spike counts. Keep it between steps to avoid
+ * allocating it on each step.
+ * @param mutex mutex.
+ * @return number of impacts added to the queue.
+ */
+template <class DeltaLikeSynapse>
+size_t calculate_projection_fan_out(
+    knp::core::Projection<DeltaLikeSynapse> &projection,
+    const std::unordered_map<knp::core::Step, size_t> &message_in_data, MessageQueue &future_messages, uint64_t step_n,
+    std::vector<std::pair<size_t, size_t>> &activated_synapses, std::mutex &mutex)
+{
+    return calculate_projection_fan_out_impl(
+        projection, message_in_data, future_messages, step_n, activated_synapses, mutex);
+}
+
 }  // namespace knp::backends::cpu
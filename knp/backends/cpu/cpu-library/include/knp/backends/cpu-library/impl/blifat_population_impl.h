@@ -110,35 +110,105 @@ void impact_neuron(
 
 
 /**
- * @brief Process messages sent to the current population.
+ * @brief Apply impacts of a synaptic impact message to a population.
  * @param population population to update.
- * @param messages synaptic impact messages sent to the population.
- * @note The method is used for parallelization. See later if this method serves as a bottleneck.
+ * @param message synaptic impact message sent to the population.
  */
 template <class BlifatLikeNeuron>
-void process_inputs(
-    knp::core::Population<BlifatLikeNeuron> &population,
-    const std::vector<core::messaging::SynapticImpactMessage> &messages)
+void process_impact_message(
+    knp::core::Population<BlifatLikeNeuron> &population, const core::messaging::SynapticImpactMessage &message)
 {
-    SPDLOG_TRACE("Process inputs.");
-    for (const auto &message : messages)
+    for (const auto &impact : message.impacts_)
     {
-        for (const auto &impact : message.impacts_)
+        auto &neuron = population[impact.postsynaptic_neuron_index_];
+        impact_neuron<BlifatLikeNeuron>(neuron, impact.synapse_type_, impact.impact_value_);
+        if constexpr (has_dopamine_plasticity<BlifatLikeNeuron>())
         {
-            auto &neuron = population[impact.postsynaptic_neuron_index_];
-            impact_neuron<BlifatLikeNeuron>(neuron, impact.synapse_type_, impact.impact_value_);
+            if (impact.synapse_type_ == synapse_traits::OutputType::EXCITATORY)
+            {
+                neuron.is_being_forced_ |= message.is_forcing_;
+            }
+        }
+    }
+}
+
+
+/**
+ * @brief Apply impacts of an aggregated impact message to a population.
+ * @details The result is the same as applying the synaptic impact message that was aggregated.
+ * @param population population to update.
+ * @param message aggregated impact message sent to the population.
+ */
+template <class BlifatLikeNeuron>
+void process_impact_message(
+    knp::core::Population<BlifatLikeNeuron> &population, const core::messaging::AggregatedImpactMessage &message)
+{
+    for (const auto &impacts : message.impacts_)
+    {
+        const bool is_forcing = message.is_forcing_ && impacts.synapse_type_ == synapse_traits::OutputType::EXCITATORY;
+        for (size_t value_index = 0; value_index < impacts.values_.size(); ++value_index)
+        {
+            auto &neuron = population[impacts.is_dense() ? value_index : impacts.neuron_indexes_[value_index]];
+            impact_neuron<BlifatLikeNeuron>(neuron, impacts.synapse_type_, impacts.values_[value_index]);
             if constexpr (has_dopamine_plasticity<BlifatLikeNeuron>())
             {
-                if (impact.synapse_type_ == synapse_traits::OutputType::EXCITATORY)
-                {
-                    neuron.is_being_forced_ |= message.is_forcing_;
-                }
+                neuron.is_being_forced_ |= is_forcing;
             }
         }
     }
 }
 
 
+/**
+ * @brief Process synaptic impact and aggregated impact messages sent to the current population.
+ * @details Messages of both types are applied in the order of sender UIDs, and messages of the same sender in the
+ * order they were received. Impacts that depend on the order, such as blocking ones, have the same effect whether
+ * a projection sends aggregated impact messages or not.
+ * @param population population to update.
+ * @param messages synaptic impact messages sent to the population.
+ * @param aggregated_messages aggregated impact messages sent to the population.
+ * @note The method is used for parallelization.
+ */
+template <class BlifatLikeNeuron>
+void process_inputs(
+    knp::core::Population<BlifatLikeNeuron> &population,
+    const std::vector<core::messaging::SynapticImpactMessage> &messages,
+    const std::vector<core::messaging::AggregatedImpactMessage> &aggregated_messages)
+{
+    SPDLOG_TRACE("Process inputs.");
+    // Indexes of aggregated impact messages follow indexes of synaptic impact messages.
+    std::vector<std::pair<const core::UID *, size_t>> order;
+    order.reserve(messages.size() + aggregated_messages.size());
+    for (const auto &message : messages) order.emplace_back(&message.header_.sender_uid_, order.size());
+    for (const auto &message : aggregated_messages) order.emplace_back(&message.header_.sender_uid_, order.size());
+    std::stable_sort(
+        order.begin(), order.end(), [](const auto &first, const auto &second) { return *first.first < *second.first; });
+
+    for (const auto &[sender_uid, message_index] : order)
+    {
+        if (message_index < messages.size())
+            process_impact_message(population, messages[message_index]);
+        else
+            process_impact_message(population, aggregated_messages[message_index - messages.size()]);
+    }
+}
+
+
+/**
+ * @brief Process messages sent to the current population.
+ * @param population population to update.
+ * @param messages synaptic impact messages sent to the population.
+ * @note The method is used for parallelization. See later if this method serves as a bottleneck.
+ */
+template <class BlifatLikeNeuron>
+void process_inputs(
+    knp::core::Population<BlifatLikeNeuron> &population,
+    const std::vector<core::messaging::SynapticImpactMessage> &messages)
+{
+    process_inputs(population, messages, {});
+}
+
+
 /**
  * @brief Calculate a single neuron state before impacts.
  * @tparam BlifatLikeNeuron type of neuron which inference can be calculated as for a BLIFAT neuron.
@@ -195,14 +265,16 @@ void calculate_neurons_state_part(
  * @tparam BlifatLikeNeuron type of neuron which inference can be calculated as for a BLIFAT neuron.
  * @param population neurons population.
  * @param messages messages from the projection to the populations.
+ * @param aggregated_messages aggregated impact messages from projections to the population.
  */
 template <class BlifatLikeNeuron>
 void calculate_neurons_state(
     knp::core::Population<BlifatLikeNeuron> &population,
-    const std::vector<core::messaging::SynapticImpactMessage> &messages)
+    const std::vector<core::messaging::SynapticImpactMessage> &messages,
+    const std::vector<core::messaging::AggregatedImpactMessage> &aggregated_messages = {})
 {
     calculate_neurons_state_part(population, 0, population.size());
-    process_inputs(population, messages);
+    process_inputs(population, messages, aggregated_messages);
 }
 
 
@@ -330,7 +402,9 @@ knp::core::messaging::SpikeData calculate_blifat_population_data(
     std::vector<core::messaging::SynapticImpactMessage> messages =
         endpoint.unload_messages<core::messaging::SynapticImpactMessage>(population.get_uid());
 
-    calculate_neurons_state(population, messages);
+    calculate_neurons_state(
+        population, messages,
+        endpoint.unload_messages<core::messaging::AggregatedImpactMessage>(population.get_uid()));
     knp::core::messaging::SpikeData neuron_indexes;
     calculate_neurons_post_input_state(population, neuron_indexes);
 
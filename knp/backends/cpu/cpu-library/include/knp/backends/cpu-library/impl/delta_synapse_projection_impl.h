@@ -21,7 +21,10 @@
 
 #pragma once
 
+#include <knp/core/compact_projection.h>
+#include <knp/core/convolution_projection.h>
 #include <knp/core/message_bus.h>
+#include <knp/core/procedural_projection.h>
 #include <knp/core/projection.h>
 #include <knp/synapse-traits/delta.h>
 
@@ -29,6 +32,7 @@
 
 #include <algorithm>
 #include <mutex>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -47,6 +51,12 @@ namespace knp::backends::cpu
 using MessageQueue = std::unordered_map<uint64_t, knp::core::messaging::SynapticImpactMessage>;
 
 
+/**
+ * @brief Type of a container of impacts paired with steps on which they are sent.
+ */
+using FutureImpacts = std::vector<std::pair<uint64_t, knp::core::messaging::SynapticImpact>>;
+
+
 template <class DeltaLikeSynapse>
 void calculate_projection_part_impl(
     knp::core::Projection<DeltaLikeSynapse> &projection,
@@ -55,9 +65,46 @@ void calculate_projection_part_impl(
 
 
 template <class DeltaLikeSynapse>
-void calculate_delta_synapse_projection_impl(
+void calculate_projection_part_impacts_impl(
+    knp::core::Projection<DeltaLikeSynapse> &projection,
+    const std::unordered_map<knp::core::Step, size_t> &message_in_data, FutureImpacts &container, uint64_t step_n,
+    size_t part_start, size_t part_size);
+
+
+template <class DeltaLikeSynapse>
+void add_future_impacts(
+    const knp::core::Projection<DeltaLikeSynapse> &projection, const FutureImpacts &container,
+    MessageQueue &future_messages, uint64_t step_n, std::mutex &mutex);
+
+
+template <class DeltaLikeSynapse>
+size_t calculate_projection_fan_out_impl(
+    knp::core::Projection<DeltaLikeSynapse> &projection,
+    const std::unordered_map<knp::core::Step, size_t> &message_in_data, MessageQueue &future_messages, uint64_t step_n,
+    std::vector<std::pair<size_t, size_t>> &activated_synapses, std::mutex &mutex);
+
+
+/**
+ * @brief Strategy of projection impact calculation.
+ */
+enum class ProjectionKernel
+{
+    /**
+     * @brief Synapses of each spiked neuron are found by the projection index.
+     */
+    fan_out,
+    /**
+     * @brief All projection synapses are swept in storage order, synapses of neurons that didn't spike are masked.
+     */
+    dense
+};
+
+
+template <class DeltaLikeSynapse>
+size_t calculate_delta_synapse_projection_impl(
     knp::core::Projection<DeltaLikeSynapse> &projection, knp::core::MessageEndpoint &endpoint,
-    MessageQueue &future_messages, size_t step_n);
+    MessageQueue &future_messages, size_t step_n, ProjectionKernel kernel, double &spike_density,
+    std::vector<uint32_t> &spike_mask, std::vector<size_t> &activated_synapses, bool aggregate_impacts);
 
 
 template <class ProjectionType>
@@ -74,56 +121,476 @@ constexpr bool is_forcing<knp::core::Projection<synapse_traits::DeltaSynapse>>()
 }
 
 
-template <typename ProjectionType>
-MessageQueue::const_iterator calculate_delta_synapse_projection_data(
+/**
+ * @brief Get synapse parameters declared uniform for all projection synapses.
+ * @param projection projection.
+ * @tparam ProjectionType projection type.
+ * @return shared parameters of a delta synapse projection, no uniform parameters for other projections.
+ */
+template <class ProjectionType>
+synapse_traits::shared_synapse_parameters<synapse_traits::DeltaSynapse> get_uniform_parameters(
+    const ProjectionType &projection)
+{
+    if constexpr (std::is_same_v<typename ProjectionType::ProjectionSynapseType, synapse_traits::DeltaSynapse>)
+        return projection.get_shared_parameters().synapses_parameters_;
+    else
+        return {};
+}
+
+
+/**
+ * @brief Run a kernel with a function that returns synapse parameters used by the projection.
+ * @details If the projection declares no uniform parameters, the kernel gets a function that returns per-synapse
+ * parameters as they are, so that the kernel instantiated for this common case doesn't check uniform parameters for
+ * each synapse.
+ * @param uniform_params uniform parameters of the projection.
+ * @param kernel generic callable that takes the synapse parameters function.
+ * @tparam Kernel kernel type.
+ * @return kernel result.
+ */
+template <class Kernel>
+auto with_synapse_parameters(
+    const synapse_traits::shared_synapse_parameters<synapse_traits::DeltaSynapse> &uniform_params, Kernel &&kernel)
+{
+    if (!uniform_params.weight_ && !uniform_params.delay_ && !uniform_params.output_type_)
+    {
+        return kernel([](const auto &synapse_params) -> const auto & { return synapse_params; });
+    }
+    return kernel([&uniform_params](const auto &synapse_params) { return uniform_params.apply(synapse_params); });
+}
+
+
+/**
+ * @brief Get impacts of a future message, the message is created if the queue doesn't contain it.
+ * @param projection projection that sends the message.
+ * @param future_messages queue of future impact messages.
+ * @param future_step step on which the message is sent.
+ * @param step_n current step.
+ * @param forcing `true` if impacts are forcing.
+ * @tparam ProjectionType projection type.
+ * @return reference to the message impacts. The reference stays valid when other messages are added to the queue.
+ */
+template <class ProjectionType>
+std::vector<knp::core::messaging::SynapticImpact> &get_future_impacts(
+    const ProjectionType &projection, MessageQueue &future_messages, uint64_t future_step, size_t step_n,
+    bool forcing)
+{
+    auto iter = future_messages.find(future_step);
+    if (iter == future_messages.end())
+    {
+        iter = future_messages
+                   .emplace(
+                       future_step, knp::core::messaging::SynapticImpactMessage{
+                                        {projection.get_uid(), step_n},
+                                        projection.get_presynaptic(),
+                                        projection.get_postsynaptic(),
+                                        forcing,
+                                        {}})
+                   .first;
+    }
+    return iter->second.impacts_;
+}
+
+
+/**
+ * @brief Number of delays for which `DelaySlots` keeps message references.
+ */
+constexpr uint64_t max_delay_slots = 1024;
+
+
+/**
+ * @brief The DelaySlots class is a definition of future message impacts indexed by synapse delay.
+ * @details A message is found in the queue on the first impact with its delay, and further impacts with this delay
+ * are appended to the message by the delay index, so that the queue isn't searched for each impact. Messages of
+ * delays not less than `max_delay_slots` are searched in the queue.
+ * @tparam ProjectionType projection type.
+ */
+template <class ProjectionType>
+class DelaySlots
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param projection projection that sends messages.
+     * @param future_messages queue of future impact messages.
+     * @param step_n current step.
+     * @param forcing `true` if impacts are forcing.
+     */
+    DelaySlots(const ProjectionType &projection, MessageQueue &future_messages, uint64_t step_n, bool forcing)
+        : projection_(projection), future_messages_(future_messages), step_n_(step_n), forcing_(forcing)
+    {
+    }
+
+    /**
+     * @brief Get impacts of the message that is received after the given delay.
+     * @param delay synapse delay.
+     * @return reference to the message impacts.
+     */
+    std::vector<knp::core::messaging::SynapticImpact> &operator[](uint64_t delay)
+    {
+        if (delay >= max_delay_slots) return find_impacts(delay);
+        if (delay >= slots_.size()) slots_.resize(delay + 1, nullptr);
+        auto &slot = slots_[delay];
+        if (!slot) slot = &find_impacts(delay);
+        return *slot;
+    }
+
+private:
+    std::vector<knp::core::messaging::SynapticImpact> &find_impacts(uint64_t delay)
+    {
+        // The message is sent on step N - 1, received on step N.
+        return get_future_impacts(projection_, future_messages_, delay + step_n_ - 1, step_n_, forcing_);
+    }
+
+    const ProjectionType &projection_;
+    MessageQueue &future_messages_;
+    uint64_t step_n_;
+    bool forcing_;
+    std::vector<std::vector<knp::core::messaging::SynapticImpact> *> slots_;
+};
+
+
+/**
+ * @brief Fraction of activated projection synapses above which the dense kernel is faster than the fan-out kernel.
+ * @details The fan-out kernel makes an index lookup and a random memory access for each activated synapse, while the
+ * dense kernel reads all synapses sequentially. The value is measured by the `cpu_projection_kernel` benchmark on a
+ * delta synapse projection of 200000 synapses with a fan-out of 100 synapses: the kernels are equally fast between
+ * 2% and 3% of activated synapses.
+ */
+constexpr double dense_kernel_crossover = 0.03;
+
+
+/**
+ * @brief Weight of the last step in the spike density estimate.
+ */
+constexpr double spike_density_smoothing = 0.25;
+
+
+/**
+ * @brief Select projection kernel by spike density.
+ * @param spike_density estimated fraction of projection synapses activated on a step.
+ * @return kernel that is expected to be faster.
+ */
+inline ProjectionKernel select_projection_kernel(double spike_density)
+{
+    return spike_density > dense_kernel_crossover ? ProjectionKernel::dense : ProjectionKernel::fan_out;
+}
+
+
+/**
+ * @brief Update spike density estimate of a projection.
+ * @details The estimate is an exponential moving average, so that a single burst doesn't switch the kernel.
+ * @param spike_density spike density estimate to update.
+ * @param activated_synapses number of synapses activated on the current step.
+ * @param projection_size number of projection synapses.
+ */
+inline void update_spike_density(double &spike_density, size_t activated_synapses, size_t projection_size)
+{
+    if (!projection_size) return;
+    const double step_density = static_cast<double>(activated_synapses) / static_cast<double>(projection_size);
+    spike_density += spike_density_smoothing * (step_density - spike_density);
+}
+
+
+/**
+ * @brief Functor that returns projection synapse parameters as they are.
+ */
+struct SameSynapseParameters
+{
+    /**
+     * @brief Call operator.
+     * @param synapse_params synapse parameters.
+     * @tparam SynapseParameters synapse parameters type.
+     * @return the same synapse parameters.
+     */
+    template <class SynapseParameters>
+    const SynapseParameters &operator()(const SynapseParameters &synapse_params) const
+    {
+        return synapse_params;
+    }
+};
+
+
+/**
+ * @brief Calculate impacts of a projection by finding synapses of spiked neurons in the projection index.
+ * @details Impacts are ordered by synapse index, as in the dense kernel, so that impacts applied in order, such as
+ * blocking ones, have the same effect whatever kernel is used. A synapse of a neuron that spiked several times makes
+ * one impact for each spike. Impacts are appended to messages by delay slots, so the queue is searched once for each
+ * delay.
+ * @param projection projection.
+ * @param messages spike messages received by the projection.
+ * @param future_messages queue of future impact messages.
+ * @param step_n current step.
+ * @param activated_synapses buffer of activated synapse indexes kept by the caller between steps, so that it isn't
+ * allocated on each step.
+ * @param sp_getter functor that gets delta synapse parameters from projection synapse parameters.
+ * @tparam ProjectionType projection type.
+ * @tparam SynapseParametersGetter type of the functor that gets delta synapse parameters.
+ * @return number of impacts added to the queue.
+ */
+template <typename ProjectionType, class SynapseParametersGetter = SameSynapseParameters>
+size_t calculate_delta_synapse_projection_data(
     ProjectionType &projection, std::vector<core::messaging::SpikeMessage> &messages, MessageQueue &future_messages,
-    size_t step_n,
-    std::function<knp::synapse_traits::synapse_parameters<knp::synapse_traits::DeltaSynapse>(
-        const typename ProjectionType::SynapseParameters &)>
-        sp_getter = [](const typename ProjectionType::SynapseParameters &synapse_params) { return synapse_params; })
+    size_t step_n, std::vector<size_t> &activated_synapses,
+    SynapseParametersGetter sp_getter = SynapseParametersGetter())
 {
     SPDLOG_TRACE("Calculating delta synapse projection data...");
     using SynapseType = typename ProjectionType::ProjectionSynapseType;
     WeightUpdateSTDP<SynapseType>::init_projection(projection, messages, step_n);
 
+    const auto uniform_params = get_uniform_parameters(projection);
+    DelaySlots delay_slots(projection, future_messages, step_n, is_forcing<ProjectionType>());
+
+    activated_synapses.clear();
     for (const auto &message : messages)
     {
-        const auto &message_data = message.neuron_indexes_;
-        for (const auto &spiked_neuron_index : message_data)
+        for (const auto &spiked_neuron_index : message.neuron_indexes_)
+        {
+            const auto synapses =
+                projection.find_synapses(spiked_neuron_index, ProjectionType::Search::by_presynaptic);
+            activated_synapses.insert(activated_synapses.end(), synapses.begin(), synapses.end());
+        }
+    }
+    std::sort(activated_synapses.begin(), activated_synapses.end());
+
+    with_synapse_parameters(
+        uniform_params,
+        [&](auto get_synapse_params)
         {
-            auto synapses = projection.find_synapses(spiked_neuron_index, ProjectionType::Search::by_presynaptic);
-            for (auto synapse_index : synapses)
+            for (auto synapse_index : activated_synapses)
             {
                 auto &synapse = projection[synapse_index];
                 WeightUpdateSTDP<SynapseType>::init_synapse(std::get<core::synapse_data>(synapse), step_n);
-                const auto &synapse_params = sp_getter(std::get<core::synapse_data>(synapse));
+                const auto synapse_params = get_synapse_params(sp_getter(std::get<core::synapse_data>(synapse)));
 
-                // The message is sent on step N - 1, received on step N.
-                size_t future_step = synapse_params.delay_ + step_n - 1;
                 knp::core::messaging::SynapticImpact impact{
                     synapse_index, synapse_params.weight_, synapse_params.output_type_,
                     static_cast<uint32_t>(std::get<core::source_neuron_id>(synapse)),
                     static_cast<uint32_t>(std::get<core::target_neuron_id>(synapse))};
+                delay_slots[synapse_params.delay_].push_back(impact);
+            }
+        });
+    WeightUpdateSTDP<SynapseType>::modify_weights(projection);
+    return activated_synapses.size();
+}
+
 
-                auto iter = future_messages.find(future_step);
-                if (iter != future_messages.end())
+/**
+ * @brief Calculate impacts of a projection by sweeping all its synapses.
+ * @details Spiked neurons are marked in a mask indexed by presynaptic neuron, and synapses are read in storage order,
+ * so that the sweep doesn't use the projection index. The mask contains spike counts, so that a neuron that spiked
+ * several times makes the same impacts as in the fan-out kernel. Impacts are ordered by synapse index.
+ * @param projection projection.
+ * @param messages spike messages received by the projection.
+ * @param future_messages queue of future impact messages.
+ * @param step_n current step.
+ * @param spike_mask mask buffer kept by the caller between steps. It contains only zeros before and after the call.
+ * @tparam ProjectionType projection type.
+ * @return number of impacts added to the queue.
+ */
+template <typename ProjectionType>
+size_t calculate_delta_synapse_projection_dense_data(
+    ProjectionType &projection, std::vector<core::messaging::SpikeMessage> &messages, MessageQueue &future_messages,
+    size_t step_n, std::vector<uint32_t> &spike_mask)
+{
+    SPDLOG_TRACE("Calculating delta synapse projection data by the dense kernel...");
+    using SynapseType = typename ProjectionType::ProjectionSynapseType;
+    WeightUpdateSTDP<SynapseType>::init_projection(projection, messages, step_n);
+
+    bool has_spikes = false;
+    for (const auto &message : messages)
+    {
+        for (const auto &spiked_neuron_index : message.neuron_indexes_)
+        {
+            if (spiked_neuron_index >= spike_mask.size()) spike_mask.resize(spiked_neuron_index + 1);
+            ++spike_mask[spiked_neuron_index];
+            has_spikes = true;
+        }
+    }
+
+    const auto uniform_params = get_uniform_parameters(projection);
+    DelaySlots delay_slots(projection, future_messages, step_n, is_forcing<ProjectionType>());
+    size_t impacts_count = 0;
+
+    with_synapse_parameters(
+        uniform_params,
+        [&](auto get_synapse_params)
+        {
+            for (size_t synapse_index = 0; synapse_index < projection.size() && has_spikes; ++synapse_index)
+            {
+                auto &synapse = projection[synapse_index];
+                const size_t source = std::get<core::source_neuron_id>(synapse);
+                if (source >= spike_mask.size() || !spike_mask[source]) continue;
+                impacts_count += spike_mask[source];
+
+                for (uint32_t spike = 0; spike < spike_mask[source]; ++spike)
                 {
-                    iter->second.impacts_.push_back(impact);
+                    WeightUpdateSTDP<SynapseType>::init_synapse(std::get<core::synapse_data>(synapse), step_n);
+                    const auto synapse_params = get_synapse_params(std::get<core::synapse_data>(synapse));
+
+                    knp::core::messaging::SynapticImpact impact{
+                        synapse_index, synapse_params.weight_, synapse_params.output_type_,
+                        static_cast<uint32_t>(source),
+                        static_cast<uint32_t>(std::get<core::target_neuron_id>(synapse))};
+                    delay_slots[synapse_params.delay_].push_back(impact);
                 }
-                else
+            }
+        });
+    // Only entries of spiked neurons are reset, the mask isn't cleared as a whole.
+    for (const auto &message : messages)
+    {
+        for (const auto &spiked_neuron_index : message.neuron_indexes_) spike_mask[spiked_neuron_index] = 0;
+    }
+    WeightUpdateSTDP<SynapseType>::modify_weights(projection);
+    return impacts_count;
+}
+
+
+/**
+ * @brief Calculate impacts of a compact projection.
+ * @details Synapses of a spiked neuron are a contiguous range of compact storage, sorted by delay. Impacts of each
+ * delay run are appended to the delay slot of the run, so the queue is searched once for each delay rather than
+ * for each synapse.
+ * @param projection compact projection.
+ * @param messages spike messages received by the projection.
+ * @param future_messages queue of future impact messages.
+ * @param step_n current step.
+ * @tparam SynapseType projection synapse type.
+ * @return iterator of the message to send on the current step, or `end()` if there is no such message.
+ */
+template <class SynapseType>
+MessageQueue::const_iterator calculate_compact_projection_data(
+    const knp::core::CompactProjection<SynapseType> &projection,
+    const std::vector<core::messaging::SpikeMessage> &messages, MessageQueue &future_messages, size_t step_n)
+{
+    SPDLOG_TRACE("Calculating compact projection data...");
+    DelaySlots delay_slots(projection, future_messages, step_n, is_forcing<knp::core::Projection<SynapseType>>());
+
+    auto append_impacts = [&projection](auto &impacts, size_t begin, size_t end)
+    {
+        for (size_t synapse_index = begin; synapse_index < end; ++synapse_index)
+        {
+            impacts.push_back(knp::core::messaging::SynapticImpact{
+                synapse_index, projection.get_weight(synapse_index), projection.get_output_type(synapse_index),
+                projection.get_source(synapse_index), projection.get_target(synapse_index)});
+        }
+    };
+
+    const auto uniform_delay = projection.get_uniform_delay();
+
+    for (const auto &message : messages)
+    {
+        for (const auto &spiked_neuron_index : message.neuron_indexes_)
+        {
+            // The message is created on the first impact, so that no empty message is sent.
+            if (uniform_delay)
+            {
+                const auto [begin, end] = projection.find_synapses(spiked_neuron_index);
+                if (begin != end) append_impacts(delay_slots[*uniform_delay], begin, end);
+                continue;
+            }
+
+            const auto [first_run, last_run] = projection.find_delay_runs(spiked_neuron_index);
+            for (size_t run_index = first_run; run_index < last_run; ++run_index)
+            {
+                const auto run = projection.get_delay_run(run_index);
+                append_impacts(delay_slots[run.delay_], run.begin_, run.end_);
+            }
+        }
+    }
+    return future_messages.find(step_n);
+}
+
+
+/**
+ * @brief Calculate impacts of a procedural projection.
+ * @details Synapses of each spiked neuron are generated by the projection rule and are not stored. Impact connection
+ * indexes are synapse numbers within the generated synapses of a neuron.
+ * @param projection procedural projection.
+ * @param messages spike messages received by the projection.
+ * @param future_messages queue of future impact messages.
+ * @param step_n current step.
+ * @tparam SynapseType projection synapse type.
+ * @return iterator of the message to send on the current step, or `end()` if there is no such message.
+ */
+template <class SynapseType>
+MessageQueue::const_iterator calculate_procedural_projection_data(
+    const knp::core::ProceduralProjection<SynapseType> &projection,
+    const std::vector<core::messaging::SpikeMessage> &messages, MessageQueue &future_messages, size_t step_n)
+{
+    SPDLOG_TRACE("Calculating procedural projection data...");
+    const auto uniform_params = get_uniform_parameters(projection);
+    DelaySlots delay_slots(projection, future_messages, step_n, is_forcing<knp::core::Projection<SynapseType>>());
+    std::vector<typename knp::core::ProceduralProjection<SynapseType>::Synapse> synapses;
+
+    with_synapse_parameters(
+        uniform_params,
+        [&](auto get_synapse_params)
+        {
+            for (const auto &message : messages)
+            {
+                for (const auto &spiked_neuron_index : message.neuron_indexes_)
                 {
-                    knp::core::messaging::SynapticImpactMessage message_out{
-                        {projection.get_uid(), step_n},
-                        projection.get_presynaptic(),
-                        projection.get_postsynaptic(),
-                        is_forcing<ProjectionType>(),
-                        {impact}};
-                    future_messages.insert(std::make_pair(future_step, message_out));
+                    projection.generate_synapses(spiked_neuron_index, synapses);
+
+                    for (size_t synapse_index = 0; synapse_index < synapses.size(); ++synapse_index)
+                    {
+                        const auto &synapse = synapses[synapse_index];
+                        const auto synapse_params = get_synapse_params(std::get<core::synapse_data>(synapse));
+                        knp::core::messaging::SynapticImpact impact{
+                            synapse_index, synapse_params.weight_, synapse_params.output_type_,
+                            static_cast<uint32_t>(std::get<core::source_neuron_id>(synapse)),
+                            static_cast<uint32_t>(std::get<core::target_neuron_id>(synapse))};
+                        delay_slots[synapse_params.delay_].push_back(impact);
+                    }
                 }
             }
+        });
+    return future_messages.find(step_n);
+}
+
+
+/**
+ * @brief Calculate impacts of a convolution projection.
+ * @details All synapses have the same delay, so impacts are appended to a single message. Impact connection indexes
+ * are indexes of kernel weights.
+ * @param projection convolution projection.
+ * @param messages spike messages received by the projection.
+ * @param future_messages queue of future impact messages.
+ * @param step_n current step.
+ * @tparam SynapseType projection synapse type.
+ * @return iterator of the message to send on the current step, or `end()` if there is no such message.
+ */
+template <class SynapseType>
+MessageQueue::const_iterator calculate_convolution_projection_data(
+    const knp::core::ConvolutionProjection<SynapseType> &projection,
+    const std::vector<core::messaging::SpikeMessage> &messages, MessageQueue &future_messages, size_t step_n)
+{
+    SPDLOG_TRACE("Calculating convolution projection data...");
+    const auto output_type = projection.get_output_type();
+    std::vector<knp::core::messaging::SynapticImpact> *impacts = nullptr;
+
+    for (const auto &message : messages)
+    {
+        for (const auto &spiked_neuron_index : message.neuron_indexes_)
+        {
+            projection.for_each_synapse(
+                spiked_neuron_index,
+                [&](size_t weight_index, size_t postsynaptic_index, float weight)
+                {
+                    // The message is sent on step N - 1, received on step N.
+                    if (!impacts)
+                    {
+                        impacts = &get_future_impacts(
+                            projection, future_messages, projection.get_delay() + step_n - 1, step_n,
+                            is_forcing<knp::core::Projection<SynapseType>>());
+                    }
+                    impacts->push_back(knp::core::messaging::SynapticImpact{
+                        weight_index, weight, output_type, static_cast<uint32_t>(spiked_neuron_index),
+                        static_cast<uint32_t>(postsynaptic_index)});
+                });
         }
     }
-    WeightUpdateSTDP<SynapseType>::modify_weights(projection);
     return future_messages.find(step_n);
 }
 
@@ -133,56 +600,105 @@ void calculate_projection_part_impl(
     knp::core::Projection<DeltaLikeSynapse> &projection,
     const std::unordered_map<knp::core::Step, size_t> &message_in_data, MessageQueue &future_messages, uint64_t step_n,
     size_t part_start, size_t part_size, std::mutex &mutex)
+{
+    FutureImpacts container;
+    calculate_projection_part_impacts_impl(projection, message_in_data, container, step_n, part_start, part_size);
+    add_future_impacts(projection, container, future_messages, step_n, mutex);
+}
+
+
+template <class DeltaLikeSynapse>
+void calculate_projection_part_impacts_impl(
+    knp::core::Projection<DeltaLikeSynapse> &projection,
+    const std::unordered_map<knp::core::Step, size_t> &message_in_data, FutureImpacts &container, uint64_t step_n,
+    size_t part_start, size_t part_size)
 {
     size_t part_end = std::min(part_start + part_size, projection.size());
-    std::vector<std::pair<uint64_t, knp::core::messaging::SynapticImpact>> container;
-    for (size_t synapse_index = part_start; synapse_index < part_end; ++synapse_index)
-    {
-        auto &synapse = projection[synapse_index];
-        // update_step(synapse.params_, step_n);
-        // TODO: Move update logic here too.
-        auto iter = message_in_data.find(std::get<core::source_neuron_id>(synapse));
-        if (iter == message_in_data.end())
+    const auto uniform_params = get_uniform_parameters(projection);
+    with_synapse_parameters(
+        uniform_params,
+        [&](auto get_synapse_params)
         {
-            continue;
-        }
+            for (size_t synapse_index = part_start; synapse_index < part_end; ++synapse_index)
+            {
+                auto &synapse = projection[synapse_index];
+                // update_step(synapse.params_, step_n);
+                // TODO: Move update logic here too.
+                auto iter = message_in_data.find(std::get<core::source_neuron_id>(synapse));
+                if (iter == message_in_data.end())
+                {
+                    continue;
+                }
 
-        // Add new impact.
-        // The message is sent on step N - 1, received on step N.
-        uint64_t key = std::get<core::synapse_data>(synapse).delay_ + step_n - 1;
+                // Add new impact.
+                const auto synapse_params = get_synapse_params(std::get<core::synapse_data>(synapse));
+                // The message is sent on step N - 1, received on step N.
+                uint64_t key = synapse_params.delay_ + step_n - 1;
+
+                knp::core::messaging::SynapticImpact impact{
+                    synapse_index, synapse_params.weight_ * iter->second, synapse_params.output_type_,
+                    static_cast<uint32_t>(std::get<core::source_neuron_id>(synapse)),
+                    static_cast<uint32_t>(std::get<core::target_neuron_id>(synapse))};
 
-        knp::core::messaging::SynapticImpact impact{
-            synapse_index, std::get<core::synapse_data>(synapse).weight_ * iter->second,
-            std::get<core::synapse_data>(synapse).output_type_,
-            static_cast<uint32_t>(std::get<core::source_neuron_id>(synapse)),
-            static_cast<uint32_t>(std::get<core::target_neuron_id>(synapse))};
+                container.emplace_back(key, impact);
+            }
+        });
+}
 
-        container.emplace_back(key, impact);
-    }
+
+template <class DeltaLikeSynapse>
+void add_future_impacts(
+    const knp::core::Projection<DeltaLikeSynapse> &projection, const FutureImpacts &container,
+    MessageQueue &future_messages, uint64_t step_n, std::mutex &mutex)
+{
     // Add impacts to future messages queue, it is a shared resource.
     const std::lock_guard lock_guard(mutex);
-    const auto &projection_uid = projection.get_uid();
-    const auto &presynaptic_uid = projection.get_presynaptic();
-    const auto &postsynaptic_uid = projection.get_postsynaptic();
+    DelaySlots delay_slots(projection, future_messages, step_n, is_forcing<core::Projection<DeltaLikeSynapse>>());
+
+    // The message is sent on step N - 1, received on step N.
+    for (const auto &[future_step, impact] : container) delay_slots[future_step + 1 - step_n].push_back(impact);
+}
+
 
-    for (auto value : container)
+template <class DeltaLikeSynapse>
+size_t calculate_projection_fan_out_impl(
+    knp::core::Projection<DeltaLikeSynapse> &projection,
+    const std::unordered_map<knp::core::Step, size_t> &message_in_data, MessageQueue &future_messages, uint64_t step_n,
+    std::vector<std::pair<size_t, size_t>> &activated_synapses, std::mutex &mutex)
+{
+    // Synapses with spike counts are sorted, so that impacts are ordered by synapse index as in the part kernel.
+    activated_synapses.clear();
+    for (const auto &[spiked_neuron_index, spikes_count] : message_in_data)
     {
-        auto iter = future_messages.find(value.first);
-        if (iter != future_messages.end())
-        {
-            iter->second.impacts_.push_back(value.second);
-        }
-        else
+        for (auto synapse_index : projection.find_synapses(
+                 spiked_neuron_index, core::Projection<DeltaLikeSynapse>::Search::by_presynaptic))
         {
-            knp::core::messaging::SynapticImpactMessage message_out{
-                {projection_uid, step_n},
-                postsynaptic_uid,
-                presynaptic_uid,
-                is_forcing<core::Projection<DeltaLikeSynapse>>(),
-                {value.second}};
-            future_messages.insert(std::make_pair(value.first, message_out));
+            activated_synapses.emplace_back(synapse_index, spikes_count);
         }
     }
+    std::sort(activated_synapses.begin(), activated_synapses.end());
+
+    const auto uniform_params = get_uniform_parameters(projection);
+    FutureImpacts container;
+    with_synapse_parameters(
+        uniform_params,
+        [&](auto get_synapse_params)
+        {
+            for (const auto &[synapse_index, spikes_count] : activated_synapses)
+            {
+                const auto &synapse = projection[synapse_index];
+                const auto synapse_params = get_synapse_params(std::get<core::synapse_data>(synapse));
+                // The message is sent on step N - 1, received on step N.
+                container.emplace_back(
+                    synapse_params.delay_ + step_n - 1,
+                    knp::core::messaging::SynapticImpact{
+                        synapse_index, synapse_params.weight_ * spikes_count, synapse_params.output_type_,
+                        static_cast<uint32_t>(std::get<core::source_neuron_id>(synapse)),
+                        static_cast<uint32_t>(std::get<core::target_neuron_id>(synapse))});
+            }
+        });
+    add_future_impacts(projection, container, future_messages, step_n, mutex);
+    return container.size();
 }
 
 
@@ -210,22 +726,47 @@ inline std::unordered_map<uint64_t, size_t> convert_spikes(const core::messaging
 }
 
 
+/**
+ * @brief Send the impact message of the current step and remove it from the queue.
+ * @param endpoint message endpoint used for message exchange.
+ * @param future_messages queue of future impact messages.
+ * @param out_iter iterator of the message to send, or `end()` if there is no such message.
+ * @param aggregate_impacts `true` to send impacts as an aggregated impact message.
+ * @return number of sent synaptic impacts.
+ */
+inline size_t send_current_impacts(
+    knp::core::MessageEndpoint &endpoint, MessageQueue &future_messages, MessageQueue::const_iterator out_iter,
+    bool aggregate_impacts)
+{
+    if (out_iter == future_messages.end()) return 0;
+
+    SPDLOG_TRACE("Projection is sending an impact message.");
+    const size_t impacts_count = out_iter->second.impacts_.size();
+    if (aggregate_impacts)
+        endpoint.send_message(core::messaging::aggregate_impacts(out_iter->second));
+    else
+        endpoint.send_message(out_iter->second);
+    future_messages.erase(out_iter);
+    return impacts_count;
+}
+
+
 template <class DeltaLikeSynapseType>
-void calculate_delta_synapse_projection_impl(
+size_t calculate_delta_synapse_projection_impl(
     knp::core::Projection<DeltaLikeSynapseType> &projection, knp::core::MessageEndpoint &endpoint,
-    MessageQueue &future_messages, size_t step_n)
+    MessageQueue &future_messages, size_t step_n, ProjectionKernel kernel, double &spike_density,
+    std::vector<uint32_t> &spike_mask, std::vector<size_t> &activated_synapses, bool aggregate_impacts)
 {
     SPDLOG_DEBUG("Calculating delta synapse projection...");
 
     auto messages = endpoint.unload_messages<core::messaging::SpikeMessage>(projection.get_uid());
-    auto out_iter = calculate_delta_synapse_projection_data(projection, messages, future_messages, step_n);
-    if (out_iter != future_messages.end())
-    {
-        SPDLOG_TRACE("Projection is sending an impact message.");
-        // Send a message and remove it from the queue.
-        endpoint.send_message(out_iter->second);
-        future_messages.erase(out_iter);
-    }
+    const size_t impacts_count =
+        kernel == ProjectionKernel::dense
+            ? calculate_delta_synapse_projection_dense_data(projection, messages, future_messages, step_n, spike_mask)
+            : calculate_delta_synapse_projection_data(
+                  projection, messages, future_messages, step_n, activated_synapses);
+    update_spike_density(spike_density, impacts_count, projection.size());
+    return send_current_impacts(endpoint, future_messages, future_messages.find(step_n), aggregate_impacts);
 }
 
 }  // namespace knp::backends::cpu
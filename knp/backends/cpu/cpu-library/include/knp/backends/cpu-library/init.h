@@ -24,11 +24,14 @@
 #include <knp/core/message_endpoint.h>
 #include <knp/core/messaging/messaging.h>
 #include <knp/core/projection.h>
+#include <knp/neuron-traits/all_traits.h>
 
 #include <spdlog/spdlog.h>
 
 #include <string>
 #include <tuple>
+#include <type_traits>
+#include <unordered_set>
 #include <variant>
 
 
@@ -47,8 +50,10 @@ struct subscribe_stdp_projection
 {
     /**
      * @brief Subscribe STDP projection to messages.
+     * @tparam ProjectionType projection type, projections of non-STDP synapses can store synapses in any way.
      */
-    static void subscribe(const typename core::Projection<SynapseType> &, knp::core::MessageEndpoint &) {}
+    template <class ProjectionType>
+    static void subscribe(const ProjectionType &, knp::core::MessageEndpoint &) {}
 };
 
 
@@ -100,7 +105,63 @@ void init(const ProjectionContainer &projections, knp::core::MessageEndpoint &me
             p.arg_);
 
         if (pre_uid) message_endpoint.subscribe<knp::core::messaging::SpikeMessage>(this_uid, {pre_uid});
-        if (post_uid) message_endpoint.subscribe<knp::core::messaging::SynapticImpactMessage>(post_uid, {this_uid});
+        if (!post_uid) continue;
+        message_endpoint.subscribe<knp::core::messaging::SynapticImpactMessage>(post_uid, {this_uid});
+    }
+}
+
+
+/**
+ * @brief Determine if populations of a neuron type process aggregated impact messages.
+ * @tparam NeuronType neuron type.
+ * @return `true` if the neuron type is calculated as BLIFAT neuron.
+ */
+template <class NeuronType>
+constexpr bool is_impact_aggregation_supported()
+{
+    return std::is_same_v<NeuronType, neuron_traits::BLIFATNeuron> ||
+           std::is_same_v<NeuronType, neuron_traits::SynapticResourceSTDPBLIFATNeuron>;
+}
+
+
+/**
+ * @brief Select projections that can send aggregated impact messages and subscribe their postsynaptic populations
+ * to these messages.
+ * @details CPU neuron models don't use synapse indexes of impacts, so a projection can aggregate impacts if its
+ * postsynaptic population is calculated by the same backend and its neurons process aggregated impact messages.
+ * Impacts sent to other receivers are not aggregated. Projections send aggregated impact messages only if impact
+ * aggregation is enabled in the backend.
+ * @param projections container of backend projections.
+ * @param populations container of backend populations.
+ * @param message_endpoint message endpoint.
+ * @tparam ProjectionContainer type of projection container.
+ * @tparam PopulationContainer type of population container.
+ */
+template <typename ProjectionContainer, typename PopulationContainer>
+void init_impact_aggregation(
+    ProjectionContainer &projections, const PopulationContainer &populations,
+    knp::core::MessageEndpoint &message_endpoint)
+{
+    std::unordered_set<core::UID, core::uid_hash> population_uids;
+    for (const auto &population : populations)
+    {
+        std::visit(
+            [&population_uids](const auto &pop)
+            {
+                using T = std::decay_t<decltype(pop)>;
+                if constexpr (is_impact_aggregation_supported<typename T::PopulationNeuronType>())
+                    population_uids.insert(pop.get_uid());
+            },
+            population);
+    }
+
+    for (auto &projection : projections)
+    {
+        const auto [post_uid, this_uid] = std::visit(
+            [](const auto &proj) { return std::make_tuple(proj.get_postsynaptic(), proj.get_uid()); }, projection.arg_);
+        projection.aggregate_impacts_ = population_uids.count(post_uid) > 0;
+        if (projection.aggregate_impacts_)
+            message_endpoint.subscribe<knp::core::messaging::AggregatedImpactMessage>(post_uid, {this_uid});
     }
 }
 
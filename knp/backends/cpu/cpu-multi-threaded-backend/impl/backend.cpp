@@ -26,6 +26,7 @@
 #include <knp/backends/thread_pool/thread_pool.h>
 #include <knp/devices/cpu.h>
 #include <knp/meta/assert_helpers.h>
+#include <knp/meta/specialization_helpers.h>
 #include <knp/meta/stringify.h>
 #include <knp/meta/variant_helpers.h>
 
@@ -40,6 +41,42 @@
 
 namespace knp::backends::multi_threaded_cpu
 {
+
+namespace
+{
+
+// Calculate impacts of an inference projection.
+template <class SynapseType>
+void calculate_inference_projection(
+    const core::CompactProjection<SynapseType> &projection, const std::vector<core::messaging::SpikeMessage> &messages,
+    cpu::MessageQueue &future_messages, uint64_t step)
+{
+    cpu::calculate_compact_projection_data(projection, messages, future_messages, step);
+}
+
+
+// Calculate impacts of an inference projection.
+template <class SynapseType>
+void calculate_inference_projection(
+    const core::ProceduralProjection<SynapseType> &projection,
+    const std::vector<core::messaging::SpikeMessage> &messages, cpu::MessageQueue &future_messages, uint64_t step)
+{
+    cpu::calculate_procedural_projection_data(projection, messages, future_messages, step);
+}
+
+
+// Calculate impacts of an inference projection.
+template <class SynapseType>
+void calculate_inference_projection(
+    const core::ConvolutionProjection<SynapseType> &projection,
+    const std::vector<core::messaging::SpikeMessage> &messages, cpu::MessageQueue &future_messages, uint64_t step)
+{
+    cpu::calculate_convolution_projection_data(projection, messages, future_messages, step);
+}
+
+}  // namespace
+
+
 MultiThreadedCPUBackend::MultiThreadedCPUBackend(
     size_t thread_count, size_t population_part_size, size_t projection_part_size)
     : population_part_size_(population_part_size),
@@ -47,6 +84,7 @@ MultiThreadedCPUBackend::MultiThreadedCPUBackend(
       calc_pool_(std::make_unique<cpu_executors::ThreadPool>(
           thread_count ? thread_count : std::thread::hardware_concurrency()))
 {
+    calc_pool_->set_tracer(&get_tracer());
     SPDLOG_INFO(
         "Multi-threaded CPU backend instance created, thread count = {}.",
         thread_count ? thread_count : std::thread::hardware_concurrency());
@@ -79,10 +117,12 @@ void MultiThreadedCPUBackend::calculate_populations_pre_impact()
     for (auto &population : populations_)
     {
         auto pop_size = std::visit([](auto &pop) { return pop.size(); }, population);
+        auto *entity_counter =
+            get_profiler().get_entity_counter(std::visit([](auto &pop) { return pop.get_uid(); }, population));
         for (size_t neuron_index = 0; neuron_index < pop_size; neuron_index += population_part_size_)
         {
             std::visit(
-                [this, neuron_index](auto &pop)
+                [this, neuron_index, entity_counter](auto &pop)
                 {
                     // Check if population is supported by backend. We don't need to repeat it.
                     using T = std::decay_t<decltype(pop)>;
@@ -95,7 +135,8 @@ void MultiThreadedCPUBackend::calculate_populations_pre_impact()
                     }
 
                     // Start threads.
-                    calc_pool_->post(
+                    post_task(
+                        entity_counter,
                         knp::backends::cpu::calculate_neurons_state_part<typename T::PopulationNeuronType>,
                         std::ref(pop), neuron_index, population_part_size_);
                 },
@@ -113,13 +154,21 @@ void MultiThreadedCPUBackend::calculate_populations_impact()
     {
         auto uid = std::visit([](auto &population) { return population.get_uid(); }, population);
         auto messages = get_message_endpoint().unload_messages<knp::core::messaging::SynapticImpactMessage>(uid);
+        auto aggregated_messages =
+            get_message_endpoint().unload_messages<knp::core::messaging::AggregatedImpactMessage>(uid);
+        auto *entity_counter = get_profiler().get_entity_counter(uid);
         std::visit(
-            [this, &messages](auto &pop)
+            [this, &messages, &aggregated_messages, entity_counter](auto &pop)
             {
                 using T = std::decay_t<decltype(pop)>;
-                calc_pool_->post(
-                    knp::backends::cpu::process_inputs<typename T::PopulationNeuronType>, std::ref(pop),
-                    std::move(messages));
+                // Tasks run concurrently, so both message types of a population are processed by one task.
+                post_task(
+                    entity_counter,
+                    [&pop, messages = std::move(messages), aggregated_messages = std::move(aggregated_messages)]()
+                    {
+                        knp::backends::cpu::process_inputs<typename T::PopulationNeuronType>(
+                            pop, messages, aggregated_messages);
+                    });
             },
             population);
     }
@@ -138,17 +187,19 @@ std::vector<knp::core::messaging::SpikeMessage> MultiThreadedCPUBackend::calcula
         message.header_.sender_uid_ = std::visit([](auto &population) { return population.get_uid(); }, population);
 
         const size_t population_size = std::visit([](auto &population) { return population.size(); }, population);
+        auto *entity_counter = get_profiler().get_entity_counter(message.header_.sender_uid_);
         for (size_t neuron_index = 0; neuron_index < population_size; neuron_index += population_part_size_)
         {
             std::visit(
-                [this, &message, neuron_index](auto &pop)
+                [this, &message, neuron_index, entity_counter](auto &pop)
                 {
                     using T = std::decay_t<decltype(pop)>;
 #if defined(_MSC_VER)
 #    pragma warning(push)
 #    pragma warning(disable : 4267)
 #endif
-                    calc_pool_->post(
+                    post_task(
+                        entity_counter,
                         knp::backends::cpu::calculate_neurons_post_input_state_part<typename T::PopulationNeuronType>,
                         std::ref(pop), std::ref(message), neuron_index, population_part_size_, std::ref(ep_mutex_));
                 },
@@ -166,11 +217,20 @@ std::vector<knp::core::messaging::SpikeMessage> MultiThreadedCPUBackend::calcula
 void MultiThreadedCPUBackend::calculate_populations()
 {
     SPDLOG_DEBUG("Calculating populations...");
-    calculate_populations_pre_impact();
-
-    calculate_populations_impact();
-
-    auto spike_messages = calculate_populations_post_impact();
+    auto &tracer = get_tracer();
+    {
+        core::Tracer::Scope trace_scope(&tracer, "populations_pre_impact", "backend");
+        calculate_populations_pre_impact();
+    }
+    {
+        core::Tracer::Scope trace_scope(&tracer, "populations_impact", "backend");
+        calculate_populations_impact();
+    }
+    std::vector<knp::core::messaging::SpikeMessage> spike_messages;
+    {
+        core::Tracer::Scope trace_scope(&tracer, "populations_post_impact", "backend");
+        spike_messages = calculate_populations_post_impact();
+    }
 
     // Sending non-empty messages.
     for (const auto &message : spike_messages)
@@ -179,6 +239,7 @@ void MultiThreadedCPUBackend::calculate_populations()
         {
             continue;
         }
+        collect_statistics(message);
         get_message_endpoint().send_message(message);
     }
 }
@@ -212,32 +273,109 @@ void MultiThreadedCPUBackend::calculate_projections()
             continue;
         }
 
-        // Looping over synapses.
+        auto *entity_counter = get_profiler().get_entity_counter(uid);
+        // Inference projections don't use the index of spiked neurons, a single task calculates a projection.
+        const bool is_inference_projection = std::visit(
+            [this, &msg_buf, &projection, entity_counter](const auto &proj)
+            {
+                using T = std::decay_t<decltype(proj)>;
+                if constexpr (knp::meta::is_specialization<T, core::Projection>::value)
+                {
+                    return false;
+                }
+                else
+                {
+                    post_task(
+                        entity_counter,
+                        [&proj, &projection, messages = std::move(msg_buf), step = get_step()]()
+                        { calculate_inference_projection(proj, messages, projection.messages_, step); });
+                    return true;
+                }
+            },
+            projection.arg_);
+        if (is_inference_projection) continue;
+
         converted_message_buffer.emplace_back(cpu::convert_spikes(msg_buf[0]));
-        const auto proj_size = std::visit([](const auto &proj) { return proj.size(); }, projection.arg_);
-        for (size_t synapse_index = 0; synapse_index < proj_size; synapse_index += projection_part_size_)
+        if (cpu::select_projection_kernel(projection.spike_density_) == cpu::ProjectionKernel::fan_out)
         {
+            // Few synapses are activated, a single task finds them by the projection index.
+            get_profiler().add_fan_out_projections(1);
             std::visit(
-                [this, synapse_index, &converted_message_buffer, &projection](auto &proj)
+                [this, &converted_message_buffer, &projection, entity_counter](auto &proj)
                 {
                     using T = std::decay_t<decltype(proj)>;
-                    calc_pool_->post(
-                        knp::backends::cpu::calculate_projection_part<typename T::ProjectionSynapseType>,
-                        std::ref(proj), std::ref(converted_message_buffer.back()), std::ref(projection.messages_),
-                        get_step(), synapse_index, projection_part_size_, std::ref(ep_mutex_));
+                    if constexpr (knp::meta::is_specialization<T, core::Projection>::value)
+                    {
+                        post_task(
+                            entity_counter,
+                            [this, &proj, &projection, &message_in_data = converted_message_buffer.back(),
+                             step = get_step()]()
+                            {
+                                projection.fan_out_impacts_ = knp::backends::cpu::calculate_projection_fan_out(
+                                    proj, message_in_data, projection.messages_, step, projection.activated_synapses_,
+                                    ep_mutex_);
+                            });
+                    }
                 },
                 projection.arg_);
+            continue;
         }
+
+        // Looping over synapses. Each part has its own impact container, so that impact order doesn't depend on
+        // the order in which parts are finished.
+        get_profiler().add_dense_projections(1);
+        std::visit(
+            [this, &converted_message_buffer, &projection, entity_counter](auto &proj)
+            {
+                using T = std::decay_t<decltype(proj)>;
+                if constexpr (knp::meta::is_specialization<T, core::Projection>::value)
+                {
+                    projection.part_impacts_.resize((proj.size() + projection_part_size_ - 1) / projection_part_size_);
+                    for (size_t part_index = 0; part_index < projection.part_impacts_.size(); ++part_index)
+                    {
+                        post_task(
+                            entity_counter,
+                            knp::backends::cpu::calculate_projection_part_impacts<typename T::ProjectionSynapseType>,
+                            std::ref(proj), std::ref(converted_message_buffer.back()),
+                            std::ref(projection.part_impacts_[part_index]), get_step(),
+                            part_index * projection_part_size_, projection_part_size_);
+                    }
+                }
+            },
+            projection.arg_);
     }
     calc_pool_->join();
     // Sending messages. It might be possible to parallelize this as well if we use more than one endpoint.
     for (auto &projection : projections_)
     {
         auto &msg_queue = projection.messages_;
+        std::visit(
+            [this, &projection](const auto &proj)
+            {
+                using T = std::decay_t<decltype(proj)>;
+                // Inference projections add impacts to the queue directly and don't select a kernel.
+                if constexpr (knp::meta::is_specialization<T, core::Projection>::value)
+                {
+                    size_t impacts_count = projection.fan_out_impacts_;
+                    for (auto &impacts : projection.part_impacts_)
+                    {
+                        impacts_count += impacts.size();
+                        cpu::add_future_impacts(proj, impacts, projection.messages_, get_step(), ep_mutex_);
+                        impacts.clear();
+                    }
+                    projection.fan_out_impacts_ = 0;
+                    cpu::update_spike_density(projection.spike_density_, impacts_count, proj.size());
+                }
+            },
+            projection.arg_);
         auto msg_iter = msg_queue.find(get_step());
         if (msg_iter != msg_queue.end())
         {
-            get_message_endpoint().send_message(std::move(msg_iter->second));
+            get_profiler().add_impacts(msg_iter->second.impacts_.size());
+            if (impact_aggregation_ && projection.aggregate_impacts_)
+                get_message_endpoint().send_message(core::messaging::aggregate_impacts(msg_iter->second));
+            else
+                get_message_endpoint().send_message(std::move(msg_iter->second));
             msg_queue.erase(msg_iter);
         }
     }
@@ -259,12 +397,22 @@ std::vector<size_t> MultiThreadedCPUBackend::get_supported_population_indexes()
 void MultiThreadedCPUBackend::_step()
 {
     SPDLOG_DEBUG("Starting step #{}...", get_step());
-    calculate_populations();
-    get_message_bus().route_messages();
-    get_message_endpoint().receive_all_messages();
-    calculate_projections();
-    get_message_bus().route_messages();
-    get_message_endpoint().receive_all_messages();
+    auto &profiler = get_profiler();
+    auto &tracer = get_tracer();
+    core::StepProfiler::ScopedTimer step_timer(profiler.get_step_counter());
+    core::Tracer::Scope step_trace_scope(&tracer, "step", "backend");
+    {
+        core::StepProfiler::ScopedTimer phase_timer(profiler.get_phase_counter(core::StepPhase::populations));
+        core::Tracer::Scope trace_scope(&tracer, "populations", "backend");
+        calculate_populations();
+    }
+    route_messages();
+    {
+        core::StepProfiler::ScopedTimer phase_timer(profiler.get_phase_counter(core::StepPhase::projections));
+        core::Tracer::Scope trace_scope(&tracer, "projections", "backend");
+        calculate_projections();
+    }
+    route_messages();
     auto step = gad_step();
     // Need to suppress "Unused variable" warning.
     (void)step;
@@ -296,15 +444,32 @@ void MultiThreadedCPUBackend::load_projections(const std::vector<ProjectionVaria
     {
         projections_.push_back(ProjectionWrapper{projection});
     }
+    load_deferred_synapses();
 
     SPDLOG_DEBUG("All projections loaded.");
 }
 
 
+void MultiThreadedCPUBackend::load_deferred_synapses()
+{
+    for (auto &wrapper : projections_)
+    {
+        std::visit(
+            [](auto &projection)
+            {
+                using T = std::decay_t<decltype(projection)>;
+                if constexpr (knp::meta::is_specialization<T, core::Projection>::value) projection.load_synapses();
+            },
+            wrapper.arg_);
+    }
+}
+
+
 void MultiThreadedCPUBackend::load_all_projections(const std::vector<knp::core::AllProjectionsVariant> &projections)
 {
     SPDLOG_DEBUG("Loading projections [{}]...", projections.size());
     knp::meta::load_from_container<SupportedProjections>(projections, projections_);
+    load_deferred_synapses();
     SPDLOG_DEBUG("All projections loaded.");
 }
 
@@ -335,11 +500,33 @@ std::vector<std::unique_ptr<knp::core::Device>> MultiThreadedCPUBackend::get_dev
 }
 
 
+core::MemoryUsage MultiThreadedCPUBackend::memory_usage() const
+{
+    auto result = Backend::memory_usage();
+    for (const auto &population : populations_)
+    {
+        result += std::visit([](const auto &entity) { return entity.memory_usage(); }, population);
+    }
+    for (const auto &projection : projections_)
+    {
+        result += std::visit([](const auto &entity) { return entity.memory_usage(); }, projection.arg_);
+        result.messages_ += core::hash_container_bytes(projection.messages_);
+        // Message structures are accounted in container nodes, so only message data are added.
+        for (const auto &[step, message] : projection.messages_)
+        {
+            result.messages_ += core::messaging::message_bytes(message) - sizeof(message);
+        }
+    }
+    return result;
+}
+
+
 void MultiThreadedCPUBackend::_init()
 {
     SPDLOG_DEBUG("Initializing multi-threaded CPU backend...");
 
     knp::backends::cpu::init(projections_, get_message_endpoint());
+    knp::backends::cpu::init_impact_aggregation(projections_, populations_, get_message_endpoint());
 
     SPDLOG_DEBUG("Initialization finished.");
 }
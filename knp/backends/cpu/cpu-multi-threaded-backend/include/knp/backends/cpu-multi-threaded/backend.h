@@ -22,14 +22,16 @@
 #pragma once
 
 #include <knp/backends/thread_pool/thread_pool.h>
+#include <knp/core/all_projections.h>
 #include <knp/core/backend.h>
 #include <knp/core/impexp.h>
 #include <knp/core/population.h>
-#include <knp/core/projection.h>
 #include <knp/devices/cpu.h>
+#include <knp/meta/specialization_helpers.h>
 #include <knp/neuron-traits/all_traits.h>
 #include <knp/synapse-traits/all_traits.h>
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -92,8 +94,10 @@ public:
 
     /**
      * @brief List of supported projection types based on synapse types specified in `SupportedSynapses`.
+     * @details Projection types of `knp::core::InferenceProjections` are also supported.
      */
-    using SupportedProjections = boost::mp11::mp_transform<knp::core::Projection, SupportedSynapses>;
+    using SupportedProjections = boost::mp11::mp_append<
+        boost::mp11::mp_transform<knp::core::Projection, SupportedSynapses>, knp::core::InferenceProjections>;
     /**
      * @brief Population variant that contains any population type specified in `SupportedPopulations`.
      * @details `PopulationVariants` takes the value of `std::variant<PopulationType_1,..., PopulationType_n>`, where
@@ -121,6 +125,16 @@ private:
         ProjectionVariants arg_;
         // cppcheck-suppress unusedStructMember
         std::unordered_map<uint64_t, knp::core::messaging::SynapticImpactMessage> messages_;
+        // Estimated fraction of synapses activated on a step, selects the projection kernel.
+        double spike_density_ = 0;
+        // Impacts of projection parts calculated in parallel, they are added to messages in part order.
+        std::vector<std::vector<std::pair<uint64_t, knp::core::messaging::SynapticImpact>>> part_impacts_;
+        // Number of impacts added by the fan-out kernel on the current step.
+        size_t fan_out_impacts_ = 0;
+        // Synapses activated on a step with their spike counts used by the fan-out kernel, kept between steps.
+        std::vector<std::pair<size_t, size_t>> activated_synapses_;
+        // Postsynaptic population is calculated by the backend, so impacts can be sent as aggregated impact messages.
+        bool aggregate_impacts_ = false;
     };
 
 public:
@@ -149,6 +163,14 @@ public:
      */
     [[nodiscard]] DataRanges get_network_data() const override;
 
+    /**
+     * @brief Get memory used by the backend.
+     * @details Memory of populations, projections, the message endpoint and queues of future projection messages
+     * is accounted.
+     * @return memory usage.
+     */
+    [[nodiscard]] core::MemoryUsage memory_usage() const override;
+
 
     /**
      * @brief Types of constant population iterators.
@@ -293,6 +315,30 @@ public:
      */
     void remove_populations(const std::vector<knp::core::UID> &uids) override {}
 
+public:
+    /**
+     * @brief Start sending aggregated impact messages.
+     * @details A projection whose postsynaptic population is calculated by the backend sends impacts summed by
+     * postsynaptic neuron and output type as an aggregated impact message. Projections to populations of neurons
+     * that don't process aggregated impact messages still send synaptic impact messages. Aggregation is disabled by
+     * default.
+     * @warning Aggregating projections don't send synaptic impact messages, so other subscribers to synaptic impact
+     * messages of these projections, such as observers, don't receive impacts.
+     */
+    void enable_impact_aggregation() { impact_aggregation_ = true; }
+
+    /**
+     * @brief Stop sending aggregated impact messages.
+     * @details Projections send synaptic impact messages.
+     */
+    void disable_impact_aggregation() { impact_aggregation_ = false; }
+
+    /**
+     * @brief Determine if projections send aggregated impact messages.
+     * @return `true` if impact aggregation is enabled.
+     */
+    [[nodiscard]] bool is_impact_aggregation_enabled() const { return impact_aggregation_; }
+
 public:
     /**
      * @brief Get a list of devices supported by the backend.
@@ -323,7 +369,17 @@ public:
     void stop_learning() override
     {
         for (ProjectionWrapper &wrapper : projections_)
-            std::visit([](auto &entity) { entity.lock_weights(); }, wrapper.arg_);
+        {
+            std::visit(
+                [](auto &entity)
+                {
+                    // Inference projections have no trainable synapses.
+                    using T = std::decay_t<decltype(entity)>;
+                    if constexpr (knp::meta::is_specialization<T, knp::core::Projection>::value)
+                        entity.lock_weights();
+                },
+                wrapper.arg_);
+        }
     }
 
     /**
@@ -336,7 +392,17 @@ public:
          * `lock()`.
          */
         for (ProjectionWrapper &wrapper : projections_)
-            std::visit([](auto &entity) { entity.unlock_weights(); }, wrapper.arg_);
+        {
+            std::visit(
+                [](auto &entity)
+                {
+                    // Inference projections have no trainable synapses.
+                    using T = std::decay_t<decltype(entity)>;
+                    if constexpr (knp::meta::is_specialization<T, knp::core::Projection>::value)
+                        entity.unlock_weights();
+                },
+                wrapper.arg_);
+        }
     }
 
 protected:
@@ -352,6 +418,26 @@ private:
     void calculate_populations_impact();
     // Calculating post input changes and outputs.
     std::vector<knp::core::messaging::SpikeMessage> calculate_populations_post_impact();
+    // Load synapses of projections with deferred loading into the backend copies.
+    void load_deferred_synapses();
+    // Post a task to the pool, task time is accounted in the entity counter if it is not null. Rvalue arguments are
+    // moved into the task.
+    template <class Func, typename... Args>
+    void post_task(core::StepProfiler::Counter *entity_counter, Func &&func, Args &&...args)
+    {
+        auto task = std::bind(std::forward<Func>(func), std::forward<Args>(args)...);
+        if (!entity_counter)
+        {
+            calc_pool_->post(std::move(task));
+            return;
+        }
+        calc_pool_->post(
+            [entity_counter, task = std::move(task)]() mutable
+            {
+                core::StepProfiler::ScopedTimer timer(entity_counter);
+                task();
+            });
+    }
     // cppcheck-suppress unusedStructMember
     PopulationContainer populations_;
     ProjectionContainer projections_;
@@ -361,6 +447,7 @@ private:
     const size_t projection_part_size_;
     std::unique_ptr<cpu_executors::ThreadPool> calc_pool_;
     std::mutex ep_mutex_;
+    bool impact_aggregation_ = false;
 };
 
 }  // namespace knp::backends::multi_threaded_cpu
@@ -26,6 +26,7 @@
 #include <knp/backends/cpu-single-threaded/backend.h>
 #include <knp/devices/cpu.h>
 #include <knp/meta/assert_helpers.h>
+#include <knp/meta/specialization_helpers.h>
 #include <knp/meta/stringify.h>
 #include <knp/meta/variant_helpers.h>
 #include <knp/synapse-traits/stdp_synaptic_resource_rule.h>
@@ -39,6 +40,28 @@
 namespace knp::backends::single_threaded_cpu
 {
 
+namespace
+{
+
+template <class ProjectionType>
+size_t calculate_delta_projection(
+    ProjectionType &projection, core::MessageEndpoint &endpoint, cpu::MessageQueue &message_queue, size_t step,
+    double &spike_density, std::vector<uint32_t> &spike_mask, std::vector<size_t> &activated_synapses,
+    bool aggregate_impacts, core::StepProfiler &profiler)
+{
+    const auto kernel = cpu::select_projection_kernel(spike_density);
+    if (kernel == cpu::ProjectionKernel::dense)
+        profiler.add_dense_projections(1);
+    else
+        profiler.add_fan_out_projections(1);
+    return cpu::calculate_delta_synapse_projection(
+        projection, endpoint, message_queue, step, kernel, spike_density, spike_mask, activated_synapses,
+        aggregate_impacts);
+}
+
+}  // namespace
+
+
 SingleThreadedCPUBackend::SingleThreadedCPUBackend()
 {
     SPDLOG_INFO("Single-threaded CPU backend instance created.");
@@ -89,51 +112,76 @@ SupportedVariants convert_variant(const AllVariants &input)
 void SingleThreadedCPUBackend::_step()
 {
     SPDLOG_DEBUG("Starting step #{}...", get_step());
-    get_message_bus().route_messages();
-    get_message_endpoint().receive_all_messages();
+    auto &profiler = get_profiler();
+    auto &tracer = get_tracer();
+    core::StepProfiler::ScopedTimer step_timer(profiler.get_step_counter());
+    core::Tracer::Scope step_trace_scope(&tracer, "step", "backend");
+    route_messages();
     // Calculate populations. This is the same as inference.
-    for (auto &population : populations_)
     {
-        std::visit(
-            [this](auto &arg)
-            {
-                using T = std::decay_t<decltype(arg)>;
-                if constexpr (
-                    boost::mp11::mp_find<SupportedPopulations, T>{} == boost::mp11::mp_size<SupportedPopulations>{})
+        core::StepProfiler::ScopedTimer phase_timer(profiler.get_phase_counter(core::StepPhase::populations));
+        core::Tracer::Scope trace_scope(&tracer, "populations", "backend");
+        for (auto &population : populations_)
+        {
+            std::visit(
+                [this, &profiler](auto &arg)
                 {
-                    static_assert(
-                        knp::meta::always_false_v<T>,
-                        "Population is not supported by the single-threaded CPU backend.");
-                }
-                auto message_opt = calculate_population(arg);
-            },
-            population);
+                    using T = std::decay_t<decltype(arg)>;
+                    if constexpr (
+                        boost::mp11::mp_find<SupportedPopulations, T>{} ==
+                        boost::mp11::mp_size<SupportedPopulations>{})
+                    {
+                        static_assert(
+                            knp::meta::always_false_v<T>,
+                            "Population is not supported by the single-threaded CPU backend.");
+                    }
+                    core::StepProfiler::ScopedTimer timer(profiler.get_entity_counter(arg.get_uid()));
+                    auto message_opt = calculate_population(arg);
+                    if (message_opt) collect_statistics(*message_opt);
+                },
+                population);
+        }
     }
 
     // Continue inference.
-    get_message_bus().route_messages();
-    get_message_endpoint().receive_all_messages();
+    route_messages();
     // Calculate projections.
-    for (auto &projection : projections_)
     {
-        std::visit(
-            [this, &projection](auto &arg)
-            {
-                using T = std::decay_t<decltype(arg)>;
-                if constexpr (
-                    boost::mp11::mp_find<SupportedProjections, T>{} == boost::mp11::mp_size<SupportedProjections>{})
+        core::StepProfiler::ScopedTimer phase_timer(profiler.get_phase_counter(core::StepPhase::projections));
+        core::Tracer::Scope trace_scope(&tracer, "projections", "backend");
+        for (auto &projection : projections_)
+        {
+            std::visit(
+                [this, &projection, &profiler](auto &arg)
                 {
-                    static_assert(
-                        knp::meta::always_false_v<T>,
-                        "Projection is not supported by the single-threaded CPU backend.");
-                }
-                calculate_projection(arg, projection.messages_);
-            },
-            projection.arg_);
+                    using T = std::decay_t<decltype(arg)>;
+                    if constexpr (
+                        boost::mp11::mp_find<SupportedProjections, T>{} ==
+                        boost::mp11::mp_size<SupportedProjections>{})
+                    {
+                        static_assert(
+                            knp::meta::always_false_v<T>,
+                            "Projection is not supported by the single-threaded CPU backend.");
+                    }
+                    core::StepProfiler::ScopedTimer timer(profiler.get_entity_counter(arg.get_uid()));
+                    const bool aggregate_impacts = impact_aggregation_ && projection.aggregate_impacts_;
+                    // Only projections that store synapses select a kernel by spike density.
+                    if constexpr (knp::meta::is_specialization<T, core::Projection>::value)
+                    {
+                        profiler.add_impacts(calculate_projection(
+                            arg, projection.messages_, projection.spike_density_, projection.spike_mask_,
+                            projection.activated_synapses_, aggregate_impacts));
+                    }
+                    else
+                    {
+                        profiler.add_impacts(calculate_projection(arg, projection.messages_, aggregate_impacts));
+                    }
+                },
+                projection.arg_);
+        }
     }
 
-    get_message_bus().route_messages();
-    get_message_endpoint().receive_all_messages();
+    route_messages();
     auto step = gad_step();
     // Need to suppress "Unused variable" warning.
     (void)step;
@@ -165,15 +213,32 @@ void SingleThreadedCPUBackend::load_projections(const std::vector<ProjectionVari
     {
         projections_.push_back(ProjectionWrapper{projection});
     }
+    load_deferred_synapses();
 
     SPDLOG_DEBUG("All projections loaded.");
 }
 
 
+void SingleThreadedCPUBackend::load_deferred_synapses()
+{
+    for (auto &wrapper : projections_)
+    {
+        std::visit(
+            [](auto &projection)
+            {
+                using T = std::decay_t<decltype(projection)>;
+                if constexpr (knp::meta::is_specialization<T, core::Projection>::value) projection.load_synapses();
+            },
+            wrapper.arg_);
+    }
+}
+
+
 void SingleThreadedCPUBackend::load_all_projections(const std::vector<knp::core::AllProjectionsVariant> &projections)
 {
     SPDLOG_DEBUG("Loading projections [{}]...", projections.size());
     knp::meta::load_from_container<SupportedProjections>(projections, projections_);
+    load_deferred_synapses();
     SPDLOG_DEBUG("All projections loaded.");
 }
 
@@ -204,11 +269,33 @@ std::vector<std::unique_ptr<knp::core::Device>> SingleThreadedCPUBackend::get_de
 }
 
 
+core::MemoryUsage SingleThreadedCPUBackend::memory_usage() const
+{
+    auto result = Backend::memory_usage();
+    for (const auto &population : populations_)
+    {
+        result += std::visit([](const auto &entity) { return entity.memory_usage(); }, population);
+    }
+    for (const auto &projection : projections_)
+    {
+        result += std::visit([](const auto &entity) { return entity.memory_usage(); }, projection.arg_);
+        result.messages_ += core::hash_container_bytes(projection.messages_);
+        // Message structures are accounted in container nodes, so only message data are added.
+        for (const auto &[step, message] : projection.messages_)
+        {
+            result.messages_ += core::messaging::message_bytes(message) - sizeof(message);
+        }
+    }
+    return result;
+}
+
+
 void SingleThreadedCPUBackend::_init()
 {
     SPDLOG_DEBUG("Initializing single-threaded CPU backend...");
 
     knp::backends::cpu::init(projections_, get_message_endpoint());
+    knp::backends::cpu::init_impact_aggregation(projections_, populations_, get_message_endpoint());
 
     SPDLOG_DEBUG("Initialization finished.");
 }
@@ -232,32 +319,69 @@ std::optional<core::messaging::SpikeMessage> SingleThreadedCPUBackend::calculate
 }
 
 
-void SingleThreadedCPUBackend::calculate_projection(
-    knp::core::Projection<knp::synapse_traits::DeltaSynapse> &projection, SynapticMessageQueue &message_queue)
+size_t SingleThreadedCPUBackend::calculate_projection(
+    knp::core::Projection<knp::synapse_traits::DeltaSynapse> &projection, SynapticMessageQueue &message_queue,
+    double &spike_density, std::vector<uint32_t> &spike_mask, std::vector<size_t> &activated_synapses,
+    bool aggregate_impacts)
 {
     SPDLOG_TRACE("Calculate delta synapse projection {}.", std::string(projection.get_uid()));
-    knp::backends::cpu::calculate_delta_synapse_projection(
-        projection, get_message_endpoint(), message_queue, get_step());
+    return calculate_delta_projection(
+        projection, get_message_endpoint(), message_queue, get_step(), spike_density, spike_mask, activated_synapses,
+        aggregate_impacts, get_profiler());
 }
 
 
-void SingleThreadedCPUBackend::calculate_projection(
+size_t SingleThreadedCPUBackend::calculate_projection(
     knp::core::Projection<knp::synapse_traits::AdditiveSTDPDeltaSynapse> &projection,
-    SynapticMessageQueue &message_queue)
+    SynapticMessageQueue &message_queue, double &spike_density, std::vector<uint32_t> &spike_mask,
+    std::vector<size_t> &activated_synapses, bool aggregate_impacts)
 {
     SPDLOG_TRACE("Calculate AdditiveSTDPDelta synapse projection {}.", std::string(projection.get_uid()));
-    knp::backends::cpu::calculate_delta_synapse_projection(
-        projection, get_message_endpoint(), message_queue, get_step());
+    return calculate_delta_projection(
+        projection, get_message_endpoint(), message_queue, get_step(), spike_density, spike_mask, activated_synapses,
+        aggregate_impacts, get_profiler());
 }
 
 
-void SingleThreadedCPUBackend::calculate_projection(
+size_t SingleThreadedCPUBackend::calculate_projection(
     knp::core::Projection<knp::synapse_traits::SynapticResourceSTDPDeltaSynapse> &projection,
-    SynapticMessageQueue &message_queue)
+    SynapticMessageQueue &message_queue, double &spike_density, std::vector<uint32_t> &spike_mask,
+    std::vector<size_t> &activated_synapses, bool aggregate_impacts)
 {
     SPDLOG_TRACE("Calculate STDPSynapticResource synapse projection {}.", std::string(projection.get_uid()));
-    knp::backends::cpu::calculate_delta_synapse_projection(
-        projection, get_message_endpoint(), message_queue, get_step());
+    return calculate_delta_projection(
+        projection, get_message_endpoint(), message_queue, get_step(), spike_density, spike_mask, activated_synapses,
+        aggregate_impacts, get_profiler());
+}
+
+
+size_t SingleThreadedCPUBackend::calculate_projection(
+    const knp::core::CompactProjection<knp::synapse_traits::DeltaSynapse> &projection,
+    SynapticMessageQueue &message_queue, bool aggregate_impacts)
+{
+    SPDLOG_TRACE("Calculate compact delta synapse projection {}.", std::string(projection.get_uid()));
+    return knp::backends::cpu::calculate_compact_projection(
+        projection, get_message_endpoint(), message_queue, get_step(), aggregate_impacts);
+}
+
+
+size_t SingleThreadedCPUBackend::calculate_projection(
+    const knp::core::ProceduralProjection<knp::synapse_traits::DeltaSynapse> &projection,
+    SynapticMessageQueue &message_queue, bool aggregate_impacts)
+{
+    SPDLOG_TRACE("Calculate procedural delta synapse projection {}.", std::string(projection.get_uid()));
+    return knp::backends::cpu::calculate_procedural_projection(
+        projection, get_message_endpoint(), message_queue, get_step(), aggregate_impacts);
+}
+
+
+size_t SingleThreadedCPUBackend::calculate_projection(
+    const knp::core::ConvolutionProjection<knp::synapse_traits::DeltaSynapse> &projection,
+    SynapticMessageQueue &message_queue, bool aggregate_impacts)
+{
+    SPDLOG_TRACE("Calculate convolution delta synapse projection {}.", std::string(projection.get_uid()));
+    return knp::backends::cpu::calculate_convolution_projection(
+        projection, get_message_endpoint(), message_queue, get_step(), aggregate_impacts);
 }
 
 
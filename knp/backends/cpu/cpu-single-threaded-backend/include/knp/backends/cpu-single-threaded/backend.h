@@ -21,11 +21,12 @@
 
 #pragma once
 
+#include <knp/core/all_projections.h>
 #include <knp/core/backend.h>
 #include <knp/core/impexp.h>
 #include <knp/core/population.h>
-#include <knp/core/projection.h>
 #include <knp/devices/cpu.h>
+#include <knp/meta/specialization_helpers.h>
 #include <knp/neuron-traits/all_traits.h>
 #include <knp/synapse-traits/all_traits.h>
 
@@ -72,8 +73,10 @@ public:
 
     /**
      * @brief List of supported projection types based on synapse types specified in `SupportedSynapses`.
+     * @details Projection types of `knp::core::InferenceProjections` are also supported.
      */
-    using SupportedProjections = boost::mp11::mp_transform<knp::core::Projection, SupportedSynapses>;
+    using SupportedProjections = boost::mp11::mp_append<
+        boost::mp11::mp_transform<knp::core::Projection, SupportedSynapses>, knp::core::InferenceProjections>;
 
     /**
      * @brief Population variant that contains any population type specified in `SupportedPopulations`.
@@ -103,6 +106,14 @@ private:
         ProjectionVariants arg_;
         // cppcheck-suppress unusedStructMember
         std::unordered_map<uint64_t, knp::core::messaging::SynapticImpactMessage> messages_;
+        // Estimated fraction of synapses activated on a step, selects the projection kernel.
+        double spike_density_ = 0;
+        // Spike counts of presynaptic neurons used by the dense kernel, kept between steps.
+        std::vector<uint32_t> spike_mask_;
+        // Indexes of synapses activated on a step used by the fan-out kernel, kept between steps.
+        std::vector<size_t> activated_synapses_;
+        // Postsynaptic population is calculated by the backend, so impacts can be sent as aggregated impact messages.
+        bool aggregate_impacts_ = false;
     };
 
 public:
@@ -265,6 +276,30 @@ public:
      */
     void remove_populations(const std::vector<knp::core::UID> &uids) override {}
 
+public:
+    /**
+     * @brief Start sending aggregated impact messages.
+     * @details A projection whose postsynaptic population is calculated by the backend sends impacts summed by
+     * postsynaptic neuron and output type as an aggregated impact message. Projections to populations of neurons
+     * that don't process aggregated impact messages still send synaptic impact messages. Aggregation is disabled by
+     * default.
+     * @warning Aggregating projections don't send synaptic impact messages, so other subscribers to synaptic impact
+     * messages of these projections, such as observers, don't receive impacts.
+     */
+    void enable_impact_aggregation() { impact_aggregation_ = true; }
+
+    /**
+     * @brief Stop sending aggregated impact messages.
+     * @details Projections send synaptic impact messages.
+     */
+    void disable_impact_aggregation() { impact_aggregation_ = false; }
+
+    /**
+     * @brief Determine if projections send aggregated impact messages.
+     * @return `true` if impact aggregation is enabled.
+     */
+    [[nodiscard]] bool is_impact_aggregation_enabled() const { return impact_aggregation_; }
+
 public:
     /**
      * @brief Get a list of devices supported by the backend.
@@ -285,7 +320,17 @@ public:
     void stop_learning() override
     {
         for (ProjectionWrapper &wrapper : projections_)
-            std::visit([](auto &entity) { entity.lock_weights(); }, wrapper.arg_);
+        {
+            std::visit(
+                [](auto &entity)
+                {
+                    // Inference projections have no trainable synapses.
+                    using T = std::decay_t<decltype(entity)>;
+                    if constexpr (knp::meta::is_specialization<T, knp::core::Projection>::value)
+                        entity.lock_weights();
+                },
+                wrapper.arg_);
+        }
     }
 
     /**
@@ -298,7 +343,17 @@ public:
          * `lock()`.
          */
         for (ProjectionWrapper &wrapper : projections_)
-            std::visit([](auto &entity) { entity.unlock_weights(); }, wrapper.arg_);
+        {
+            std::visit(
+                [](auto &entity)
+                {
+                    // Inference projections have no trainable synapses.
+                    using T = std::decay_t<decltype(entity)>;
+                    if constexpr (knp::meta::is_specialization<T, knp::core::Projection>::value)
+                        entity.unlock_weights();
+                },
+                wrapper.arg_);
+        }
     }
 
     /**
@@ -307,6 +362,14 @@ public:
      */
     [[nodiscard]] DataRanges get_network_data() const override;
 
+    /**
+     * @brief Get memory used by the backend.
+     * @details Memory of populations, projections, the message endpoint and queues of future projection messages
+     * is accounted.
+     * @return memory usage.
+     */
+    [[nodiscard]] core::MemoryUsage memory_usage() const override;
+
 protected:
     /**
      * @brief Map used for message construction. It maps a message to its future output step.
@@ -340,32 +403,85 @@ protected:
      * @note Projection will be changed during calculation.
      * @param projection projection to calculate.
      * @param message_queue message queue to send to projection for calculation.
+     * @param spike_density spike density estimate of the projection, used to select the calculation kernel.
+     * @param spike_mask spike mask buffer of the projection.
+     * @param activated_synapses activated synapse buffer of the projection.
+     * @param aggregate_impacts `true` to send impacts as an aggregated impact message.
+     * @return number of synaptic impacts sent by the projection.
      */
-    void calculate_projection(
-        knp::core::Projection<knp::synapse_traits::DeltaSynapse> &projection, SynapticMessageQueue &message_queue);
+    size_t calculate_projection(
+        knp::core::Projection<knp::synapse_traits::DeltaSynapse> &projection, SynapticMessageQueue &message_queue,
+        double &spike_density, std::vector<uint32_t> &spike_mask, std::vector<size_t> &activated_synapses,
+        bool aggregate_impacts);
     /**
      * @brief Calculate projection of `AdditiveSTDPDeltaSynapse` synapses.
      * @note Projection will be changed during calculation.
      * @param projection projection to calculate.
      * @param message_queue message queue to send to projection for calculation.
+     * @param spike_density spike density estimate of the projection, used to select the calculation kernel.
+     * @param spike_mask spike mask buffer of the projection.
+     * @param activated_synapses activated synapse buffer of the projection.
+     * @param aggregate_impacts `true` to send impacts as an aggregated impact message.
+     * @return number of synaptic impacts sent by the projection.
      */
-    void calculate_projection(
+    size_t calculate_projection(
         knp::core::Projection<knp::synapse_traits::AdditiveSTDPDeltaSynapse> &projection,
-        SynapticMessageQueue &message_queue);
+        SynapticMessageQueue &message_queue, double &spike_density, std::vector<uint32_t> &spike_mask,
+        std::vector<size_t> &activated_synapses, bool aggregate_impacts);
     /**
      * @brief Calculate projection of `SynapticResourceSTDPDeltaSynapse` synapses.
      * @note Projection will be changed during calculation.
      * @param projection projection to calculate.
      * @param message_queue message queue to send to projection for calculation.
+     * @param spike_density spike density estimate of the projection, used to select the calculation kernel.
+     * @param spike_mask spike mask buffer of the projection.
+     * @param activated_synapses activated synapse buffer of the projection.
+     * @param aggregate_impacts `true` to send impacts as an aggregated impact message.
+     * @return number of synaptic impacts sent by the projection.
      */
-    void calculate_projection(
+    size_t calculate_projection(
         knp::core::Projection<knp::synapse_traits::SynapticResourceSTDPDeltaSynapse> &projection,
-        SynapticMessageQueue &message_queue);
+        SynapticMessageQueue &message_queue, double &spike_density, std::vector<uint32_t> &spike_mask,
+        std::vector<size_t> &activated_synapses, bool aggregate_impacts);
+    /**
+     * @brief Calculate compact projection of delta synapses.
+     * @param projection projection to calculate.
+     * @param message_queue message queue to send to projection for calculation.
+     * @param aggregate_impacts `true` to send impacts as an aggregated impact message.
+     * @return number of synaptic impacts sent by the projection.
+     */
+    size_t calculate_projection(
+        const knp::core::CompactProjection<knp::synapse_traits::DeltaSynapse> &projection,
+        SynapticMessageQueue &message_queue, bool aggregate_impacts);
+    /**
+     * @brief Calculate procedural projection of delta synapses.
+     * @param projection projection to calculate.
+     * @param message_queue message queue to send to projection for calculation.
+     * @param aggregate_impacts `true` to send impacts as an aggregated impact message.
+     * @return number of synaptic impacts sent by the projection.
+     */
+    size_t calculate_projection(
+        const knp::core::ProceduralProjection<knp::synapse_traits::DeltaSynapse> &projection,
+        SynapticMessageQueue &message_queue, bool aggregate_impacts);
+    /**
+     * @brief Calculate convolution projection of delta synapses.
+     * @param projection projection to calculate.
+     * @param message_queue message queue to send to projection for calculation.
+     * @param aggregate_impacts `true` to send impacts as an aggregated impact message.
+     * @return number of synaptic impacts sent by the projection.
+     */
+    size_t calculate_projection(
+        const knp::core::ConvolutionProjection<knp::synapse_traits::DeltaSynapse> &projection,
+        SynapticMessageQueue &message_queue, bool aggregate_impacts);
 
 private:
+    // Load synapses of projections with deferred loading into the backend copies.
+    void load_deferred_synapses();
+
     // cppcheck-suppress unusedStructMember
     PopulationContainer populations_;
     ProjectionContainer projections_;
+    bool impact_aggregation_ = false;
 };
 
 }  // namespace knp::backends::single_threaded_cpu
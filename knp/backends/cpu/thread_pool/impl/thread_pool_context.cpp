@@ -81,7 +81,10 @@ void ThreadPoolContext::execute(std::unique_lock<std::mutex> &lock, std::shared_
     std::shared_ptr<size_t> work_count(std::move(work->work_count_));
     try
     {
-        work->execute_(work);
+        {
+            knp::core::Tracer::Scope trace_scope(tracer_, "task", "thread_pool");
+            work->execute_(work);
+        }
         lock.lock();
         do_work_finished(work_count);
     }
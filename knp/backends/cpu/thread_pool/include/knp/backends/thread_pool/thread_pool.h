@@ -19,7 +19,9 @@
  * limitations under the License.
  */
 #pragma once
+#include <functional>
 #include <memory>
+#include <utility>
 
 #include "thread_pool_context.h"
 #include "thread_pool_executor.h"
@@ -50,13 +52,13 @@ public:
      * @tparam Func function type.
      * @tparam Args function arguments.
      * @param func task to run in the pool.
-     * @param args function arguments (if required, use `std::ref`).
+     * @param args function arguments (if required, use `std::ref`). Rvalue arguments are moved into the task.
      * @note Non-blocking method.
      */
     template <class Func, typename... Args>
-    void post(Func func, Args... args)
+    void post(Func &&func, Args &&...args)
     {
-        boost::asio::post(executor_, std::bind(func, args...));
+        boost::asio::post(executor_, std::bind(std::forward<Func>(func), std::forward<Args>(args)...));
     }
 
     /**
@@ -65,6 +67,13 @@ public:
      */
     void join() { executor_.join(); }
 
+    /**
+     * @brief Set tracer used to record task execution and waiting in `join()`.
+     * @param tracer tracer, `nullptr` to disable tracing.
+     * @note Set tracer when there are no tasks in the pool.
+     */
+    void set_tracer(knp::core::Tracer *tracer) { context_->set_tracer(tracer); }
+
 private:
     // Do not change the order of declarations.
     std::unique_ptr<ThreadPoolContext> context_;
@@ -20,6 +20,8 @@
  */
 #pragma once
 
+#include <knp/core/tracer.h>
+
 #include <condition_variable>
 #include <memory>
 #include <mutex>
@@ -59,6 +61,18 @@ public:
 
     // Move and assignment are implicitly deleted because of mutex.
 
+    /**
+     * @brief Set tracer used to record task execution.
+     * @param tracer tracer, `nullptr` to disable tracing.
+     * @note Set tracer when there are no tasks in the pool.
+     */
+    void set_tracer(knp::core::Tracer *tracer) { tracer_ = tracer; }
+
+    /**
+     * @brief Get tracer used to record task execution.
+     * @return tracer or `nullptr` if tracing is disabled.
+     */
+    [[nodiscard]] knp::core::Tracer *get_tracer() const { return tracer_; }
 
 private:
     enum class Usage
@@ -98,6 +112,7 @@ private:
     Usage usage_state_ = Usage::READY;
     // cppcheck-suppress unusedStructMember
     std::queue<std::shared_ptr<Function>> work_queue_;
+    knp::core::Tracer *tracer_ = nullptr;
     boost::asio::thread_pool pool_;
 };
 
@@ -78,6 +78,7 @@ public:
      */
     void join() const
     {
+        knp::core::Tracer::Scope trace_scope(context_.tracer_, "join", "thread_pool");
         std::unique_lock<std::mutex> lock(context_.mutex_);
         while (*task_count_ > 0)
             if (!context_.execute_next(lock)) context_.condition_.wait(lock);
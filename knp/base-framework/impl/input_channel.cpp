@@ -0,0 +1,213 @@
+/**
+ * @file input_channel.cpp
+ * @brief Input channel class implementation.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/framework/io/input_channel.h>
+#include <knp/framework/spsc_queue.h>
+
+#include <spdlog/spdlog.h>
+
+#include <atomic>
+#include <exception>
+#include <string>
+#include <thread>
+#include <utility>
+
+
+namespace knp::framework::io::input
+{
+
+class InputChannel::Prefetcher
+{
+public:
+    Prefetcher(DataGenerator &&generator, size_t prefetch_steps)
+        : generator_(std::move(generator)), queue_(prefetch_steps)
+    {
+    }
+
+    ~Prefetcher() { stop(); }
+
+    Prefetcher(const Prefetcher &) = delete;
+    Prefetcher &operator=(const Prefetcher &) = delete;
+
+public:
+    // Get data generated for the step, waiting for the producer if the data is not ready yet.
+    core::messaging::SpikeData get(core::Step step)
+    {
+        if (!producer_.joinable() || step != next_step_) restart(step);
+
+        Item item;
+        Backoff backoff;
+        while (!queue_.try_pop(item)) backoff.wait();
+        ++next_step_;
+
+        if (item.error_)
+        {
+            // The producer has finished, generation restarts on the next call.
+            stop();
+            std::rethrow_exception(item.error_);
+        }
+        return std::move(item.data_);
+    }
+
+    // Stop generation and return the generator.
+    DataGenerator release()
+    {
+        stop();
+        return std::move(generator_);
+    }
+
+    [[nodiscard]] size_t capacity() const { return queue_.capacity(); }
+
+private:
+    struct Item
+    {
+        core::messaging::SpikeData data_;
+        std::exception_ptr error_;
+    };
+
+    void restart(core::Step step)
+    {
+        stop();
+        Item item;
+        while (queue_.try_pop(item))
+        {
+        }
+        SPDLOG_TRACE("Starting background input generation from step {}...", step);
+        next_step_ = step;
+        stop_ = false;
+        producer_ = std::thread([this, step]() { run(step); });
+    }
+
+    void stop()
+    {
+        stop_ = true;
+        if (producer_.joinable()) producer_.join();
+    }
+
+    void run(core::Step step)
+    {
+        Backoff backoff;
+        while (!stop_)
+        {
+            Item item;
+            try
+            {
+                item.data_ = generator_(step);
+            }
+            catch (...)
+            {
+                item.error_ = std::current_exception();
+            }
+
+            const bool failed = static_cast<bool>(item.error_);
+            while (!queue_.try_push(std::move(item)))
+            {
+                if (stop_) return;
+                backoff.wait();
+            }
+            backoff.reset();
+            // The consumer rethrows the exception.
+            if (failed) return;
+            ++step;
+        }
+    }
+
+private:
+    DataGenerator generator_;
+    SPSCQueue<Item> queue_;
+    std::thread producer_;
+    std::atomic<bool> stop_ = false;
+    // Step that the consumer expects next, used by the consumer thread only.
+    core::Step next_step_ = 0;
+};
+
+
+InputChannel::InputChannel(
+    const core::UID &channel_uid, core::MessageEndpoint &&endpoint, const DataGenerator &generator)
+    : base_{channel_uid}, endpoint_(std::move(endpoint)), generator_(generator)
+{
+}
+
+
+InputChannel::InputChannel(const core::UID &channel_uid, core::MessageEndpoint &&endpoint, DataGenerator &&generator)
+    : base_{channel_uid}, endpoint_(std::move(endpoint)), generator_(std::move(generator))
+{
+}
+
+
+InputChannel::InputChannel(InputChannel &&) = default;
+
+
+InputChannel::~InputChannel() = default;
+
+
+bool InputChannel::send(core::Step step)
+{
+    if (step >= staged_first_step_ && step - staged_first_step_ < staged_data_.size())
+    {
+        return send_data(staged_data_[step - staged_first_step_], step);
+    }
+    return send_data(prefetcher_ ? prefetcher_->get(step) : generator_(step), step);
+}
+
+
+void InputChannel::stage(core::Step first_step, size_t steps_count)
+{
+    staged_data_.clear();
+    staged_data_.reserve(steps_count);
+    staged_first_step_ = first_step;
+    for (core::Step step = first_step; step < first_step + steps_count; ++step)
+    {
+        staged_data_.push_back(prefetcher_ ? prefetcher_->get(step) : generator_(step));
+    }
+}
+
+
+void InputChannel::clear_staged()
+{
+    std::vector<core::messaging::SpikeData>().swap(staged_data_);
+}
+
+
+void InputChannel::set_prefetch_steps(size_t prefetch_steps)
+{
+    if (get_prefetch_steps() == prefetch_steps) return;
+
+    if (prefetcher_)
+    {
+        generator_ = prefetcher_->release();
+        prefetcher_.reset();
+    }
+
+    if (prefetch_steps)
+    {
+        SPDLOG_DEBUG("Input channel {} generates data {} steps in advance.", std::string(get_uid()), prefetch_steps);
+        prefetcher_ = std::make_unique<Prefetcher>(std::move(generator_), prefetch_steps);
+    }
+}
+
+
+size_t InputChannel::get_prefetch_steps() const
+{
+    return prefetcher_ ? prefetcher_->capacity() : 0;
+}
+
+}  // namespace knp::framework::io::input
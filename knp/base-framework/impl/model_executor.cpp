@@ -20,9 +20,18 @@
  */
 
 #include <knp/framework/model_executor.h>
+#include <knp/framework/spsc_queue.h>
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
 
 namespace knp::framework
 {
@@ -72,15 +81,88 @@ void ModelExecutor::SpikeMessageHandler::update(size_t step)
 }
 
 
+class ModelExecutor::AsyncRunner
+{
+public:
+    // Execute commands and wait while execution is paused. Called on the simulation thread before each step.
+    bool before_step(core::Backend &backend, core::Step step)
+    {
+        step_ = step;
+        execute_commands(backend);
+        if (paused_)
+        {
+            SPDLOG_DEBUG("Model execution paused on step {}.", step);
+            std::unique_lock lock(mutex_);
+            while (paused_ && !stop_)
+            {
+                wake_up_.wait(lock, [this]() { return !paused_ || stop_ || !commands_->empty(); });
+                lock.unlock();
+                execute_commands(backend);
+                lock.lock();
+            }
+        }
+        return !stop_ && step < until_step_;
+    }
+
+    void execute_commands(core::Backend &backend)
+    {
+        Command command;
+        while (commands_->try_pop(command)) command(backend);
+    }
+
+    void finish(core::Backend &backend, core::Step step)
+    {
+        step_ = step;
+        {
+            std::lock_guard lock(producer_mutex_);
+            running_ = false;
+        }
+        notify();
+        // No command can be posted after `running_` is reset, so all accepted commands are executed.
+        execute_commands(backend);
+    }
+
+    // Wake up the simulation thread after a flag change. Locking prevents lost wake-ups.
+    void notify()
+    {
+        {
+            std::lock_guard lock(mutex_);
+        }
+        wake_up_.notify_all();
+    }
+
+public:
+    std::thread thread_;
+    std::unique_ptr<SPSCQueue<Command>> commands_;
+    // The command queue has a single producer, so threads that post commands are serialized.
+    std::mutex producer_mutex_;
+    std::atomic<bool> running_ = false;
+    std::atomic<bool> stop_ = false;
+    std::atomic<bool> paused_ = false;
+    std::atomic<core::Step> until_step_ = std::numeric_limits<core::Step>::max();
+    std::atomic<core::Step> step_ = 0;
+    std::mutex mutex_;
+    std::condition_variable wake_up_;
+};
+
+
 ModelExecutor::ModelExecutor(
     knp::framework::Model &model, std::shared_ptr<core::Backend> backend, ModelLoader::InputChannelMap i_map)
-    : loader_(backend, i_map)
+    : loader_(backend, i_map), async_runner_(std::make_unique<AsyncRunner>())
 {
     loader_.load(model);
 }
 
 
-ModelExecutor::~ModelExecutor() = default;
+ModelExecutor::~ModelExecutor()
+{
+    if (async_runner_->thread_.joinable())
+    {
+        async_runner_->stop_ = true;
+        async_runner_->notify();
+        async_runner_->thread_.join();
+    }
+}
 
 
 void ModelExecutor::start()
@@ -109,7 +191,7 @@ void ModelExecutor::start(core::Backend::RunPredicate run_predicate)
             // Loading spikes into output channels.
             for (auto &o_ch : loader_.get_outputs())
             {
-                o_ch.update();
+                o_ch.unload_messages();
             }
             // Running handlers
             for (auto &handler : message_handlers_)
@@ -124,16 +206,171 @@ void ModelExecutor::start(core::Backend::RunPredicate run_predicate)
 
             return true;
         });
+    // Wait for asynchronous observers.
+    for (auto &observer : observers_)
+    {
+        std::visit([](auto &entity) { entity.flush(); }, observer);
+    }
     SPDLOG_INFO("Model execution stopped.");
 }
 
 
+size_t ModelExecutor::run_for(size_t steps_count, size_t update_period)
+{
+    if (!update_period) throw std::invalid_argument("Update period must be greater than 0.");
+    SPDLOG_INFO("Running model execution for {} steps...", steps_count);
+
+    auto backend = get_backend();
+    const core::Step first_step = backend->get_step();
+    size_t steps_made = 0;
+
+    while (steps_made < steps_count)
+    {
+        const size_t batch_steps = std::min(update_period, steps_count - steps_made);
+        const core::Step batch_first_step = backend->get_step();
+        for (auto &i_ch : loader_.get_inputs()) i_ch.stage(batch_first_step, batch_steps);
+
+        const size_t batch_steps_made = backend->run_steps(
+            batch_steps,
+            [this, first_step](core::Step step)
+            {
+                // Handler messages for a step are sent after the previous step.
+                if (step != first_step)
+                {
+                    for (auto &handler : message_handlers_) handler->update(step);
+                }
+                for (auto &i_ch : loader_.get_inputs()) i_ch.send(step);
+            });
+
+        steps_made += batch_steps_made;
+        update_outputs();
+        if (batch_steps_made < batch_steps || !backend->running()) break;
+    }
+    for (auto &i_ch : loader_.get_inputs()) i_ch.clear_staged();
+
+    if (steps_made)
+    {
+        for (auto &handler : message_handlers_) handler->update(backend->get_step());
+    }
+    // Wait for asynchronous observers.
+    for (auto &observer : observers_)
+    {
+        std::visit([](auto &entity) { entity.flush(); }, observer);
+    }
+    SPDLOG_INFO("Model execution made {} steps.", steps_made);
+    return steps_made;
+}
+
+
+void ModelExecutor::update_outputs()
+{
+    for (auto &o_ch : loader_.get_outputs())
+    {
+        o_ch.unload_messages();
+    }
+    for (auto &observer : observers_)
+    {
+        std::visit([](auto &entity) { entity.update(); }, observer);
+    }
+}
+
+
 void ModelExecutor::stop()
 {
+    if (async_runner_->running_)
+    {
+        async_runner_->stop_ = true;
+        async_runner_->notify();
+        return;
+    }
     get_backend()->stop();
 }
 
 
+std::future<void> ModelExecutor::start_async(size_t command_queue_size)
+{
+    auto &runner = *async_runner_;
+    if (runner.running_) throw std::logic_error("Model execution already runs in background.");
+    if (runner.thread_.joinable()) runner.thread_.join();
+
+    auto backend = get_backend();
+    runner.commands_ = std::make_unique<SPSCQueue<Command>>(command_queue_size);
+    runner.stop_ = false;
+    runner.until_step_ = std::numeric_limits<core::Step>::max();
+    runner.step_ = backend->get_step();
+    runner.running_ = true;
+
+    std::packaged_task<void()> task(
+        [this, backend]()
+        {
+            try
+            {
+                start([this, &backend](core::Step step) { return async_runner_->before_step(*backend, step); });
+            }
+            catch (...)
+            {
+                async_runner_->finish(*backend, backend->get_step());
+                throw;
+            }
+            async_runner_->finish(*backend, backend->get_step());
+        });
+    auto result = task.get_future();
+    runner.thread_ = std::thread(std::move(task));
+
+    return result;
+}
+
+
+void ModelExecutor::pause()
+{
+    async_runner_->paused_ = true;
+}
+
+
+void ModelExecutor::resume()
+{
+    async_runner_->paused_ = false;
+    async_runner_->notify();
+}
+
+
+bool ModelExecutor::is_paused() const
+{
+    return async_runner_->paused_;
+}
+
+
+void ModelExecutor::run_until(core::Step step)
+{
+    async_runner_->until_step_ = step;
+}
+
+
+core::Step ModelExecutor::get_async_step() const
+{
+    return async_runner_->step_;
+}
+
+
+void ModelExecutor::post(Command &&command)
+{
+    auto &runner = *async_runner_;
+
+    Backoff backoff;
+    while (true)
+    {
+        {
+            std::lock_guard lock(runner.producer_mutex_);
+            if (!runner.running_) throw std::logic_error("Model execution doesn't run in background.");
+            if (runner.commands_->try_push(std::move(command))) break;
+        }
+        // The lock is not held while waiting, so that execution can finish.
+        backoff.wait();
+    }
+    runner.notify();
+}
+
+
 void ModelExecutor::add_spike_message_handler(
     typename SpikeMessageHandler::FunctionType &&message_handler_function, const std::vector<core::UID> &senders,
     const std::vector<core::UID> &receivers, const knp::core::UID &uid)
@@ -312,6 +312,21 @@ void Network::remove_projection(const core::UID &projection_uid)
 }
 
 
+core::MemoryUsage Network::memory_usage() const
+{
+    core::MemoryUsage result;
+    for (const auto &population : populations_)
+    {
+        result += std::visit([](const auto &entity) { return entity.memory_usage(); }, population);
+    }
+    for (const auto &projection : projections_)
+    {
+        result += std::visit([](const auto &entity) { return entity.memory_usage(); }, projection);
+    }
+    return result;
+}
+
+
 template <typename PopulationType>
 void Network::check_population_constraints(const PopulationType &population) const
 {
@@ -378,9 +393,18 @@ namespace st = knp::synapse_traits;
         const knp::core::UID &) const;                                                                              \
     template KNP_DECLSPEC void Network::check_projection_constraints<knp::core::Projection<st::synapse_type>>(      \
         const knp::core::Projection<st::synapse_type> &) const;
+
+#define INSTANCE_INFERENCE_PROJECTION_FUNCTIONS(projection_type)                                                   \
+    template KNP_DECLSPEC void Network::add_projection<knp::core::projection_type>(knp::core::projection_type &&); \
+    template KNP_DECLSPEC void Network::add_projection<knp::core::projection_type>(knp::core::projection_type &);  \
+    template KNP_DECLSPEC void Network::check_projection_constraints<knp::core::projection_type>(                  \
+        const knp::core::projection_type &) const;
 // cppcheck-suppress unknownMacro
 BOOST_PP_SEQ_FOR_EACH(INSTANCE_POPULATION_FUNCTIONS, "", BOOST_PP_VARIADIC_TO_SEQ(ALL_NEURONS))
 // cppcheck-suppress unknownMacro
 BOOST_PP_SEQ_FOR_EACH(INSTANCE_PROJECTION_FUNCTIONS, "", BOOST_PP_VARIADIC_TO_SEQ(ALL_SYNAPSES))
+INSTANCE_INFERENCE_PROJECTION_FUNCTIONS(CompactProjection<st::DeltaSynapse>)
+INSTANCE_INFERENCE_PROJECTION_FUNCTIONS(ProceduralProjection<st::DeltaSynapse>)
+INSTANCE_INFERENCE_PROJECTION_FUNCTIONS(ConvolutionProjection<st::DeltaSynapse>)
 
 }  // namespace knp::framework
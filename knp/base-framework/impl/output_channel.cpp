@@ -21,33 +21,122 @@
 
 #include <knp/framework/io/output_channel.h>
 
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <string>
+
 namespace knp::framework::io::output
 {
-auto comp_lower(const core::messaging::SpikeMessage &message, core::Step step)
-{
-    return message.header_.send_time_ < step;
-}
+// Minimal number of buffer slots allocated at once.
+constexpr size_t min_buffer_slots = 16;
 
 
-auto comp_upper(core::Step step, const core::messaging::SpikeMessage &message)
+// Get number of slots for a growing buffer: buffer grows geometrically up to its limit.
+size_t get_slots_count(size_t required_count, size_t current_count, size_t max_count)
 {
-    return step < message.header_.send_time_;
+    const size_t slots_count = std::max({required_count, 2 * current_count, min_buffer_slots});
+    return max_count ? std::min(slots_count, max_count) : slots_count;
 }
 
 
-std::vector<core::messaging::SpikeMessage> OutputChannel::update()
+size_t OutputChannel::unload_messages()
 {
     endpoint_.receive_all_messages();
     auto messages = endpoint_.unload_messages<core::messaging::SpikeMessage>(base_.uid_);
 
-    message_buffer_.reserve(message_buffer_.size() + messages.size());
+    size_t new_messages = 0;
     for (auto &&message : messages)
     {
-        // cppcheck-suppress useStlAlgorithm
-        message_buffer_.push_back(std::move(message));
+        new_messages += buffer_message(std::move(message));
     }
 
-    return message_buffer_;
+    return new_messages;
+}
+
+
+std::vector<core::messaging::SpikeMessage> OutputChannel::update()
+{
+    unload_messages();
+
+    std::vector<core::messaging::SpikeMessage> result;
+    for (core::Step step = first_step_; step < first_step_ + steps_count_; ++step)
+    {
+        const auto &slot = message_buffer_[step % message_buffer_.size()];
+        result.insert(result.end(), slot.begin(), slot.end());
+    }
+    return result;
+}
+
+
+bool OutputChannel::buffer_message(core::messaging::SpikeMessage &&message)
+{
+    const core::Step step = message.header_.send_time_;
+    if (!steps_count_) first_step_ = step;
+
+    if (step < first_step_)
+    {
+        // Messages usually arrive in step order, but an earlier step can still fit into the buffer limit.
+        const size_t new_count = first_step_ + steps_count_ - step;
+        if (max_buffered_steps_ && new_count > max_buffered_steps_)
+        {
+            SPDLOG_TRACE("Output channel {} discarded a message of step {}.", std::string(base_.uid_), step);
+            return false;
+        }
+        if (new_count > message_buffer_.size())
+            resize_buffer(get_slots_count(new_count, message_buffer_.size(), max_buffered_steps_));
+        first_step_ = step;
+        steps_count_ = new_count;
+    }
+    else if (step >= first_step_ + steps_count_)
+    {
+        size_t new_count = step - first_step_ + 1;
+        if (max_buffered_steps_ && new_count > max_buffered_steps_)
+        {
+            discard_oldest_steps(new_count - max_buffered_steps_);
+            // Discarding can move the first step beyond the new one if the buffer becomes empty.
+            if (!steps_count_) first_step_ = step;
+            new_count = step - first_step_ + 1;
+        }
+        if (new_count > message_buffer_.size())
+            resize_buffer(get_slots_count(new_count, message_buffer_.size(), max_buffered_steps_));
+        steps_count_ = new_count;
+    }
+
+    message_buffer_[step % message_buffer_.size()].push_back(std::move(message));
+    return true;
+}
+
+
+void OutputChannel::discard_oldest_steps(size_t steps_count)
+{
+    steps_count = std::min(steps_count, steps_count_);
+    for (size_t i = 0; i < steps_count; ++i)
+    {
+        message_buffer_[(first_step_ + i) % message_buffer_.size()].clear();
+    }
+    first_step_ += steps_count;
+    steps_count_ -= steps_count;
+}
+
+
+void OutputChannel::resize_buffer(size_t slots_count)
+{
+    std::vector<std::vector<core::messaging::SpikeMessage>> new_buffer(slots_count);
+    for (core::Step step = first_step_; step < first_step_ + steps_count_; ++step)
+    {
+        new_buffer[step % slots_count] = std::move(message_buffer_[step % message_buffer_.size()]);
+    }
+    message_buffer_ = std::move(new_buffer);
+}
+
+
+void OutputChannel::set_max_buffered_steps(size_t max_buffered_steps)
+{
+    max_buffered_steps_ = max_buffered_steps;
+    if (!max_buffered_steps_) return;
+    if (steps_count_ > max_buffered_steps_) discard_oldest_steps(steps_count_ - max_buffered_steps_);
+    if (message_buffer_.size() > max_buffered_steps_) resize_buffer(max_buffered_steps_);
 }
 
 
@@ -55,14 +144,26 @@ std::vector<core::messaging::SpikeMessage> OutputChannel::read_some_from_buffer(
     core::Step starting_step, core::Step final_step)
 {
     std::vector<core::messaging::SpikeMessage> result;
+    if (!steps_count_ || final_step < first_step_ || starting_step > final_step) return result;
 
-    result.reserve(starting_step + final_step + 1);
-    // Here we assume that buffer is sorted.
-    auto begin_iter = std::lower_bound(message_buffer_.begin(), message_buffer_.end(), starting_step, comp_lower);
-    auto end_iter = std::upper_bound(message_buffer_.begin(), message_buffer_.end(), final_step, comp_upper);
+    const core::Step last_step = std::min(final_step, first_step_ + steps_count_ - 1);
+    for (core::Step step = std::max(starting_step, first_step_); step <= last_step; ++step)
+    {
+        auto &slot = message_buffer_[step % message_buffer_.size()];
+        std::move(slot.begin(), slot.end(), std::back_inserter(result));
+        slot.clear();
+    }
 
-    std::move(begin_iter, end_iter, std::back_inserter(result));
-    message_buffer_.erase(begin_iter, end_iter);
+    // Shrink the buffered interval, so that empty steps don't take space in a limited buffer.
+    while (steps_count_ && message_buffer_[first_step_ % message_buffer_.size()].empty())
+    {
+        ++first_step_;
+        --steps_count_;
+    }
+    while (steps_count_ && message_buffer_[(first_step_ + steps_count_ - 1) % message_buffer_.size()].empty())
+    {
+        --steps_count_;
+    }
     return result;
 }
 
@@ -21,10 +21,11 @@
 
 #include "load_network.h"
 
+#include <knp/core/all_projections.h>
 #include <knp/core/population.h>
-#include <knp/core/projection.h>
 #include <knp/core/uid.h>
 #include <knp/framework/network.h>
+#include <knp/framework/sonata/network_io.h>
 
 #include <spdlog/spdlog.h>
 
@@ -35,6 +36,7 @@
 
 #include <boost/format.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/mp11.hpp>
 #include <boost/uuid/uuid.hpp>
 
 #include "highfive.h"
@@ -60,7 +62,85 @@ std::vector<std::string> get_projection_names(const HighFive::File &file)
 }
 
 
-std::vector<core::AllProjectionsVariant> load_projections(const fs::path &proj_h5_file)
+// Read edge type of the first projection synapse without reading the whole dataset.
+int read_projection_type(const HighFive::Group &edges_group, const std::string &projection_name)
+{
+    const auto type_dataset = edges_group.getGroup(projection_name).getDataSet("edge_type_id");
+    if (!type_dataset.getElementCount())
+        throw std::runtime_error("Projection \"" + projection_name + "\" has no synapses, its type is unknown.");
+    return type_dataset.select({0}, {1}).read<std::vector<int>>()[0];
+}
+
+
+// Load a projection that stores synapses in other ways than `Projection`, if the projection was saved as one.
+bool try_load_inference_projection(
+    const HighFive::Group &edges_group, const std::string &projection_name,
+    std::vector<core::AllProjectionsVariant> &projections)
+{
+    const auto projection_group = edges_group.getGroup(projection_name);
+    if (!projection_group.hasAttribute("projection_type")) return false;
+    const auto type_name = projection_group.getAttribute("projection_type").read<std::string>();
+
+    bool is_loaded = false;
+    boost::mp11::mp_for_each<boost::mp11::mp_transform<boost::mp11::mp_identity, core::InferenceProjections>>(
+        [&](auto type_identity)
+        {
+            using ProjectionType = typename decltype(type_identity)::type;
+            if (is_loaded || type_name != get_projection_type_name<ProjectionType>()) return;
+            projections.emplace_back(load_inference_projection<ProjectionType>(edges_group, projection_name));
+            is_loaded = true;
+        });
+    if (!is_loaded) SPDLOG_WARN("Unknown type \"{}\" of projection {}, edges are loaded.", type_name, projection_name);
+    return is_loaded;
+}
+
+
+template <class Synapse>
+core::Projection<Synapse> make_lazy_projection(
+    const HighFive::Group &edges_group, const std::string &projection_name, const fs::path &proj_h5_file)
+{
+    SPDLOG_DEBUG("Deferring edges loading for projection {}...", projection_name);
+    const auto projection_group = edges_group.getGroup(projection_name);
+    const core::UID uid_from{boost::lexical_cast<boost::uuids::uuid>(
+        projection_group.getDataSet("source_node_id").getAttribute("node_population").read<std::string>())};
+    const core::UID uid_to{boost::lexical_cast<boost::uuids::uuid>(
+        projection_group.getDataSet("target_node_id").getAttribute("node_population").read<std::string>())};
+    const core::UID uid_own{boost::lexical_cast<boost::uuids::uuid>(projection_name)};
+
+    core::Projection<Synapse> projection(uid_own, uid_from, uid_to);
+    if (projection_group.hasAttribute("is_locked") && !projection_group.getAttribute("is_locked").read<bool>())
+        projection.unlock_weights();
+    load_shared_parameters(projection_group, projection);
+
+    projection.set_synapse_loader(
+        [proj_h5_file, projection_name](core::Projection<Synapse> &target)
+        {
+            const HighFive::File storage{proj_h5_file.string()};
+            auto loaded = load_projection<Synapse>(storage.getGroup("edges"), projection_name);
+            // Keep projection state that could be changed after the network was loaded.
+            loaded.get_tags() = std::move(target.get_tags());
+            loaded.get_shared_parameters() = target.get_shared_parameters();
+            if (target.is_locked())
+                loaded.lock_weights();
+            else
+                loaded.unlock_weights();
+            target = std::move(loaded);
+        });
+    return projection;
+}
+
+
+template <class Synapse>
+core::Projection<Synapse> load_or_defer_projection(
+    const HighFive::Group &edges_group, const std::string &projection_name, const fs::path &proj_h5_file,
+    const LoadOptions &options)
+{
+    if (options.lazy_projections_) return make_lazy_projection<Synapse>(edges_group, projection_name, proj_h5_file);
+    return load_projection<Synapse>(edges_group, projection_name);
+}
+
+
+std::vector<core::AllProjectionsVariant> load_projections(const fs::path &proj_h5_file, const LoadOptions &options)
 {
     if (!fs::is_regular_file(proj_h5_file))
         throw std::runtime_error("Could not open file \"" + proj_h5_file.string() + "\".");
@@ -72,13 +152,16 @@ std::vector<core::AllProjectionsVariant> load_projections(const fs::path &proj_h
     for (size_t i = 0; i < num_projections; ++i)
     {
         std::string proj_name = group.getObjectName(i);
-        int proj_type =
-            group.getGroup(proj_name).getDataSet("edge_type_id").read<std::vector<int>>()[0];  // One type only.
+        // Inference projections don't support deferred synapse loading.
+        if (try_load_inference_projection(group, proj_name, result)) continue;
+        int proj_type = read_projection_type(group, proj_name);  // One type only.
         // TODO: Check if type is in type_file.
         if (proj_type == get_synapse_type_id<synapse_traits::DeltaSynapse>())
-            result.emplace_back(load_projection<synapse_traits::DeltaSynapse>(group, proj_name));
+            result.emplace_back(
+                load_or_defer_projection<synapse_traits::DeltaSynapse>(group, proj_name, proj_h5_file, options));
         else if (proj_type == get_synapse_type_id<synapse_traits::SynapticResourceSTDPDeltaSynapse>())
-            result.emplace_back(load_projection<synapse_traits::SynapticResourceSTDPDeltaSynapse>(group, proj_name));
+            result.emplace_back(load_or_defer_projection<synapse_traits::SynapticResourceSTDPDeltaSynapse>(
+                group, proj_name, proj_h5_file, options));
         // TODO: Add other supported types or better use a template.
     }
     return result;
@@ -148,6 +231,12 @@ core::UID get_network_uid(const fs::path &nodes_path)
 
 
 KNP_DECLSPEC Network load_network(const fs::path &config_path)
+{
+    return load_network(config_path, LoadOptions{});
+}
+
+
+KNP_DECLSPEC Network load_network(const fs::path &config_path, const LoadOptions &options)
 {
     // TODO: Get this value from config file at config_path.
     const std::string config_path_suffix = "network/network_config.json";
@@ -155,7 +244,7 @@ KNP_DECLSPEC Network load_network(const fs::path &config_path)
     auto config = read_config_file(config_path / config_path_suffix);
     Network network{get_network_uid(config.nodes_storage)};
     auto populations = load_populations(config.nodes_storage);
-    auto projections = load_projections(config.edges_storage);
+    auto projections = load_projections(config.edges_storage, options);
     for (auto &pop : populations)
     {
         std::visit([&network](auto &population) { network.add_population(population); }, pop);
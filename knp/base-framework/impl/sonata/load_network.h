@@ -21,13 +21,18 @@
 
 #pragma once
 
+#include <knp/core/all_projections.h>
 #include <knp/core/population.h>
-#include <knp/core/projection.h>
+
+#include <spdlog/spdlog.h>
 
 #include <algorithm>
+#include <array>
 #include <filesystem>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "highfive.h"
@@ -43,6 +48,85 @@ core::Population<Neuron> load_population(const HighFive::Group &nodes_group, con
 template <class Synapse>
 core::Projection<Synapse> load_projection(const HighFive::Group &edges_group, const std::string &projection_name);
 
+/**
+ * @brief Load a projection that stores synapses in other ways than `Projection`.
+ * @tparam ProjectionType projection type from `core::InferenceProjections`.
+ * @param edges_group group of all projections.
+ * @param projection_name projection group name.
+ * @return projection.
+ */
+template <class ProjectionType>
+ProjectionType load_inference_projection(const HighFive::Group &edges_group, const std::string &projection_name);
+
+
+/**
+ * @brief Load parameters shared between projection synapses from projection group attributes.
+ * @details By default projections have no shared parameters saved in SONATA files.
+ * @tparam Synapse synapse type.
+ */
+template <class Synapse>
+void load_shared_parameters(const HighFive::Group &, core::Projection<Synapse> &)
+{
+}
+
+
+template <>
+void load_shared_parameters(
+    const HighFive::Group &projection_group, core::Projection<synapse_traits::DeltaSynapse> &projection);
+
+
+/**
+ * @brief Make a projection from loaded synapses and SONATA edge indexes of the projection group.
+ * @details If the projection group contains `indices/source_to_target` and `indices/target_to_source` groups, the
+ * projection searches synapses by these indexes and doesn't build its hashed index. Otherwise the hashed index is
+ * built from synapses.
+ * @tparam Synapse synapse type.
+ * @param projection_group projection group.
+ * @param uid projection UID.
+ * @param presynaptic_uid presynaptic population UID.
+ * @param postsynaptic_uid postsynaptic population UID.
+ * @param synapses loaded synapses in the file order.
+ * @return projection.
+ */
+template <class Synapse>
+core::Projection<Synapse> make_indexed_projection(
+    const HighFive::Group &projection_group, const core::UID &uid, const core::UID &presynaptic_uid,
+    const core::UID &postsynaptic_uid, std::vector<typename core::Projection<Synapse>::Synapse> &&synapses)
+{
+    using EdgeIndex = typename core::Projection<Synapse>::EdgeIndex;
+    using Ranges = std::vector<std::array<size_t, 2>>;
+
+    auto read_edge_index = [&projection_group](const std::string &name) -> std::optional<EdgeIndex>
+    {
+        if (!projection_group.exist("indices") || !projection_group.getGroup("indices").exist(name))
+            return std::nullopt;
+        const auto index_group = projection_group.getGroup("indices").getGroup(name);
+        return EdgeIndex{
+            index_group.getDataSet("node_id_to_ranges").read<Ranges>(),
+            index_group.getDataSet("range_to_edge_id").read<Ranges>()};
+    };
+
+    std::optional<EdgeIndex> presynaptic_index;
+    std::optional<EdgeIndex> postsynaptic_index;
+    try
+    {
+        presynaptic_index = read_edge_index("source_to_target");
+        postsynaptic_index = read_edge_index("target_to_source");
+    }
+    catch (const std::exception &exc)
+    {
+        SPDLOG_WARN("Could not read edge indexes of projection {}: {}.", std::string(uid), exc.what());
+        presynaptic_index.reset();
+    }
+
+    if (!presynaptic_index || !postsynaptic_index)
+        return core::Projection<Synapse>(uid, presynaptic_uid, postsynaptic_uid, std::move(synapses));
+    return core::Projection<Synapse>(
+        uid, presynaptic_uid, postsynaptic_uid, std::move(synapses), std::move(*presynaptic_index),
+        std::move(*postsynaptic_index));
+}
+
+
 }  // namespace knp::framework::sonata
 
 
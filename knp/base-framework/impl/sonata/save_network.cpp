@@ -24,6 +24,8 @@
 #include <knp/core/population.h>
 #include <knp/core/projection.h>
 #include <knp/framework/network.h>
+#include <knp/framework/sonata/network_io.h>
+#include <knp/meta/specialization_helpers.h>
 #include <knp/neuron-traits/blifat.h>
 #include <knp/synapse-traits/delta.h>
 
@@ -144,6 +146,12 @@ void write_network_config(
 
 
 KNP_DECLSPEC void save_network(const Network &network, const fs::path &dir)
+{
+    save_network(network, dir, SaveOptions{});
+}
+
+
+KNP_DECLSPEC void save_network(const Network &network, const fs::path &dir, const SaveOptions &options)
 {
     auto net_dir = dir / "network";
     if (!is_directory(net_dir)) fs::create_directory(net_dir);
@@ -161,7 +169,25 @@ KNP_DECLSPEC void save_network(const Network &network, const fs::path &dir)
 
     for (auto iter = network.begin_projections(); iter != network.end_projections(); ++iter)
     {
-        std::visit([&h5_proj_file](const auto &projection) { add_projection_to_h5(h5_proj_file, projection); }, *iter);
+        std::visit(
+            [&h5_proj_file, &options](const auto &projection)
+            {
+                using T = std::decay_t<decltype(projection)>;
+                // Inference projections don't support deferred synapse loading.
+                if constexpr (knp::meta::is_specialization<T, core::Projection>::value)
+                {
+                    if (!projection.is_loaded())
+                    {
+                        // Deferred projection: only one projection is loaded into memory at a time.
+                        auto loaded_projection = projection;
+                        loaded_projection.load_synapses();
+                        add_projection_to_h5(h5_proj_file, loaded_projection, options);
+                        return;
+                    }
+                }
+                add_projection_to_h5(h5_proj_file, projection, options);
+            },
+            *iter);
         std::visit(
             [&path_to_synapse_csv](const auto &projection) {
                 add_synapse_type_to_csv<typename std::decay_t<decltype(projection)>::ProjectionSynapseType>(
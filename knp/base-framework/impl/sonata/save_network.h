@@ -23,9 +23,15 @@
 
 #include <knp/core/population.h>
 #include <knp/core/projection.h>
+#include <knp/framework/sonata/network_io.h>
+
+#include <spdlog/spdlog.h>
 
 #include <algorithm>
+#include <array>
 #include <filesystem>
+#include <future>
+#include <numeric>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -38,7 +44,7 @@ namespace knp::framework::sonata
 namespace fs = std::filesystem;
 
 template <class Projection>
-void add_projection_to_h5(HighFive::File &, const Projection &);
+void add_projection_to_h5(HighFive::File &, const Projection &, const SaveOptions &);
 
 
 template <class Population>
@@ -63,6 +69,164 @@ std::vector<Attr> read_parameter(
     return result;
 }
 
+
+/**
+ * @brief HDF5 dataset creation property that sets a fill value.
+ * @details Chunks that were never written are not allocated in the file, reading them returns the fill value.
+ * @tparam T dataset element type.
+ */
+template <class T>
+class FillValue
+{
+public:
+    explicit FillValue(const T &value) : value_(value) {}
+
+    // Called by `HighFive::PropertyList::add()`.
+    void apply(hid_t hid) const
+    {
+        if (H5Pset_fill_value(hid, HighFive::create_datatype<T>().getId(), &value_) < 0)
+            throw std::runtime_error("Could not set dataset fill value.");
+    }
+
+private:
+    T value_;
+};
+
+
+// Make dataset creation properties: chunking and filters.
+inline HighFive::DataSetCreateProps make_dataset_properties(
+    const SaveOptions &options, size_t dataset_size, bool force_chunking = false, size_t row_size = 1)
+{
+    HighFive::DataSetCreateProps props;
+    bool use_deflate = options.compression_level_ > 0;
+    if (use_deflate && H5Zfilter_avail(H5Z_FILTER_DEFLATE) <= 0)
+    {
+        SPDLOG_WARN("HDF5 library was built without the deflate filter, datasets will not be compressed.");
+        use_deflate = false;
+    }
+    const bool use_filters = use_deflate || options.shuffle_;
+    // HDF5 doesn't allow chunks larger than a fixed-size dataset, so empty datasets stay contiguous.
+    if (!dataset_size || !(options.chunk_size_ || use_filters || force_chunking)) return props;
+
+    const size_t chunk_size = options.chunk_size_ ? options.chunk_size_ : SaveOptions::default_chunk_size;
+    std::vector<hsize_t> chunk_dims{std::min(chunk_size, dataset_size)};
+    if (row_size > 1) chunk_dims.push_back(row_size);
+    props.add(HighFive::Chunking(chunk_dims));
+    if (options.shuffle_) props.add(HighFive::Shuffle());
+    if (use_deflate) props.add(HighFive::Deflate(std::min(options.compression_level_, 9U)));
+    return props;
+}
+
+
+// Write a column of values to a new dataset.
+template <class T>
+HighFive::DataSet write_dataset(
+    HighFive::Group &group, const std::string &name, const std::vector<T> &data, const SaveOptions &options)
+{
+    return group.createDataSet(name, data, make_dataset_properties(options, data.size()));
+}
+
+
+// Write a dataset that contains the same value for all elements.
+template <class T>
+HighFive::DataSet write_constant_dataset(
+    HighFive::Group &group, const std::string &name, size_t dataset_size, const T &value, const SaveOptions &options)
+{
+    if (!options.compact_constant_datasets_ || !dataset_size)
+    {
+        return write_dataset(group, name, std::vector<T>(dataset_size, value), options);
+    }
+
+    auto props = make_dataset_properties(options, dataset_size, true);
+    props.add(FillValue<T>(value));
+    // Nothing is written: all chunks remain unallocated and are read as the fill value.
+    return group.createDataSet<T>(name, HighFive::DataSpace({dataset_size}), props);
+}
+
+
+// Write a SONATA index group: edge ranges grouped by node.
+inline void write_edge_index(
+    HighFive::Group &index_group, const std::vector<uint64_t> &node_ids, const SaveOptions &options)
+{
+    const size_t num_nodes = node_ids.empty() ? 0 : *std::max_element(node_ids.begin(), node_ids.end()) + 1;
+
+    // Counting sort keeps edges of the same node in the file order.
+    std::vector<size_t> node_offsets(num_nodes + 1, 0);
+    for (const auto node_id : node_ids) ++node_offsets[node_id + 1];
+    std::partial_sum(node_offsets.begin(), node_offsets.end(), node_offsets.begin());
+    std::vector<size_t> edge_ids(node_ids.size());
+    {
+        auto positions = node_offsets;
+        for (size_t edge_id = 0; edge_id < node_ids.size(); ++edge_id)
+            edge_ids[positions[node_ids[edge_id]]++] = edge_id;
+    }
+
+    std::vector<std::array<size_t, 2>> node_id_to_ranges(num_nodes, {0, 0});
+    std::vector<std::array<size_t, 2>> range_to_edge_id;
+    for (size_t node_id = 0; node_id < num_nodes; ++node_id)
+    {
+        const size_t first_range = range_to_edge_id.size();
+        for (size_t i = node_offsets[node_id]; i < node_offsets[node_id + 1]; ++i)
+        {
+            // Consecutive edges are merged into a single range.
+            if (range_to_edge_id.size() > first_range && range_to_edge_id.back()[1] == edge_ids[i])
+                ++range_to_edge_id.back()[1];
+            else
+                range_to_edge_id.push_back({edge_ids[i], edge_ids[i] + 1});
+        }
+        node_id_to_ranges[node_id] = {first_range, range_to_edge_id.size()};
+    }
+
+    index_group.createDataSet(
+        "node_id_to_ranges", node_id_to_ranges, make_dataset_properties(options, node_id_to_ranges.size(), false, 2));
+    index_group.createDataSet(
+        "range_to_edge_id", range_to_edge_id, make_dataset_properties(options, range_to_edge_id.size(), false, 2));
+}
+
+
+/**
+ * @brief Write SONATA `indices` group that maps source and target node IDs to projection synapses.
+ * @param proj_group projection group.
+ * @param source_ids presynaptic neuron indexes.
+ * @param target_ids postsynaptic neuron indexes.
+ * @param options save options.
+ */
+inline void write_edge_indices(
+    HighFive::Group &proj_group, const std::vector<uint64_t> &source_ids, const std::vector<uint64_t> &target_ids,
+    const SaveOptions &options)
+{
+    HighFive::Group indices_group = proj_group.createGroup("indices");
+    HighFive::Group source_to_target = indices_group.createGroup("source_to_target");
+    write_edge_index(source_to_target, source_ids, options);
+    HighFive::Group target_to_source = indices_group.createGroup("target_to_source");
+    write_edge_index(target_to_source, target_ids, options);
+}
+
+
+/**
+ * @brief Extract a column of values from entity elements.
+ * @details The column is extracted in a separate thread if parallel saving is enabled, otherwise it is extracted
+ * on the first `get()` call, so that only one column exists in memory at a time.
+ * @tparam Value column value type.
+ * @param entity projection or population.
+ * @param getter functor that receives an entity element and returns column value.
+ * @param options save options.
+ * @return future column.
+ */
+template <class Value, class Entity, class Getter>
+std::future<std::vector<Value>> extract_column(const Entity &entity, Getter getter, const SaveOptions &options)
+{
+    return std::async(
+        options.parallel_ ? std::launch::async : std::launch::deferred,
+        [&entity, getter]()
+        {
+            std::vector<Value> result;
+            result.reserve(entity.size());
+            std::transform(entity.begin(), entity.end(), std::back_inserter(result), getter);
+            return result;
+        });
+}
+
 }  // namespace knp::framework::sonata
 
 
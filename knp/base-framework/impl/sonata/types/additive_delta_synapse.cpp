@@ -52,7 +52,8 @@ std::string get_synapse_type_name<AdditiveDeltaSynapse>()
 template <>
 void add_projection_to_h5<core::Projection<AdditiveDeltaSynapse>>(
     // cppcheck-suppress constParameterReference
-    HighFive::File &file_h5, const knp::core::Projection<AdditiveDeltaSynapse> &projection)
+    HighFive::File &file_h5, const knp::core::Projection<AdditiveDeltaSynapse> &projection,
+    const SaveOptions &options)
 {
     throw std::runtime_error("AdditiveDeltaSynapse saving unimplemented.");
 }
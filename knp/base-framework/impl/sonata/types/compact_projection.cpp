@@ -0,0 +1,73 @@
+/**
+ * @file compact_projection.cpp
+ * @brief Functions for loading and saving compact projections.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/core/compact_projection.h>
+#include <knp/synapse-traits/delta.h>
+
+#include <spdlog/spdlog.h>
+
+#include <string>
+
+#include "../highfive.h"
+#include "../load_network.h"
+#include "../save_network.h"
+#include "type_id_defines.h"
+
+
+namespace knp::framework::sonata
+{
+
+template <>
+std::string get_projection_type_name<core::CompactProjection<synapse_traits::DeltaSynapse>>()
+{
+    return "knp:CompactProjection";
+}
+
+
+template <>
+core::CompactProjection<synapse_traits::DeltaSynapse> load_inference_projection(
+    const HighFive::Group &edges_group, const std::string &projection_name)
+{
+    SPDLOG_DEBUG("Loading compact projection {}...", projection_name);
+    const auto projection_group = edges_group.getGroup(projection_name);
+    const auto weight_format =
+        static_cast<core::WeightFormat>(projection_group.getAttribute("weight_format").read<int>());
+    // Saved weights are already rounded to the weight format, so packing them again doesn't change them.
+    return core::CompactProjection<synapse_traits::DeltaSynapse>(
+        load_projection<synapse_traits::DeltaSynapse>(edges_group, projection_name), weight_format);
+}
+
+
+template <>
+void add_projection_to_h5<core::CompactProjection<synapse_traits::DeltaSynapse>>(
+    HighFive::File &file_h5, const core::CompactProjection<synapse_traits::DeltaSynapse> &projection,
+    const SaveOptions &options)
+{
+    // Unpacked synapses are saved as delta synapses, so that other SONATA readers can load them.
+    add_projection_to_h5(file_h5, projection.unpack(), options);
+
+    auto proj_group = file_h5.getGroup("edges/" + std::string(projection.get_uid()));
+    proj_group.createAttribute(
+        "projection_type", get_projection_type_name<core::CompactProjection<synapse_traits::DeltaSynapse>>());
+    proj_group.createAttribute("weight_format", static_cast<int>(projection.get_weight_format()));
+}
+
+}  // namespace knp::framework::sonata
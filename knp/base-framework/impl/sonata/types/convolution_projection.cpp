@@ -0,0 +1,114 @@
+/**
+ * @file convolution_projection.cpp
+ * @brief Functions for loading and saving convolution projections.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/core/convolution_projection.h>
+#include <knp/synapse-traits/delta.h>
+
+#include <spdlog/spdlog.h>
+
+#include <string>
+#include <vector>
+
+#include <boost/lexical_cast.hpp>
+#include <boost/uuid/uuid.hpp>
+
+#include "../highfive.h"
+#include "../load_network.h"
+#include "../save_network.h"
+#include "type_id_defines.h"
+
+
+namespace knp::framework::sonata
+{
+
+template <>
+std::string get_projection_type_name<core::ConvolutionProjection<synapse_traits::DeltaSynapse>>()
+{
+    return "knp:ConvolutionProjection";
+}
+
+
+template <>
+core::ConvolutionProjection<synapse_traits::DeltaSynapse> load_inference_projection(
+    const HighFive::Group &edges_group, const std::string &projection_name)
+{
+    SPDLOG_DEBUG("Loading convolution projection {}...", projection_name);
+    const auto projection_group = edges_group.getGroup(projection_name);
+    // Synapses are made from the kernel weights, saved edges are not read.
+    auto read_size = [&projection_group](const std::string &name)
+    { return static_cast<size_t>(projection_group.getAttribute(name).read<uint64_t>()); };
+
+    core::ConvolutionGeometry geometry;
+    geometry.input_channels_ = read_size("input_channels");
+    geometry.input_height_ = read_size("input_height");
+    geometry.input_width_ = read_size("input_width");
+    geometry.output_channels_ = read_size("output_channels");
+    geometry.kernel_height_ = read_size("kernel_height");
+    geometry.kernel_width_ = read_size("kernel_width");
+    geometry.stride_y_ = read_size("stride_y");
+    geometry.stride_x_ = read_size("stride_x");
+    geometry.padding_y_ = read_size("padding_y");
+    geometry.padding_x_ = read_size("padding_x");
+
+    const core::UID uid_from{boost::lexical_cast<boost::uuids::uuid>(
+        projection_group.getDataSet("source_node_id").getAttribute("node_population").read<std::string>())};
+    const core::UID uid_to{boost::lexical_cast<boost::uuids::uuid>(
+        projection_group.getDataSet("target_node_id").getAttribute("node_population").read<std::string>())};
+    const core::UID uid_own{boost::lexical_cast<boost::uuids::uuid>(projection_name)};
+
+    return core::ConvolutionProjection<synapse_traits::DeltaSynapse>(
+        uid_own, uid_from, uid_to, geometry, projection_group.getDataSet("kernel_weights").read<std::vector<float>>(),
+        projection_group.getAttribute("delay").read<uint32_t>(),
+        static_cast<synapse_traits::OutputType>(projection_group.getAttribute("output_type").read<int>()));
+}
+
+
+template <>
+void add_projection_to_h5<core::ConvolutionProjection<synapse_traits::DeltaSynapse>>(
+    HighFive::File &file_h5, const core::ConvolutionProjection<synapse_traits::DeltaSynapse> &projection,
+    const SaveOptions &options)
+{
+    // All synapses are saved as delta synapses, so that other SONATA readers can load them.
+    add_projection_to_h5(file_h5, projection.materialize(), options);
+
+    auto proj_group = file_h5.getGroup("edges/" + std::string(projection.get_uid()));
+    auto write_size = [&proj_group](const std::string &name, size_t value)
+    { proj_group.createAttribute(name, static_cast<uint64_t>(value)); };
+
+    const auto &geometry = projection.get_geometry();
+    proj_group.createAttribute(
+        "projection_type", get_projection_type_name<core::ConvolutionProjection<synapse_traits::DeltaSynapse>>());
+    write_size("input_channels", geometry.input_channels_);
+    write_size("input_height", geometry.input_height_);
+    write_size("input_width", geometry.input_width_);
+    write_size("output_channels", geometry.output_channels_);
+    write_size("kernel_height", geometry.kernel_height_);
+    write_size("kernel_width", geometry.kernel_width_);
+    write_size("stride_y", geometry.stride_y_);
+    write_size("stride_x", geometry.stride_x_);
+    write_size("padding_y", geometry.padding_y_);
+    write_size("padding_x", geometry.padding_x_);
+    proj_group.createAttribute("delay", projection.get_delay());
+    proj_group.createAttribute("output_type", static_cast<int>(projection.get_output_type()));
+    proj_group.createDataSet("kernel_weights", projection.get_weights());
+}
+
+}  // namespace knp::framework::sonata
@@ -25,6 +25,7 @@
 #include <spdlog/spdlog.h>
 
 #include <filesystem>
+#include <numeric>
 
 #include <boost/lexical_cast.hpp>
 #include <boost/uuid/uuid.hpp>
@@ -46,6 +47,23 @@ std::string get_synapse_type_name<synapse_traits::DeltaSynapse>()
 }
 
 
+template <>
+void load_shared_parameters(
+    const HighFive::Group &projection_group, core::Projection<synapse_traits::DeltaSynapse> &projection)
+{
+    auto &uniform_params = projection.get_shared_parameters().synapses_parameters_;
+    if (projection_group.hasAttribute("uniform_weight"))
+        uniform_params.weight_ = projection_group.getAttribute("uniform_weight").read<float>();
+    if (projection_group.hasAttribute("uniform_delay"))
+        uniform_params.delay_ = projection_group.getAttribute("uniform_delay").read<uint32_t>();
+    if (projection_group.hasAttribute("uniform_output_type"))
+    {
+        uniform_params.output_type_ =
+            static_cast<synapse_traits::OutputType>(projection_group.getAttribute("uniform_output_type").read<int>());
+    }
+}
+
+
 template <>
 core::Projection<knp::synapse_traits::DeltaSynapse> load_projection(
     const HighFive::Group &edges_group, const std::string &projection_name)
@@ -57,7 +75,6 @@ core::Projection<knp::synapse_traits::DeltaSynapse> load_projection(
     using SynapseParams = core::Projection<synapse_traits::DeltaSynapse>::SynapseParameters;
     using Synapse = core::Projection<synapse_traits::DeltaSynapse>::Synapse;
 
-    std::vector<Synapse> target(group_size);
     const auto weights = read_parameter<decltype(SynapseParams::weight_)>(
         group, "syn_weight", group_size, synapse_traits::default_values<synapse_traits::DeltaSynapse>::weight_);
     const auto delays = read_parameter<decltype(SynapseParams::delay_)>(
@@ -88,8 +105,10 @@ core::Projection<knp::synapse_traits::DeltaSynapse> load_projection(
         synapses.emplace_back(syn, id_from, id_to);
     }
 
-    core::Projection<synapse_traits::DeltaSynapse> proj(
-        uid_own, uid_from, uid_to, [&synapses](size_t syn_num) { return synapses[syn_num]; }, synapses.size());
+    // Synapses are moved into the projection, so the loaded edges are not held twice.
+    auto proj = make_indexed_projection<synapse_traits::DeltaSynapse>(
+        projection_group, uid_own, uid_from, uid_to, std::move(synapses));
+    load_shared_parameters(projection_group, proj);
 
     if (projection_group.hasAttribute("is_locked"))
     {
@@ -109,55 +128,65 @@ core::Projection<knp::synapse_traits::DeltaSynapse> load_projection(
 
 template <>
 void add_projection_to_h5<core::Projection<synapse_traits::DeltaSynapse>>(
-    HighFive::File &file_h5, const knp::core::Projection<synapse_traits::DeltaSynapse> &projection)
+    HighFive::File &file_h5, const knp::core::Projection<synapse_traits::DeltaSynapse> &projection,
+    const SaveOptions &options)
 {
     using SynapseParams = synapse_traits::synapse_parameters<synapse_traits::DeltaSynapse>;
+    using Synapse = core::Projection<synapse_traits::DeltaSynapse>::Synapse;
 
     if (!file_h5.exist("edges")) throw std::runtime_error("File does not contain the \"edges\" group.");
 
-    std::vector<uint64_t> source_ids, target_ids;
-    std::vector<decltype(SynapseParams::delay_)> delays;
-    std::vector<decltype(SynapseParams::weight_)> weights;
-    std::vector<int> out_types;
-
-    source_ids.reserve(projection.size());
-    target_ids.reserve(projection.size());
-    delays.reserve(projection.size());
-    weights.reserve(projection.size());
-    out_types.reserve(projection.size());
-
-    for (const auto &v : projection)
-    {
-        source_ids.push_back(std::get<knp::core::source_neuron_id>(v));
-        target_ids.push_back(std::get<knp::core::target_neuron_id>(v));
-        delays.push_back(std::get<knp::core::synapse_data>(v).delay_);
-        weights.push_back(std::get<knp::core::synapse_data>(v).weight_);
-        out_types.push_back(static_cast<int>(std::get<knp::core::synapse_data>(v).output_type_));
-    }
+    // Uniform parameters are also saved for each synapse, so that other SONATA readers get the values in use.
+    const auto &uniform_params = projection.get_shared_parameters().synapses_parameters_;
+    // Columns are extracted lazily or in parallel, HDF5 writes are made from this thread only.
+    auto source_ids = extract_column<uint64_t>(
+        projection, [](const Synapse &v) { return std::get<knp::core::source_neuron_id>(v); }, options);
+    auto target_ids = extract_column<uint64_t>(
+        projection, [](const Synapse &v) { return std::get<knp::core::target_neuron_id>(v); }, options);
+    auto delays = extract_column<decltype(SynapseParams::delay_)>(
+        projection,
+        [&uniform_params](const Synapse &v)
+        { return uniform_params.apply(std::get<knp::core::synapse_data>(v)).delay_; },
+        options);
+    auto weights = extract_column<decltype(SynapseParams::weight_)>(
+        projection,
+        [&uniform_params](const Synapse &v)
+        { return uniform_params.apply(std::get<knp::core::synapse_data>(v)).weight_; },
+        options);
+    auto out_types = extract_column<int>(
+        projection,
+        [&uniform_params](const Synapse &v)
+        { return static_cast<int>(uniform_params.apply(std::get<knp::core::synapse_data>(v)).output_type_); },
+        options);
 
     HighFive::Group proj_group = file_h5.createGroup("edges/" + std::string(projection.get_uid()));
-    HighFive::DataSet source_node_dataset = proj_group.createDataSet("source_node_id", source_ids);
+    const auto source_column = source_ids.get();
+    HighFive::DataSet source_node_dataset = write_dataset(proj_group, "source_node_id", source_column, options);
     source_node_dataset.createAttribute("node_population", std::string(projection.get_presynaptic()));
 
-    HighFive::DataSet target_node_dataset = proj_group.createDataSet("target_node_id", target_ids);
+    const auto target_column = target_ids.get();
+    HighFive::DataSet target_node_dataset = write_dataset(proj_group, "target_node_id", target_column, options);
     target_node_dataset.createAttribute("node_population", std::string(projection.get_postsynaptic()));
+    write_edge_indices(proj_group, source_column, target_column, options);
 
     // At the moment we support only one synapse group.
-    proj_group.createDataSet("edge_group_id", std::vector(projection.size(), 0));
-    proj_group.createDataSet(
-        "edge_type_id", std::vector(projection.size(), get_synapse_type_id<synapse_traits::DeltaSynapse>()));
-
-    std::vector<uint64_t> group_index;
-    group_index.reserve(projection.size());
-    for (size_t i = 0; i < projection.size(); ++i) group_index.push_back(i);
+    write_constant_dataset(proj_group, "edge_group_id", projection.size(), 0, options);
+    write_constant_dataset(
+        proj_group, "edge_type_id", projection.size(), get_synapse_type_id<synapse_traits::DeltaSynapse>(), options);
 
-    proj_group.createDataSet("edge_group_index", group_index);
+    std::vector<uint64_t> group_index(projection.size());
+    std::iota(group_index.begin(), group_index.end(), 0);
+    write_dataset(proj_group, "edge_group_index", group_index, options);
 
     HighFive::Group syn_group = proj_group.createGroup("0");
-    syn_group.createDataSet("syn_weight", weights);
-    syn_group.createDataSet("delay", delays);
-    syn_group.createDataSet("output_type_", out_types);
+    write_dataset(syn_group, "syn_weight", weights.get(), options);
+    write_dataset(syn_group, "delay", delays.get(), options);
+    write_dataset(syn_group, "output_type_", out_types.get(), options);
     proj_group.createAttribute("is_locked", projection.is_locked());
+    if (uniform_params.weight_) proj_group.createAttribute("uniform_weight", *uniform_params.weight_);
+    if (uniform_params.delay_) proj_group.createAttribute("uniform_delay", *uniform_params.delay_);
+    if (uniform_params.output_type_)
+        proj_group.createAttribute("uniform_output_type", static_cast<int>(*uniform_params.output_type_));
 }
 
 }  // namespace knp::framework::sonata
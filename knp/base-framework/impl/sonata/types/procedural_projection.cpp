@@ -0,0 +1,102 @@
+/**
+ * @file procedural_projection.cpp
+ * @brief Functions for loading and saving procedural projections.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/core/procedural_projection.h>
+#include <knp/synapse-traits/delta.h>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../highfive.h"
+#include "../load_network.h"
+#include "../save_network.h"
+#include "type_id_defines.h"
+
+
+namespace knp::framework::sonata
+{
+
+template <>
+std::string get_projection_type_name<core::ProceduralProjection<synapse_traits::DeltaSynapse>>()
+{
+    return "knp:ProceduralProjection";
+}
+
+
+template <>
+core::ProceduralProjection<synapse_traits::DeltaSynapse> load_inference_projection(
+    const HighFive::Group &edges_group, const std::string &projection_name)
+{
+    using ProjectionType = core::ProceduralProjection<synapse_traits::DeltaSynapse>;
+    using Synapse = ProjectionType::Synapse;
+
+    SPDLOG_DEBUG("Loading procedural projection {}...", projection_name);
+    const auto projection_group = edges_group.getGroup(projection_name);
+    const auto presynaptic_size = projection_group.getAttribute("presynaptic_size").read<uint64_t>();
+    const auto seed = projection_group.getAttribute("seed").read<uint64_t>();
+    const auto stored_projection = load_projection<synapse_traits::DeltaSynapse>(edges_group, projection_name);
+
+    // The saved rule is a function that can't be stored, so the loaded rule generates the saved synapses.
+    auto synapses = std::make_shared<std::vector<Synapse>>(stored_projection.begin(), stored_projection.end());
+    std::stable_sort(
+        synapses->begin(), synapses->end(), [](const Synapse &first, const Synapse &second)
+        { return std::get<core::source_neuron_id>(first) < std::get<core::source_neuron_id>(second); });
+
+    auto rule = [synapses = std::shared_ptr<const std::vector<Synapse>>(std::move(synapses))](
+                    size_t neuron_index, core::Philox4x32 &, std::vector<Synapse> &neuron_synapses)
+    {
+        const auto first = std::lower_bound(
+            synapses->begin(), synapses->end(), neuron_index,
+            [](const Synapse &synapse, size_t index) { return std::get<core::source_neuron_id>(synapse) < index; });
+        const auto last = std::upper_bound(
+            first, synapses->end(), neuron_index,
+            [](size_t index, const Synapse &synapse) { return index < std::get<core::source_neuron_id>(synapse); });
+        neuron_synapses.insert(neuron_synapses.end(), first, last);
+    };
+
+    ProjectionType projection(
+        stored_projection.get_uid(), stored_projection.get_presynaptic(), stored_projection.get_postsynaptic(),
+        presynaptic_size, std::move(rule), seed);
+    projection.get_shared_parameters() = stored_projection.get_shared_parameters();
+    return projection;
+}
+
+
+template <>
+void add_projection_to_h5<core::ProceduralProjection<synapse_traits::DeltaSynapse>>(
+    HighFive::File &file_h5, const core::ProceduralProjection<synapse_traits::DeltaSynapse> &projection,
+    const SaveOptions &options)
+{
+    // Generated synapses are saved as delta synapses, so that other SONATA readers can load them.
+    add_projection_to_h5(file_h5, projection.materialize(), options);
+
+    auto proj_group = file_h5.getGroup("edges/" + std::string(projection.get_uid()));
+    proj_group.createAttribute(
+        "projection_type", get_projection_type_name<core::ProceduralProjection<synapse_traits::DeltaSynapse>>());
+    proj_group.createAttribute("presynaptic_size", static_cast<uint64_t>(projection.get_presynaptic_size()));
+    proj_group.createAttribute("seed", projection.get_seed());
+}
+
+}  // namespace knp::framework::sonata
@@ -24,6 +24,7 @@
 #include <knp/synapse-traits/stdp_synaptic_resource_rule.h>
 
 #include <filesystem>
+#include <numeric>
 
 #include <boost/format.hpp>
 #include <boost/lexical_cast.hpp>
@@ -49,15 +50,13 @@ std::string get_synapse_type_name<ResourceDeltaSynapse>()
 }
 
 
-#define PUT_SYNAPSE_RULE_TO_DATASET(proj, param, group)                            \
-    {                                                                              \
-        std::vector<decltype(std::get<0>(*proj.begin()).rule_.param)> data;        \
-        data.reserve(proj.size());                                                 \
-        std::transform(                                                            \
-            proj.begin(), proj.end(), std::back_inserter(data),                    \
-            [](const auto &synapse) { return std::get<0>(synapse).rule_.param; }); \
-        group.createDataSet(std::string("rule_") + #param, data);                  \
-    }                                                                              \
+#define PUT_SYNAPSE_RULE_TO_DATASET(proj, param, group, options)                                  \
+    {                                                                                             \
+        using ValueType = decltype(std::get<0>(*proj.begin()).rule_.param);                       \
+        auto data = extract_column<ValueType>(                                                    \
+            proj, [](const auto &synapse) { return std::get<0>(synapse).rule_.param; }, options); \
+        write_dataset(group, std::string("rule_") + #param, data.get(), options);                 \
+    }                                                                                             \
     static_assert(true, "")
 
 
@@ -71,64 +70,59 @@ std::string get_synapse_type_name<ResourceDeltaSynapse>()
 
 template <>
 void add_projection_to_h5<core::Projection<ResourceDeltaSynapse>>(
-    HighFive::File &file_h5, const knp::core::Projection<ResourceDeltaSynapse> &projection)
+    HighFive::File &file_h5, const knp::core::Projection<ResourceDeltaSynapse> &projection, const SaveOptions &options)
 {
+    using Synapse = core::Projection<ResourceDeltaSynapse>::Synapse;
+
     if (!file_h5.exist("edges"))
     {
         throw std::runtime_error("File does not contain the \"edges\" group.");
     }
 
-    std::vector<uint64_t> source_ids, target_ids;
-    std::vector<decltype(synapse_traits::synapse_parameters<ResourceDeltaSynapse>::delay_)> delays;
-    std::vector<decltype(synapse_traits::synapse_parameters<ResourceDeltaSynapse>::weight_)> weights;
-    std::vector<int> out_types;
-    source_ids.reserve(projection.size());
-    target_ids.reserve(projection.size());
-    delays.reserve(projection.size());
-    weights.reserve(projection.size());
-    out_types.reserve(projection.size());
-
-    for (const auto &v : projection)
-    {
-        const auto &params = std::get<knp::core::synapse_data>(v);
-        source_ids.push_back(std::get<knp::core::source_neuron_id>(v));
-        target_ids.push_back(std::get<knp::core::target_neuron_id>(v));
-        delays.push_back(params.delay_);
-        weights.push_back(params.weight_);
-        out_types.push_back(static_cast<int>(std::get<knp::core::synapse_data>(v).output_type_));
-    }
+    auto source_ids = extract_column<uint64_t>(
+        projection, [](const Synapse &v) { return std::get<knp::core::source_neuron_id>(v); }, options);
+    auto target_ids = extract_column<uint64_t>(
+        projection, [](const Synapse &v) { return std::get<knp::core::target_neuron_id>(v); }, options);
+    auto delays = extract_column<decltype(synapse_traits::synapse_parameters<ResourceDeltaSynapse>::delay_)>(
+        projection, [](const Synapse &v) { return std::get<knp::core::synapse_data>(v).delay_; }, options);
+    auto weights = extract_column<decltype(synapse_traits::synapse_parameters<ResourceDeltaSynapse>::weight_)>(
+        projection, [](const Synapse &v) { return std::get<knp::core::synapse_data>(v).weight_; }, options);
+    auto out_types = extract_column<int>(
+        projection,
+        [](const Synapse &v) { return static_cast<int>(std::get<knp::core::synapse_data>(v).output_type_); }, options);
 
     HighFive::Group proj_group = file_h5.createGroup("edges/" + std::string(projection.get_uid()));
-    HighFive::DataSet source_node_dataset = proj_group.createDataSet("source_node_id", source_ids);
+    const auto source_column = source_ids.get();
+    HighFive::DataSet source_node_dataset = write_dataset(proj_group, "source_node_id", source_column, options);
     source_node_dataset.createAttribute("node_population", std::string(projection.get_presynaptic()));
 
-    HighFive::DataSet target_node_dataset = proj_group.createDataSet("target_node_id", target_ids);
+    const auto target_column = target_ids.get();
+    HighFive::DataSet target_node_dataset = write_dataset(proj_group, "target_node_id", target_column, options);
     target_node_dataset.createAttribute("node_population", std::string(projection.get_postsynaptic()));
+    write_edge_indices(proj_group, source_column, target_column, options);
 
-    proj_group.createDataSet("edge_group_id", std::vector(projection.size(), 0));
-    proj_group.createDataSet(
-        "edge_type_id", std::vector(projection.size(), get_synapse_type_id<ResourceDeltaSynapse>()));
-
-    std::vector<uint64_t> group_index;
-    group_index.reserve(projection.size());
-    for (size_t i = 0; i < projection.size(); ++i) group_index.push_back(i);
+    write_constant_dataset(proj_group, "edge_group_id", projection.size(), 0, options);
+    write_constant_dataset(
+        proj_group, "edge_type_id", projection.size(), get_synapse_type_id<ResourceDeltaSynapse>(), options);
 
-    proj_group.createDataSet("edge_group_index", group_index);
+    std::vector<uint64_t> group_index(projection.size());
+    std::iota(group_index.begin(), group_index.end(), 0);
+    write_dataset(proj_group, "edge_group_index", group_index, options);
 
     HighFive::Group syn_group = proj_group.createGroup("0");
-    PUT_SYNAPSE_RULE_TO_DATASET(projection, d_u_, syn_group);
-    PUT_SYNAPSE_RULE_TO_DATASET(projection, had_hebbian_update_, syn_group);
-    PUT_SYNAPSE_RULE_TO_DATASET(projection, has_contributed_, syn_group);
-    PUT_SYNAPSE_RULE_TO_DATASET(projection, synaptic_resource_, syn_group);
-    PUT_SYNAPSE_RULE_TO_DATASET(projection, last_spike_step_, syn_group);
-    PUT_SYNAPSE_RULE_TO_DATASET(projection, dopamine_plasticity_period_, syn_group);
-    PUT_SYNAPSE_RULE_TO_DATASET(projection, w_max_, syn_group);
-    PUT_SYNAPSE_RULE_TO_DATASET(projection, w_min_, syn_group);
+    PUT_SYNAPSE_RULE_TO_DATASET(projection, d_u_, syn_group, options);
+    PUT_SYNAPSE_RULE_TO_DATASET(projection, had_hebbian_update_, syn_group, options);
+    PUT_SYNAPSE_RULE_TO_DATASET(projection, has_contributed_, syn_group, options);
+    PUT_SYNAPSE_RULE_TO_DATASET(projection, synaptic_resource_, syn_group, options);
+    PUT_SYNAPSE_RULE_TO_DATASET(projection, last_spike_step_, syn_group, options);
+    PUT_SYNAPSE_RULE_TO_DATASET(projection, dopamine_plasticity_period_, syn_group, options);
+    PUT_SYNAPSE_RULE_TO_DATASET(projection, w_max_, syn_group, options);
+    PUT_SYNAPSE_RULE_TO_DATASET(projection, w_min_, syn_group, options);
     proj_group.createAttribute("is_locked", projection.is_locked());
 
-    syn_group.createDataSet("syn_weight", weights);
-    syn_group.createDataSet("delay", delays);
-    syn_group.createDataSet("output_type_", out_types);
+    write_dataset(syn_group, "syn_weight", weights.get(), options);
+    write_dataset(syn_group, "delay", delays.get(), options);
+    write_dataset(syn_group, "output_type_", out_types.get(), options);
 }
 
 
@@ -161,7 +155,7 @@ core::Projection<ResourceDeltaSynapse> load_projection(
         projection_group.getDataSet("target_node_id").getAttribute("node_population").read<std::string>())};
     const core::UID uid_own{boost::lexical_cast<boost::uuids::uuid>(projection_name)};
 
-    std::vector<std::tuple<synapse_traits::synapse_parameters<ResourceDeltaSynapse>, size_t, size_t>> synapses;
+    std::vector<core::Projection<ResourceDeltaSynapse>::Synapse> synapses;
     synapses.reserve(group_size);
 
     for (size_t i = 0; i < weights.size(); ++i)
@@ -185,8 +179,8 @@ core::Projection<ResourceDeltaSynapse> load_projection(
     READ_SYNAPSE_RULE_PARAMETER(synapses, w_min_, group, group_size, def_params.rule_.w_min_);
 
 
-    core::Projection<ResourceDeltaSynapse> proj(
-        uid_own, uid_from, uid_to, [&synapses](size_t index) { return synapses[index]; }, synapses.size());
+    auto proj =
+        make_indexed_projection<ResourceDeltaSynapse>(projection_group, uid_own, uid_from, uid_to, std::move(synapses));
     if (projection_group.hasAttribute("is_locked"))
     {
         if (projection_group.getAttribute("is_locked").read<bool>())
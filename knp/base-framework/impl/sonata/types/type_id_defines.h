@@ -46,6 +46,17 @@ template <class Synapse>
 std::string get_synapse_type_name();
 
 
+/**
+ * @brief Get name of a projection type that stores synapses in other ways than `Projection`.
+ * @details The name is saved as the `projection_type` attribute of the projection group. Synapses of such projections
+ * are also saved as edges, so that other SONATA readers can load them.
+ * @tparam ProjectionType projection type from `core::InferenceProjections`.
+ * @return projection type name.
+ */
+template <class ProjectionType>
+std::string get_projection_type_name();
+
+
 template <class Neuron>
 constexpr int get_neuron_type_id()
 {
@@ -22,6 +22,7 @@
 
 #include <knp/core/core.h>
 
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -46,28 +47,23 @@ public:
      * @param endpoint endpoint used to send messages.
      * @param generator functor that generates spike messages.
      */
-    InputChannel(const core::UID &channel_uid, core::MessageEndpoint &&endpoint, const DataGenerator &generator)
-        : base_{channel_uid}, endpoint_(std::move(endpoint)), generator_(generator)
-    {
-    }
+    InputChannel(const core::UID &channel_uid, core::MessageEndpoint &&endpoint, const DataGenerator &generator);
 
     /**
      * @copydoc InputChannel::InputChannel
      */
-    InputChannel(const core::UID &channel_uid, core::MessageEndpoint &&endpoint, DataGenerator &&generator)
-        : base_{channel_uid}, endpoint_(std::move(endpoint)), generator_(std::move(generator))
-    {
-    }
+    InputChannel(const core::UID &channel_uid, core::MessageEndpoint &&endpoint, DataGenerator &&generator);
 
     /**
      * @brief Move constructor.
      */
-    InputChannel(InputChannel &&) = default;
+    InputChannel(InputChannel &&);
 
     /**
-     * @brief Virtual default destructor of input channel.
+     * @brief Virtual destructor of input channel.
+     * @details The destructor stops background data generation.
      */
-    virtual ~InputChannel() = default;
+    virtual ~InputChannel();
 
 public:
     /**
@@ -89,7 +85,37 @@ public:
      * @param step current step.
      * @return `true` if message was sent, `false` if no message was sent.
      */
-    virtual bool send(core::Step step) { return send_data(generator_(step), step); }
+    virtual bool send(core::Step step);
+
+    /**
+     * @brief Generate data for a range of steps in advance.
+     * @details Staged data are sent by `send()` for steps of the range. Data staged earlier are discarded.
+     * @param first_step first step of the range.
+     * @param steps_count number of steps in the range.
+     */
+    void stage(core::Step first_step, size_t steps_count);
+
+    /**
+     * @brief Remove staged data and free their memory.
+     */
+    void clear_staged();
+
+    /**
+     * @brief Run the generator in a background thread a given number of steps ahead.
+     * @details Data for the step `N` is generated while the network calculates previous steps, `send()` only takes
+     * the ready data from a lock-free queue. The generator is called from the background thread only, with
+     * consecutive steps starting from the step of the first `send()` call. If `send()` receives a step that differs
+     * from the expected one, the background generation is restarted from the received step.
+     * @note Generator exceptions are rethrown by `send()` for the step they were thrown for.
+     * @param prefetch_steps number of steps to generate in advance, `0` disables background generation.
+     */
+    void set_prefetch_steps(size_t prefetch_steps);
+
+    /**
+     * @brief Get number of steps that the generator runs in advance.
+     * @return number of steps, `0` if background generation is disabled.
+     */
+    [[nodiscard]] size_t get_prefetch_steps() const;
 
 protected:
     /**
@@ -122,6 +148,27 @@ private:
      * @brief Generator functor.
      */
     DataGenerator generator_;
+
+    /**
+     * @brief Background data generator.
+     */
+    class Prefetcher;
+
+    /**
+     * @brief Background data generator, `nullptr` if data is generated in `send()`.
+     * @details When background generation is enabled, the prefetcher owns the generator functor.
+     */
+    std::unique_ptr<Prefetcher> prefetcher_;
+
+    /**
+     * @brief Data generated in advance by `stage()`.
+     */
+    std::vector<core::messaging::SpikeData> staged_data_;
+
+    /**
+     * @brief Step of the first staged data.
+     */
+    core::Step staged_first_step_ = 0;
 };
 
 
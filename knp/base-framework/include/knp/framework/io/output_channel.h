@@ -42,14 +42,23 @@ namespace knp::framework::io::output
  */
 class KNP_DECLSPEC OutputChannel
 {
+public:
+    /**
+     * @brief Default maximum number of steps kept in the message buffer.
+     */
+    static constexpr size_t default_max_buffered_steps = 1024;
+
 public:
     /**
      * @brief Base output channel constructor.
      * @param channel_uid output channel UID.
      * @param endpoint endpoint to use for message exchange.
+     * @param max_buffered_steps maximum number of steps kept in the message buffer, `0` means no limit.
      */
-    OutputChannel(const core::UID &channel_uid, core::MessageEndpoint &&endpoint)
-        : base_{channel_uid}, endpoint_(std::move(endpoint))
+    OutputChannel(
+        const core::UID &channel_uid, core::MessageEndpoint &&endpoint,
+        size_t max_buffered_steps = default_max_buffered_steps)
+        : base_{channel_uid}, endpoint_(std::move(endpoint)), max_buffered_steps_(max_buffered_steps)
     {
     }
 
@@ -74,19 +83,62 @@ public:
 public:
     /**
      * @brief Unload spike messages from the endpoint into the message buffer.
-     * @details You should call the method before reading data from the channel.
-     * @return vector of spikes.
+     * @details You should call the method before reading data from the channel. If the buffer is limited, messages
+     * of the oldest steps are discarded.
+     * @return number of new messages.
+     */
+    size_t unload_messages();
+
+    /**
+     * @brief Unload spike messages from the endpoint into the message buffer and get all buffered messages.
+     * @details The method copies the whole message buffer, use `unload_messages()` if you only need to update the
+     * buffer.
+     * @return buffered messages sorted by step.
      */
     std::vector<core::messaging::SpikeMessage> update();
 
     /**
-     * @brief Read a specified interval of messages from sorted internal message buffer.
+     * @brief Read a specified interval of messages from the message buffer and remove them from the buffer.
+     * @details Complexity is linear in the number of buffered steps within the interval.
      * @param starting_step step from which the method starts reading spike messages.
      * @param final_step step after which the method stops reading spike messages.
-     * @return vector of messages sent on the specified interval of steps.
+     * @return vector of messages sent on the specified interval of steps, sorted by step.
      */
     std::vector<core::messaging::SpikeMessage> read_some_from_buffer(core::Step starting_step, core::Step final_step);
 
+    /**
+     * @brief Get maximum number of steps kept in the message buffer.
+     * @return number of steps, `0` if the buffer is not limited.
+     */
+    [[nodiscard]] size_t get_max_buffered_steps() const { return max_buffered_steps_; }
+
+    /**
+     * @brief Limit number of steps kept in the message buffer.
+     * @details If the buffer contains more steps, messages of the oldest steps are discarded.
+     * @param max_buffered_steps maximum number of steps, `0` means no limit.
+     */
+    void set_max_buffered_steps(size_t max_buffered_steps);
+
+protected:
+    /**
+     * @brief Put a message into the buffer slot of its step.
+     * @param message spike message.
+     * @return `true` if the message was buffered, `false` if it is older than the buffered steps.
+     */
+    bool buffer_message(core::messaging::SpikeMessage &&message);
+
+    /**
+     * @brief Discard messages of the oldest buffered steps.
+     * @param steps_count number of steps to discard.
+     */
+    void discard_oldest_steps(size_t steps_count);
+
+    /**
+     * @brief Change number of buffer slots keeping buffered messages.
+     * @param slots_count new number of slots, must not be less than number of buffered steps.
+     */
+    void resize_buffer(size_t slots_count);
+
 protected:
     /**
      * @brief Base data.
@@ -99,9 +151,26 @@ protected:
     core::MessageEndpoint endpoint_;
 
     /**
-     * @brief Messages received from output population.
+     * @brief Ring buffer of messages received from output population.
+     * @details Each slot contains messages of a single step: step `s` is stored in the slot
+     * `s % message_buffer_.size()`. Slots keep their memory, so buffering doesn't allocate in a steady state.
+     */
+    std::vector<std::vector<core::messaging::SpikeMessage>> message_buffer_;  // cppcheck-suppress unusedStructMember
+
+    /**
+     * @brief First buffered step.
+     */
+    core::Step first_step_ = 0;
+
+    /**
+     * @brief Number of buffered steps starting from `first_step_`.
+     */
+    size_t steps_count_ = 0;  // cppcheck-suppress unusedStructMember
+
+    /**
+     * @brief Maximum number of buffered steps, `0` means no limit.
      */
-    std::vector<core::messaging::SpikeMessage> message_buffer_;  // cppcheck-suppress unusedStructMember
+    size_t max_buffered_steps_ = 0;  // cppcheck-suppress unusedStructMember
 };
 
 
@@ -117,7 +186,7 @@ template <typename ResultType>
 [[nodiscard]] ResultType output_channel_get(
     OutputChannel &output_channel, OutputConverter<ResultType> converter, core::Step step_from, core::Step step_to)
 {
-    output_channel.update();
+    output_channel.unload_messages();
     return converter(output_channel.read_some_from_buffer(step_from, step_to));
 }
 
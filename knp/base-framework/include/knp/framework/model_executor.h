@@ -31,6 +31,7 @@
 
 #include <filesystem>
 #include <functional>
+#include <future>
 #include <memory>
 #include <unordered_map>
 #include <utility>
@@ -68,31 +69,115 @@ public:
      */
     void start();
 
+    /**
+     * @brief Default number of steps in a batch of `run_for()`.
+     */
+    static constexpr size_t default_update_period = 1000;
+
     /**
      * @brief Start model execution.
      * @param run_predicate predicate that stops running if the `false` value is returned.
      */
     void start(core::Backend::RunPredicate run_predicate);
 
+    /**
+     * @brief Run model execution for a given number of steps.
+     * @details Unlike `start()`, the step loop doesn't call predicates. Input data are generated for a whole batch
+     * of steps before the batch starts, and output channels and observers are updated once after each batch.
+     * Spike message handlers are still called between steps, because their messages are sent to the network.
+     * Input data of a batch are kept in memory until the batch ends, and are removed after the run.
+     * @param steps_count number of steps to run.
+     * @param update_period number of steps in a batch.
+     * @throw std::invalid_argument if the update period is `0`.
+     * @return number of steps made, which is less than `steps_count` if execution is stopped.
+     */
+    size_t run_for(size_t steps_count, size_t update_period = default_update_period);
+
     /**
      * @brief Stop model execution.
+     * @details The method is thread-safe if execution runs in background.
      */
     void stop();
 
+public:
+    /**
+     * @brief Function type for commands executed on the simulation thread between steps.
+     */
+    using Command = std::function<void(core::Backend &)>;
+
+    /**
+     * @brief Start model execution in a background thread.
+     * @details Execution runs until `stop()` is called or the step set by `run_until()` is reached.
+     * Methods that control background execution are thread-safe, other methods must not be called until
+     * execution stops.
+     * @param command_queue_size maximum number of commands waiting for execution.
+     * @throw std::logic_error if execution already runs in background.
+     * @return future that becomes ready when execution stops. The future rethrows exceptions of the execution.
+     */
+    std::future<void> start_async(size_t command_queue_size = 1024);
+
+    /**
+     * @brief Pause background execution before the next step.
+     * @details Commands are still executed while execution is paused.
+     */
+    void pause();
+
+    /**
+     * @brief Resume paused background execution.
+     */
+    void resume();
+
+    /**
+     * @brief Determine if background execution is paused.
+     * @return `true` if execution is paused.
+     */
+    [[nodiscard]] bool is_paused() const;
+
+    /**
+     * @brief Stop background execution before a given step.
+     * @details The limit applies to the current background execution, `start_async()` resets it. To stop before the
+     * first steps, pause execution before starting it.
+     * @param step number of the first step that is not made.
+     */
+    void run_until(core::Step step);
+
+    /**
+     * @brief Get number of steps made by background execution.
+     * @return step number.
+     */
+    [[nodiscard]] core::Step get_async_step() const;
+
+    /**
+     * @brief Put a command into the queue of commands executed on the simulation thread between steps.
+     * @details Use commands to send input messages or edit the network while it runs in background.
+     * If the queue is full, the method waits for the simulation thread to execute some commands. The method is
+     * thread-safe. Commands posted before execution stops are executed before the execution future becomes ready.
+     * @param command command to execute.
+     * @throw std::logic_error if execution doesn't run in background.
+     */
+    void post(Command &&command);
+
 public:
     /**
      * @brief Add observer to executor.
      * @tparam Message type of messages to observe.
      * @param message_processor functor to process received messages.
      * @param senders list of observed entities.
+     * @param queue_size maximum number of message batches waiting for processing in a separate thread, `0` to
+     * process messages synchronously on the simulation thread.
+     * @param policy policy applied if the processing thread falls behind the simulation.
+     * @note Asynchronous observers have processed all messages by the time `start()` returns.
      */
     template <class Message>
-    void add_observer(monitoring::MessageProcessor<Message> &&message_processor, const std::vector<core::UID> &senders)
+    void add_observer(
+        monitoring::MessageProcessor<Message> &&message_processor, const std::vector<core::UID> &senders,
+        size_t queue_size = 0, monitoring::OverflowPolicy policy = monitoring::OverflowPolicy::block)
     {
-        observers_.emplace_back(monitoring::MessageObserver<Message>(
-            get_backend()->get_message_bus().create_endpoint(), std::move(message_processor), core::UID{true}));
-
-        std::visit([&senders](auto &entity) { entity.subscribe(senders); }, observers_.back());
+        monitoring::MessageObserver<Message> observer(
+            get_backend()->get_message_bus().create_endpoint(), std::move(message_processor), core::UID{true});
+        observer.subscribe(senders);
+        observer.set_async(queue_size, policy);
+        observers_.emplace_back(std::move(observer));
     }
 
     /**
@@ -122,6 +207,69 @@ public:
      */
     void stop_learning() { get_backend()->stop_learning(); }
 
+    /**
+     * @brief Start collecting spike statistics of a population inside the backend.
+     * @param population_uid population UID.
+     * @param settings statistics settings.
+     */
+    void enable_statistics(const core::UID &population_uid, const core::StatisticsSettings &settings = {})
+    {
+        get_backend()->enable_statistics(population_uid, settings);
+    }
+
+    /**
+     * @brief Get spike statistics of a population accumulated since the last reset.
+     * @param population_uid population UID.
+     * @return copy of population statistics.
+     */
+    core::PopulationStatistics get_statistics(const core::UID &population_uid)
+    {
+        return get_backend()->get_statistics(population_uid);
+    }
+
+    /**
+     * @brief Reset accumulated spike statistics of all populations.
+     */
+    void reset_statistics() { get_backend()->reset_statistics(); }
+
+    /**
+     * @brief Start profiling of backend steps.
+     * @param hardware_counters `true` to also account hardware performance counters.
+     */
+    void enable_profiling(bool hardware_counters = false) { get_backend()->enable_profiling(hardware_counters); }
+
+    /**
+     * @brief Stop profiling of backend steps.
+     */
+    void disable_profiling() { get_backend()->disable_profiling(); }
+
+    /**
+     * @brief Get profiling data of backend steps accumulated since the last reset.
+     * @return copy of profiling data.
+     */
+    core::StepProfile get_profile() { return get_backend()->get_profile(); }
+
+    /**
+     * @brief Reset accumulated profiling data of backend steps.
+     */
+    void reset_profile() { get_backend()->reset_profile(); }
+
+    /**
+     * @brief Start recording a timeline of backend steps.
+     */
+    void enable_tracing() { get_backend()->enable_tracing(); }
+
+    /**
+     * @brief Stop recording a timeline of backend steps.
+     */
+    void disable_tracing() { get_backend()->disable_tracing(); }
+
+    /**
+     * @brief Save the recorded timeline of backend steps in the Chrome trace JSON format.
+     * @param path path to file.
+     */
+    void save_trace(const std::filesystem::path &path) { get_backend()->save_trace(path); }
+
     /**
      * @brief Get pointer to backend object.
      * @return shared pointer to `Backend` object.
@@ -136,11 +284,16 @@ public:
 
 private:
     class SpikeMessageHandler;
+    class AsyncRunner;
+
+    // Load output channels and run observers.
+    void update_outputs();
 
     knp::core::BaseData base_;
     ModelLoader loader_;
 
     std::vector<monitoring::AnyObserverVariant> observers_;
     std::vector<std::unique_ptr<SpikeMessageHandler>> message_handlers_;
+    std::unique_ptr<AsyncRunner> async_runner_;
 };
 }  // namespace knp::framework
@@ -22,11 +22,19 @@
 #include <knp/core/impexp.h>
 #include <knp/core/message_endpoint.h>
 #include <knp/core/messaging/messaging.h>
+#include <knp/framework/spsc_queue.h>
 
+#include <spdlog/spdlog.h>
+
+#include <atomic>
+#include <exception>
 #include <filesystem>
 #include <fstream>
 #include <functional>
+#include <iterator>
+#include <memory>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -47,6 +55,246 @@ template <class Message>
 using MessageProcessor = std::function<void(const std::vector<Message> &)>;
 
 
+/**
+ * @brief Policy that defines what an asynchronous observer does with new messages if its queue is full.
+ */
+enum class OverflowPolicy
+{
+    /**
+     * @brief Wait until the processing thread frees space in the queue.
+     */
+    block,
+    /**
+     * @brief Discard new messages.
+     */
+    drop,
+    /**
+     * @brief Keep new messages and pass them to the processing thread together with messages of next steps.
+     */
+    coalesce
+};
+
+
+/**
+ * @brief The AsyncMessageProcessor class is a definition of a processor that runs a message processing functor
+ * in a separate thread.
+ * @details Message batches are passed to the processing thread through a bounded lock-free queue.
+ * @tparam Message type of messages the processor handles.
+ */
+template <class Message>
+class AsyncMessageProcessor
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param processor functor to process messages.
+     * @param queue_size maximum number of message batches waiting for processing.
+     * @param policy policy applied if the queue is full.
+     */
+    AsyncMessageProcessor(MessageProcessor<Message> &&processor, size_t queue_size, OverflowPolicy policy)
+        : process_messages_(std::move(processor)), queue_(queue_size), policy_(policy)
+    {
+        consumer_ = std::thread([this]() { run(); });
+    }
+
+    /**
+     * @brief Destructor. Processes all queued messages before returning.
+     */
+    ~AsyncMessageProcessor()
+    {
+        try
+        {
+            push_pending();
+        }
+        catch (...)
+        {
+            SPDLOG_WARN("Messages were not processed due to a processing error.");
+        }
+        stop();
+    }
+
+    /**
+     * @brief Deleted copy constructor.
+     */
+    AsyncMessageProcessor(const AsyncMessageProcessor &) = delete;
+
+    /**
+     * @brief Deleted copy operator.
+     */
+    AsyncMessageProcessor &operator=(const AsyncMessageProcessor &) = delete;
+
+public:
+    /**
+     * @brief Pass messages to the processing thread.
+     * @param messages messages to process.
+     * @throw Exception thrown by the message processing functor.
+     */
+    void push(std::vector<Message> &&messages)
+    {
+        rethrow_error();
+
+        switch (policy_)
+        {
+            case OverflowPolicy::block:
+                push_blocking(std::move(messages));
+                break;
+            case OverflowPolicy::drop:
+                if (queue_.try_push(std::move(messages)))
+                    ++pushed_;
+                else
+                    dropped_ += messages.size();
+                break;
+            case OverflowPolicy::coalesce:
+                if (!has_pending_)
+                {
+                    pending_ = std::move(messages);
+                    has_pending_ = true;
+                }
+                else
+                {
+                    pending_.insert(
+                        pending_.end(), std::make_move_iterator(messages.begin()),
+                        std::make_move_iterator(messages.end()));
+                }
+                if (queue_.try_push(std::move(pending_)))
+                {
+                    ++pushed_;
+                    pending_.clear();
+                    has_pending_ = false;
+                }
+                break;
+        }
+    }
+
+    /**
+     * @brief Wait until all passed messages are processed.
+     * @throw Exception thrown by the message processing functor.
+     */
+    void flush()
+    {
+        rethrow_error();
+        push_pending();
+
+        Backoff backoff;
+        while (processed_.load(std::memory_order_acquire) != pushed_)
+        {
+            rethrow_error();
+            backoff.wait();
+        }
+    }
+
+    /**
+     * @brief Process all queued messages, stop the processing thread and return the message processing functor.
+     * @return message processing functor.
+     * @throw Exception thrown by the message processing functor.
+     */
+    MessageProcessor<Message> release()
+    {
+        flush();
+        stop();
+        return std::move(process_messages_);
+    }
+
+    /**
+     * @brief Get maximum number of message batches waiting for processing.
+     * @return queue size.
+     */
+    [[nodiscard]] size_t get_queue_size() const { return queue_.capacity(); }
+
+    /**
+     * @brief Get policy applied if the queue is full.
+     * @return overflow policy.
+     */
+    [[nodiscard]] OverflowPolicy get_policy() const { return policy_; }
+
+    /**
+     * @brief Get number of messages discarded because the queue was full.
+     * @return number of dropped messages.
+     */
+    [[nodiscard]] size_t get_dropped_count() const { return dropped_; }
+
+private:
+    void push_blocking(std::vector<Message> &&messages)
+    {
+        Backoff backoff;
+        while (!queue_.try_push(std::move(messages)))
+        {
+            // Processing thread doesn't take messages after an error.
+            rethrow_error();
+            backoff.wait();
+        }
+        ++pushed_;
+    }
+
+    void push_pending()
+    {
+        if (!has_pending_) return;
+        push_blocking(std::move(pending_));
+        pending_.clear();
+        has_pending_ = false;
+    }
+
+    void rethrow_error() const
+    {
+        if (has_error_.load(std::memory_order_acquire)) std::rethrow_exception(error_);
+    }
+
+    void stop()
+    {
+        stop_.store(true, std::memory_order_release);
+        if (consumer_.joinable()) consumer_.join();
+    }
+
+    void run()
+    {
+        Backoff backoff;
+        std::vector<Message> messages;
+        while (true)
+        {
+            // All batches pushed before the stop flag was set are visible after it is read.
+            const bool stopping = stop_.load(std::memory_order_acquire);
+            if (queue_.try_pop(messages))
+            {
+                backoff.reset();
+                try
+                {
+                    process_messages_(messages);
+                }
+                catch (...)
+                {
+                    SPDLOG_ERROR("Asynchronous message processing failed.");
+                    error_ = std::current_exception();
+                    has_error_.store(true, std::memory_order_release);
+                    return;
+                }
+                processed_.fetch_add(1, std::memory_order_release);
+                continue;
+            }
+            if (stopping) return;
+            backoff.wait();
+        }
+    }
+
+private:
+    MessageProcessor<Message> process_messages_;
+    SPSCQueue<std::vector<Message>> queue_;
+    OverflowPolicy policy_;
+    std::thread consumer_;
+    std::atomic<bool> stop_ = false;
+
+    // Processing thread state.
+    std::atomic<size_t> processed_ = 0;
+    std::atomic<bool> has_error_ = false;
+    std::exception_ptr error_;
+
+    // Observer thread state.
+    size_t pushed_ = 0;
+    size_t dropped_ = 0;
+    std::vector<Message> pending_;
+    bool has_pending_ = false;
+};
+
+
 /**
  * @brief The MessageObserver class is a definition of an observer that receives messages and processes them.
  * @tparam Message message type that is processed by an observer.
@@ -87,12 +335,62 @@ public:
 
     /**
      * @brief Receive and process messages.
+     * @details If the observer is asynchronous, messages are passed to the processing thread.
      */
     void update()
     {
         endpoint_.receive_all_messages();
         auto messages_raw = endpoint_.unload_messages<Message>(base_data_.uid_);
-        process_messages_(messages_raw);
+        if (async_processor_)
+            async_processor_->push(std::move(messages_raw));
+        else
+            process_messages_(messages_raw);
+    }
+
+    /**
+     * @brief Make message processing asynchronous or synchronous.
+     * @details Asynchronous observer calls the message processing functor in a separate thread, so the functor
+     * must not access data used by the simulation without synchronization.
+     * @param queue_size maximum number of message batches waiting for processing, `0` to process messages
+     * synchronously.
+     * @param policy policy applied if the processing thread falls behind and the queue is full.
+     */
+    void set_async(size_t queue_size, OverflowPolicy policy = OverflowPolicy::block)
+    {
+        if (async_processor_)
+        {
+            process_messages_ = async_processor_->release();
+            async_processor_.reset();
+        }
+        if (queue_size)
+        {
+            async_processor_ = std::make_unique<AsyncMessageProcessor<Message>>(
+                std::move(process_messages_), queue_size, policy);
+        }
+    }
+
+    /**
+     * @brief Determine if messages are processed asynchronously.
+     * @return `true` if the observer is asynchronous.
+     */
+    [[nodiscard]] bool is_async() const { return static_cast<bool>(async_processor_); }
+
+    /**
+     * @brief Wait until all received messages are processed.
+     * @details The method does nothing if the observer is synchronous.
+     */
+    void flush()
+    {
+        if (async_processor_) async_processor_->flush();
+    }
+
+    /**
+     * @brief Get number of messages discarded because the processing thread fell behind.
+     * @return number of dropped messages.
+     */
+    [[nodiscard]] size_t get_dropped_count() const
+    {
+        return async_processor_ ? async_processor_->get_dropped_count() : 0;
     }
 
     /**
@@ -105,6 +403,7 @@ private:
     core::MessageEndpoint endpoint_;
     MessageProcessor<Message> process_messages_;
     core::BaseData base_data_;
+    std::unique_ptr<AsyncMessageProcessor<Message>> async_processor_;
 };
 
 /**
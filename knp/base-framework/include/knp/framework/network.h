@@ -21,11 +21,11 @@
 
 #pragma once
 
+#include <knp/core/all_projections.h>
 #include <knp/core/backend.h>
 #include <knp/core/core.h>
 #include <knp/core/impexp.h>
 #include <knp/core/population.h>
-#include <knp/core/projection.h>
 #include <knp/framework/coordinates/generator.h>
 #include <knp/framework/projection/connectors.h>
 #include <knp/framework/projection/synapse_parameters_generators.h>
@@ -389,6 +389,12 @@ public:
      */
     [[nodiscard]] size_t projections_count() const { return projections_.size(); }
 
+    /**
+     * @brief Get memory used by populations and projections of the network.
+     * @return memory usage.
+     */
+    [[nodiscard]] core::MemoryUsage memory_usage() const;
+
 public:
     /**
      * @brief Get network UID.
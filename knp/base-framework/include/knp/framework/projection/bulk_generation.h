@@ -0,0 +1,258 @@
+/**
+ * @file bulk_generation.h
+ * @brief Parallel generation of projection synapses.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <knp/core/counter_rng.h>
+#include <knp/core/projection.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <optional>
+#include <random>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+/**
+ * @brief Projection namespace.
+ */
+namespace knp::framework::projection
+{
+
+/**
+ * @brief Namespace for bulk synapse generation.
+ * @details Bulk generation calls a generator, that is not wrapped into `std::function`, for a range of indexes
+ * in several threads and writes synapses into preallocated storage. Random generators should use
+ * `core::Philox4x32` with the synapse index as a stream number, so that the result doesn't depend on the number of
+ * threads.
+ */
+namespace bulk
+{
+
+/**
+ * @brief Default number of threads used by projection creators, `0` means that the number is chosen automatically.
+ */
+constexpr size_t default_threads_count = 0;
+
+
+/**
+ * @brief Minimal number of synapses generated by a thread if the number of threads is chosen automatically.
+ * @details Smaller projections are generated by fewer threads, because starting a thread takes more time than
+ * generating the synapses.
+ */
+constexpr size_t min_synapses_per_thread = 16384;
+
+
+/**
+ * @brief Get a random seed for counter-based generators.
+ * @return seed.
+ */
+inline uint64_t random_seed()
+{
+    std::random_device device;
+    return static_cast<uint64_t>(device()) << 32 | device();
+}
+
+
+/**
+ * @brief Run a function for contiguous chunks of an index range in parallel.
+ * @param size range size.
+ * @param threads_count number of threads, `0` to use all hardware threads, but no more than one thread for
+ * `min_chunk_size` indexes.
+ * @param function function that receives a chunk number and the first and last (exclusive) chunk indexes.
+ * @param min_chunk_size minimal number of indexes processed by a thread if `threads_count` is `0`.
+ * @tparam Function function type.
+ * @return number of chunks.
+ * @throw any exception thrown by the function. If several threads fail, the exception of the first chunk is thrown.
+ */
+template <class Function>
+size_t for_each_chunk(size_t size, size_t threads_count, Function &&function, size_t min_chunk_size = 1)
+{
+    if (!threads_count)
+    {
+        const size_t max_threads_count = size / std::max<size_t>(min_chunk_size, 1);
+        threads_count = std::max<size_t>(std::min<size_t>(std::thread::hardware_concurrency(), max_threads_count), 1);
+    }
+    const size_t chunks_count = std::max<size_t>(std::min(threads_count, size), 1);
+    const size_t chunk_size = size / chunks_count;
+    const size_t remainder = size % chunks_count;
+    auto chunk_begin = [chunk_size, remainder](size_t chunk)
+    { return chunk * chunk_size + std::min(chunk, remainder); };
+
+    if (chunks_count == 1)
+    {
+        function(0, 0, size);
+        return chunks_count;
+    }
+
+    std::vector<std::exception_ptr> errors(chunks_count);
+    std::vector<std::thread> threads;
+    threads.reserve(chunks_count - 1);
+    auto run_chunk = [&function, &errors, &chunk_begin](size_t chunk)
+    {
+        try
+        {
+            function(chunk, chunk_begin(chunk), chunk_begin(chunk + 1));
+        }
+        catch (...)
+        {
+            errors[chunk] = std::current_exception();
+        }
+    };
+
+    // The calling thread processes the first chunk.
+    for (size_t chunk = 1; chunk < chunks_count; ++chunk) threads.emplace_back(run_chunk, chunk);
+    run_chunk(0);
+    for (auto &thread : threads) thread.join();
+
+    for (const auto &error : errors)
+    {
+        if (error) std::rethrow_exception(error);
+    }
+    return chunks_count;
+}
+
+
+/**
+ * @brief Generate groups of synapses by calling a generator for each group index in parallel.
+ * @details Each thread collects synapses of its group chunk, and chunks are then moved into storage of the exact
+ * size. Synapses are ordered by group index regardless of the number of threads.
+ * @param generator functor that gets a group index and a synapse vector, and appends synapses of the group to the
+ * vector. The functor is called concurrently, so it must be thread-safe if `threads_count` is not `1`.
+ * @param groups_count number of groups.
+ * @param threads_count number of threads, `0` to choose the number by the expected number of synapses.
+ * @param group_size expected number of synapses in a group.
+ * @tparam SynapseType projection synapse type.
+ * @tparam Generator generator type.
+ * @return generated synapses.
+ */
+template <typename SynapseType, class Generator>
+[[nodiscard]] std::vector<typename core::Projection<SynapseType>::Synapse> generate_synapse_groups(
+    Generator &&generator, size_t groups_count, size_t threads_count = default_threads_count, size_t group_size = 1)
+{
+    using Synapse = typename core::Projection<SynapseType>::Synapse;
+
+    std::vector<std::vector<Synapse>> chunks(
+        threads_count ? threads_count : std::max<size_t>(std::thread::hardware_concurrency(), 1));
+    const size_t chunks_count = for_each_chunk(
+        groups_count, threads_count,
+        [&chunks, &generator](size_t chunk, size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i) generator(i, chunks[chunk]);
+        },
+        min_synapses_per_thread / std::max<size_t>(group_size, 1));
+    if (chunks_count == 1) return std::move(chunks.front());
+
+    std::vector<size_t> offsets(chunks_count + 1, 0);
+    for (size_t chunk = 0; chunk < chunks_count; ++chunk) offsets[chunk + 1] = offsets[chunk] + chunks[chunk].size();
+
+    std::vector<Synapse> synapses(offsets.back());
+    for_each_chunk(
+        chunks_count, chunks_count,
+        [&synapses, &chunks, &offsets](size_t, size_t begin, size_t end)
+        {
+            for (size_t chunk = begin; chunk < end; ++chunk)
+            {
+                std::move(chunks[chunk].begin(), chunks[chunk].end(), synapses.begin() + offsets[chunk]);
+                chunks[chunk] = {};
+            }
+        });
+
+    return synapses;
+}
+
+
+/**
+ * @brief Generate synapses by calling a generator for each index in parallel.
+ * @details If the generator returns a synapse, storage for all synapses is allocated once and threads write
+ * synapses directly into it. If the generator returns an optional synapse, synapses are generated as groups of at
+ * most one synapse. Synapses are ordered by index regardless of the number of threads.
+ * @param generator functor that gets a synapse index and returns `Synapse` or `std::optional<Synapse>`.
+ * The functor is called concurrently, so it must be thread-safe if `threads_count` is not `1`.
+ * @param num_iterations number of times to run the generator.
+ * @param threads_count number of threads, `0` to choose the number by the number of synapses.
+ * @tparam SynapseType projection synapse type.
+ * @tparam Generator generator type.
+ * @return generated synapses.
+ * @see generate_synapse_groups.
+ */
+template <typename SynapseType, class Generator>
+[[nodiscard]] std::vector<typename core::Projection<SynapseType>::Synapse> generate_synapses(
+    Generator &&generator, size_t num_iterations, size_t threads_count = default_threads_count)
+{
+    using Synapse = typename core::Projection<SynapseType>::Synapse;
+    using Result = std::decay_t<std::invoke_result_t<Generator &, size_t>>;
+
+    if constexpr (std::is_same_v<Result, Synapse>)
+    {
+        std::vector<Synapse> synapses(num_iterations);
+        for_each_chunk(
+            num_iterations, threads_count,
+            [&synapses, &generator](size_t, size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; ++i) synapses[i] = generator(i);
+            },
+            min_synapses_per_thread);
+        return synapses;
+    }
+    else
+    {
+        static_assert(std::is_same_v<Result, std::optional<Synapse>>, "Generator must return a synapse.");
+
+        return generate_synapse_groups<SynapseType>(
+            [&generator](size_t index, std::vector<Synapse> &synapses)
+            {
+                if (auto synapse = generator(index)) synapses.emplace_back(std::move(*synapse));
+            },
+            num_iterations, threads_count);
+    }
+}
+
+
+/**
+ * @brief Construct a projection by calling a synapse generator for each index in parallel.
+ * @details The synapse index is built once, after all synapses are generated.
+ * @param presynaptic_uid presynaptic population UID.
+ * @param postsynaptic_uid postsynaptic population UID.
+ * @param generator functor that gets a synapse index and returns `Synapse` or `std::optional<Synapse>`.
+ * @param num_iterations number of times to run the generator.
+ * @param threads_count number of threads, `0` to choose the number by the number of synapses.
+ * @tparam SynapseType projection synapse type.
+ * @tparam Generator generator type.
+ * @return projection.
+ * @see generate_synapses.
+ */
+template <typename SynapseType, class Generator>
+[[nodiscard]] core::Projection<SynapseType> make_projection(
+    const core::UID &presynaptic_uid, const core::UID &postsynaptic_uid, Generator &&generator,
+    size_t num_iterations, size_t threads_count = default_threads_count)
+{
+    return core::Projection<SynapseType>(
+        presynaptic_uid, postsynaptic_uid,
+        generate_synapses<SynapseType>(std::forward<Generator>(generator), num_iterations, threads_count));
+}
+
+}  // namespace bulk
+
+}  // namespace knp::framework::projection
@@ -22,12 +22,17 @@
 
 #include <knp/core/projection.h>
 
+#include <cmath>
+#include <cstdint>
 #include <exception>
-#include <functional>
 #include <optional>
 #include <random>
+#include <stdexcept>
 #include <tuple>
+#include <utility>
+#include <vector>
 
+#include "bulk_generation.h"
 #include "synapse_generators.h"
 #include "synapse_parameters_generators.h"
 
@@ -55,20 +60,26 @@ namespace creators
  * @param presynaptic_pop_size presynaptic population neuron count.
  * @param postsynaptic_pop_size postsynaptic population neuron count.
  * @param syn_gen generator of synapse parameters.
+ * @param threads_count number of threads generating synapses, `0` to use all hardware threads, but fewer threads for
+ * small projections. If it's not `1`, the synapse parameters generator must be thread-safe.
  * @tparam SynapseType projection synapse type.
+ * @tparam SynGen synapse parameters generator type.
  * @return projection.
  */
-template <typename SynapseType>
+template <typename SynapseType, class SynGen = parameters_generators::DefaultSynapseGen<SynapseType>>
 [[nodiscard]] knp::core::Projection<SynapseType> all_to_all(
     const knp::core::UID &presynaptic_uid, const knp::core::UID &postsynaptic_uid, size_t presynaptic_pop_size,
-    size_t postsynaptic_pop_size,
-    parameters_generators::SynGen2ParamsType<SynapseType> syn_gen =
-        parameters_generators::default_synapse_gen<SynapseType>)
+    size_t postsynaptic_pop_size, SynGen syn_gen = SynGen(), size_t threads_count = bulk::default_threads_count)
 {
-    return knp::core::Projection<SynapseType>(
+    return bulk::make_projection<SynapseType>(
         presynaptic_uid, postsynaptic_uid,
-        synapse_generators::all_to_all<SynapseType>(presynaptic_pop_size, postsynaptic_pop_size, syn_gen),
-        presynaptic_pop_size * postsynaptic_pop_size);
+        [presynaptic_pop_size, &syn_gen](size_t index) -> typename knp::core::Projection<SynapseType>::Synapse
+        {
+            const size_t index0 = index % presynaptic_pop_size;
+            const size_t index1 = index / presynaptic_pop_size;
+            return {syn_gen(index0, index1), index0, index1};
+        },
+        presynaptic_pop_size * postsynaptic_pop_size, threads_count);
 }
 
 
@@ -83,18 +94,22 @@ template <typename SynapseType>
  * @param postsynaptic_uid postsynaptic population UID.
  * @param population_size neuron count in populations.
  * @param syn_gen generator of synapse parameters.
+ * @param threads_count number of threads generating synapses, `0` to use all hardware threads, but fewer threads for
+ * small projections. If it's not `1`, the synapse parameters generator must be thread-safe.
  * @tparam SynapseType projection synapse type.
+ * @tparam SynGen synapse parameters generator type.
  * @return projection.
  */
-template <typename SynapseType>
+template <typename SynapseType, class SynGen = parameters_generators::DefaultSynapseGen<SynapseType>>
 [[nodiscard]] knp::core::Projection<SynapseType> one_to_one(
     const knp::core::UID &presynaptic_uid, const knp::core::UID &postsynaptic_uid, size_t population_size,
-    parameters_generators::SynGen1ParamType<SynapseType> syn_gen =
-        std::bind(parameters_generators::default_synapse_gen<SynapseType>, std::placeholders::_1, 0))
+    SynGen syn_gen = SynGen(), size_t threads_count = bulk::default_threads_count)
 {
-    return knp::core::Projection<SynapseType>(
-        presynaptic_uid, postsynaptic_uid, synapse_generators::one_to_one<SynapseType>(population_size, syn_gen),
-        population_size);
+    return bulk::make_projection<SynapseType>(
+        presynaptic_uid, postsynaptic_uid,
+        [&syn_gen](size_t index) -> typename knp::core::Projection<SynapseType>::Synapse
+        { return {syn_gen(index), index, index}; },
+        population_size, threads_count);
 }
 
 
@@ -115,9 +130,9 @@ template <typename SynapseType, template <typename...> class Container>
     const knp::core::UID &presynaptic_uid, const knp::core::UID &postsynaptic_uid,
     const Container<typename core::Projection<SynapseType>::Synapse> &container)
 {
-    return typename knp::core::Projection<SynapseType>(
-        presynaptic_uid, postsynaptic_uid, synapse_generators::from_container<SynapseType, Container>(container),
-        container.size());
+    return knp::core::Projection<SynapseType>(
+        presynaptic_uid, postsynaptic_uid,
+        std::vector<typename core::Projection<SynapseType>::Synapse>(container.begin(), container.end()));
 }
 
 
@@ -137,15 +152,24 @@ template <typename SynapseType, template <typename, typename, typename...> class
     const Map<typename std::tuple<size_t, size_t>, typename knp::core::Projection<SynapseType>::SynapseParameters>
         &synapses_map)
 {
-    return knp::core::Projection<SynapseType>(
-        presynaptic_uid, postsynaptic_uid, synapse_generators::FromMap<SynapseType, Map>(synapses_map),
-        synapses_map.size());
+    std::vector<typename core::Projection<SynapseType>::Synapse> synapses;
+    synapses.reserve(synapses_map.size());
+    for (const auto &[indexes, parameters] : synapses_map)
+    {
+        synapses.emplace_back(parameters, std::get<0>(indexes), std::get<1>(indexes));
+    }
+
+    return knp::core::Projection<SynapseType>(presynaptic_uid, postsynaptic_uid, std::move(synapses));
 }
 
 
 /**
  * @brief Make connections with some probability between each presynaptic population (source) neuron
  * to each postsynaptic population (destination) neuron.
+ * @details Presynaptic neurons are processed in parallel, and each of them uses its own Philox4x32 stream
+ * to skip the number of rejected postsynaptic neurons drawn from the geometric distribution. Generation time is
+ * proportional to the number of connections, and connections don't depend on the number of threads.
+ * Synapses are ordered by presynaptic neuron, then by postsynaptic neuron.
  * @warning It doesn't get "real" populations and can't be used with populations that contain non-contiguous indexes.
  * @param presynaptic_uid presynaptic population UID.
  * @param postsynaptic_uid postsynaptic population UID.
@@ -153,21 +177,45 @@ template <typename SynapseType, template <typename, typename, typename...> class
  * @param postsynaptic_pop_size postsynaptic population neuron count.
  * @param connection_probability connection probability.
  * @param syn_gen generator of synapse parameters.
+ * @param threads_count number of threads generating synapses, `0` to use all hardware threads, but fewer threads for
+ * small projections. If it's not `1`, the synapse parameters generator must be thread-safe.
+ * @param seed random generator seed to make connections reproducible, `std::nullopt` to use a random seed.
  * @tparam SynapseType projection synapse type.
+ * @tparam SynGen synapse parameters generator type.
  * @return projection.
  */
-template <typename SynapseType>
+template <typename SynapseType, class SynGen = parameters_generators::DefaultSynapseGen<SynapseType>>
 [[nodiscard]] knp::core::Projection<SynapseType> fixed_probability(
     const knp::core::UID &presynaptic_uid, const knp::core::UID &postsynaptic_uid, size_t presynaptic_pop_size,
-    size_t postsynaptic_pop_size, double connection_probability,
-    parameters_generators::SynGen2ParamsType<SynapseType> syn_gen =
-        parameters_generators::default_synapse_gen<SynapseType>)
+    size_t postsynaptic_pop_size, double connection_probability, SynGen syn_gen = SynGen(),
+    size_t threads_count = bulk::default_threads_count, std::optional<uint64_t> seed = std::nullopt)
 {
-    const auto proj_size = presynaptic_pop_size * postsynaptic_pop_size;
-    auto fp = synapse_generators::FixedProbability<SynapseType>{
-        presynaptic_pop_size, postsynaptic_pop_size, connection_probability, syn_gen};
+    using Synapse = typename knp::core::Projection<SynapseType>::Synapse;
 
-    return knp::core::Projection<SynapseType>(presynaptic_uid, postsynaptic_uid, fp, proj_size);
+    if (connection_probability > 1 || connection_probability < 0)
+        throw std::logic_error("Incorrect probability, set probability between 0 and 1.");
+
+    const double log_rejection = std::log1p(-connection_probability);
+    return knp::core::Projection<SynapseType>(
+        presynaptic_uid, postsynaptic_uid,
+        bulk::generate_synapse_groups<SynapseType>(
+            [postsynaptic_pop_size, connection_probability, log_rejection, &syn_gen,
+             rng_seed = seed.value_or(bulk::random_seed())](size_t index0, std::vector<Synapse> &synapses)
+            {
+                core::Philox4x32 rng(rng_seed, index0);
+                std::uniform_real_distribution<double> dist(0, 1);
+                for (size_t index1 = 0; index1 < postsynaptic_pop_size; ++index1)
+                {
+                    // Number of rejected neurons before the next accepted one has the geometric distribution.
+                    const double gap =
+                        connection_probability < 1 ? std::floor(std::log(1 - dist(rng)) / log_rejection) : 0;
+                    if (gap >= static_cast<double>(postsynaptic_pop_size - index1)) break;
+                    index1 += static_cast<size_t>(gap);
+                    synapses.emplace_back(syn_gen(index0, index1), index0, index1);
+                }
+            },
+            connection_probability > 0 ? presynaptic_pop_size : 0, threads_count,
+            static_cast<size_t>(std::ceil(connection_probability * static_cast<double>(postsynaptic_pop_size)))));
 }
 
 
@@ -179,25 +227,36 @@ template <typename SynapseType>
  * @param presynaptic_pop_size presynaptic population neuron count.
  * @param postsynaptic_pop_size postsynaptic population neuron count.
  * @param syn_gen generator of synapse parameters.
+ * @param threads_count number of threads generating synapses, `0` to use all hardware threads, but fewer threads for
+ * small projections. If it's not `1`, the synapse parameters generator must be thread-safe.
  * @tparam SynapseType projection synapse type.
+ * @tparam SynGen synapse parameters generator type.
  * @return projection.
  */
-template <typename SynapseType>
+template <typename SynapseType, class SynGen = parameters_generators::SynGenOptional2ParamsType<SynapseType>>
 [[nodiscard]] knp::core::Projection<SynapseType> index_based(
     const knp::core::UID &presynaptic_uid, const knp::core::UID &postsynaptic_uid, size_t presynaptic_pop_size,
-    size_t postsynaptic_pop_size, parameters_generators::SynGenOptional2ParamsType<SynapseType> syn_gen)
+    size_t postsynaptic_pop_size, SynGen syn_gen, size_t threads_count = bulk::default_threads_count)
 {
-    const auto proj_size = presynaptic_pop_size * postsynaptic_pop_size;
-
-    return knp::core::Projection<SynapseType>(
+    return bulk::make_projection<SynapseType>(
         presynaptic_uid, postsynaptic_uid,
-        synapse_generators::index_based<SynapseType>(presynaptic_pop_size, postsynaptic_pop_size, syn_gen), proj_size);
+        [presynaptic_pop_size,
+         &syn_gen](size_t index) -> std::optional<typename knp::core::Projection<SynapseType>::Synapse>
+        {
+            const size_t index0 = index % presynaptic_pop_size;
+            const size_t index1 = index / presynaptic_pop_size;
+            auto parameters = syn_gen(index0, index1);
+
+            if (parameters.has_value()) return std::make_tuple(std::move(parameters.value()), index0, index1);
+            return std::nullopt;
+        },
+        presynaptic_pop_size * postsynaptic_pop_size, threads_count);
 }
 
 
 /**
  * @brief Make connections between each presynaptic neuron and a fixed number of random postsynaptic neurons.
- * @details This connector uses MT19937 generator with uniform integer distribution.
+ * @details This connector uses Philox4x32 counter-based generator with uniform integer distribution.
  * @warning It doesn't get "real" populations and can't be used with populations that contain non-contiguous indexes.
  * @param presynaptic_uid presynaptic population UID.
  * @param postsynaptic_uid postsynaptic population UID.
@@ -205,28 +264,36 @@ template <typename SynapseType>
  * @param postsynaptic_pop_size postsynaptic population neuron count.
  * @param neurons_count number of postsynaptic neurons.
  * @param syn_gen generator of synapse parameters.
+ * @param threads_count number of threads generating synapses, `0` to use all hardware threads, but fewer threads for
+ * small projections. If it's not `1`, the synapse parameters generator must be thread-safe.
+ * @param seed random generator seed to make connections reproducible, `std::nullopt` to use a random seed.
  * @tparam SynapseType projection synapse type.
+ * @tparam SynGen synapse parameters generator type.
  * @return projection.
  */
-template <typename SynapseType>
+template <typename SynapseType, class SynGen = parameters_generators::DefaultSynapseGen<SynapseType>>
 [[nodiscard]] knp::core::Projection<SynapseType> fixed_number_post(
     const knp::core::UID &presynaptic_uid, const knp::core::UID &postsynaptic_uid, size_t presynaptic_pop_size,
-    size_t postsynaptic_pop_size, size_t neurons_count,
-    parameters_generators::SynGen2ParamsType<SynapseType> syn_gen =
-        parameters_generators::default_synapse_gen<SynapseType>)
+    size_t postsynaptic_pop_size, size_t neurons_count, SynGen syn_gen = SynGen(),
+    size_t threads_count = bulk::default_threads_count, std::optional<uint64_t> seed = std::nullopt)
 {
-    const auto proj_size = presynaptic_pop_size * neurons_count;
-
-    return knp::core::Projection<SynapseType>(
+    return bulk::make_projection<SynapseType>(
         presynaptic_uid, postsynaptic_uid,
-        synapse_generators::FixedNumberPost<SynapseType>(presynaptic_pop_size, postsynaptic_pop_size, syn_gen),
-        proj_size);
+        [presynaptic_pop_size, postsynaptic_pop_size, &syn_gen, rng_seed = seed.value_or(bulk::random_seed())](
+            size_t index) -> typename knp::core::Projection<SynapseType>::Synapse
+        {
+            core::Philox4x32 rng(rng_seed, index);
+            const size_t index0 = index % presynaptic_pop_size;
+            const size_t index1 = std::uniform_int_distribution<size_t>(0, postsynaptic_pop_size - 1)(rng);
+            return {syn_gen(index0, index1), index0, index1};
+        },
+        presynaptic_pop_size * neurons_count, threads_count);
 }
 
 
 /**
  * @brief Make connections between each postsynaptic neuron and a fixed number of random presynaptic neurons.
- * @details This connector uses MT19937 generator with uniform integer distribution.
+ * @details This connector uses Philox4x32 counter-based generator with uniform integer distribution.
  * @warning It doesn't get "real" populations and can't be used with populations that contain non-contiguous indexes.
  * @param presynaptic_uid presynaptic population UID.
  * @param postsynaptic_uid postsynaptic population UID.
@@ -234,22 +301,30 @@ template <typename SynapseType>
  * @param postsynaptic_pop_size postsynaptic population neuron count.
  * @param neurons_count number of presynaptic neurons.
  * @param syn_gen generator of synapse parameters.
+ * @param threads_count number of threads generating synapses, `0` to use all hardware threads, but fewer threads for
+ * small projections. If it's not `1`, the synapse parameters generator must be thread-safe.
+ * @param seed random generator seed to make connections reproducible, `std::nullopt` to use a random seed.
  * @tparam SynapseType projection synapse type.
+ * @tparam SynGen synapse parameters generator type.
  * @return projection.
  */
-template <typename SynapseType>
+template <typename SynapseType, class SynGen = parameters_generators::DefaultSynapseGen<SynapseType>>
 [[nodiscard]] knp::core::Projection<SynapseType> fixed_number_pre(
     const knp::core::UID &presynaptic_uid, const knp::core::UID &postsynaptic_uid, size_t presynaptic_pop_size,
-    size_t postsynaptic_pop_size, size_t neurons_count,
-    parameters_generators::SynGen2ParamsType<SynapseType> syn_gen =
-        parameters_generators::default_synapse_gen<SynapseType>)
+    size_t postsynaptic_pop_size, size_t neurons_count, SynGen syn_gen = SynGen(),
+    size_t threads_count = bulk::default_threads_count, std::optional<uint64_t> seed = std::nullopt)
 {
-    const auto proj_size = postsynaptic_pop_size * neurons_count;
-
-    return knp::core::Projection<SynapseType>(
+    return bulk::make_projection<SynapseType>(
         presynaptic_uid, postsynaptic_uid,
-        synapse_generators::FixedNumberPre<SynapseType>(presynaptic_pop_size, postsynaptic_pop_size, syn_gen),
-        proj_size);
+        [presynaptic_pop_size, postsynaptic_pop_size, &syn_gen, rng_seed = seed.value_or(bulk::random_seed())](
+            size_t index) -> typename knp::core::Projection<SynapseType>::Synapse
+        {
+            core::Philox4x32 rng(rng_seed, index);
+            const size_t index0 = std::uniform_int_distribution<size_t>(0, presynaptic_pop_size - 1)(rng);
+            const size_t index1 = index % postsynaptic_pop_size;
+            return {syn_gen(index0, index1), index0, index1};
+        },
+        postsynaptic_pop_size * neurons_count, threads_count);
 }
 
 
@@ -262,23 +337,33 @@ template <typename SynapseType>
  * @param presynaptic_uid optional presynaptic population UID.
  * @param postsynaptic_uid optional postsynaptic population UID.
  * @param syn_gen generator of synapse parameters.
+ * @param threads_count number of threads generating synapses, `0` to use all hardware threads, but fewer threads for
+ * small projections. If it's not `1`, the synapse parameters generator must be thread-safe.
  * @tparam DestinationSynapseType generator of target synapse parameters.
  * @tparam SourceSynapseType source projection synapse type.
+ * @tparam SynGen synapse parameters generator type.
  * @return projection of the `DestinationSynapseType` synapses.
  */
-template <typename DestinationSynapseType, typename SourceSynapseType>
+template <
+    typename DestinationSynapseType, typename SourceSynapseType,
+    class SynGen = parameters_generators::DefaultSynapseGen<DestinationSynapseType>>
 [[nodiscard]] knp::core::Projection<DestinationSynapseType> clone_projection(
-    const knp::core::Projection<SourceSynapseType> &source_proj,
-    parameters_generators::SynGen1ParamType<DestinationSynapseType> syn_gen =
-        parameters_generators::default_synapse_gen<DestinationSynapseType>,
+    const knp::core::Projection<SourceSynapseType> &source_proj, SynGen syn_gen = SynGen(),
     const std::optional<knp::core::UID> &presynaptic_uid = std::nullopt,
-    const std::optional<knp::core::UID> &postsynaptic_uid = std::nullopt)
+    const std::optional<knp::core::UID> &postsynaptic_uid = std::nullopt,
+    size_t threads_count = bulk::default_threads_count)
 {
-    return knp::core::Projection<DestinationSynapseType>(
+    return bulk::make_projection<DestinationSynapseType>(
         presynaptic_uid.value_or(source_proj.get_presynaptic()),
         postsynaptic_uid.value_or(source_proj.get_postsynaptic()),
-        synapse_generators::clone_projection<DestinationSynapseType, SourceSynapseType>(source_proj, syn_gen),
-        source_proj.size());
+        [&source_proj, &syn_gen](size_t index) -> typename knp::core::Projection<DestinationSynapseType>::Synapse
+        {
+            const auto &synapse = source_proj[index];
+            return {
+                syn_gen(index), std::get<knp::core::source_neuron_id>(synapse),
+                std::get<knp::core::target_neuron_id>(synapse)};
+        },
+        source_proj.size(), threads_count);
 }
 
 }  // namespace creators
@@ -0,0 +1,162 @@
+/**
+ * @file procedural_rules.h
+ * @brief Connection rules for procedural projections.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <knp/core/procedural_projection.h>
+
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <boost/geometry/algorithms/distance.hpp>
+
+#include "synapse_parameters_generators.h"
+
+
+/**
+ * @brief Projection namespace.
+ */
+namespace knp::framework::projection
+{
+
+/**
+ * @brief Namespace for connection rules of procedural projections.
+ * @details Rules repeat the corresponding connectors, but generate synapses of one presynaptic neuron at a time.
+ * Synapse parameter generators are called every time synapses are generated, so they must be thread-safe and
+ * return the same parameters for the same neurons.
+ * @see core::ProceduralProjection.
+ */
+namespace procedural
+{
+
+/**
+ * @brief Make a rule that connects a presynaptic neuron to each postsynaptic neuron with a given probability.
+ * @details Postsynaptic neurons are skipped by geometrically distributed gaps, so the cost depends on the number of
+ * generated synapses rather than on the postsynaptic population size.
+ * @param postsynaptic_pop_size postsynaptic population neuron count.
+ * @param connection_probability probability of a connection.
+ * @param syn_gen generator of synapse parameters.
+ * @tparam SynapseType projection synapse type.
+ * @throw std::logic_error if the probability is not between 0 and 1.
+ * @return connection rule.
+ */
+template <typename SynapseType>
+[[nodiscard]] typename core::ProceduralProjection<SynapseType>::FanOutRule fixed_probability(
+    size_t postsynaptic_pop_size, double connection_probability,
+    parameters_generators::SynGen2ParamsType<SynapseType> syn_gen =
+        parameters_generators::default_synapse_gen<SynapseType>)
+{
+    if (connection_probability > 1 || connection_probability < 0)
+        throw std::logic_error("Incorrect probability, set probability between 0 and 1.");
+
+    return [postsynaptic_pop_size, connection_probability, syn_gen = std::move(syn_gen)](
+               size_t index0, core::Philox4x32 &rng, auto &synapses)
+    {
+        if (connection_probability == 0) return;
+        std::uniform_real_distribution<double> dist(0, 1);
+        const double log_rejection = std::log1p(-connection_probability);
+
+        for (size_t index1 = 0; index1 < postsynaptic_pop_size; ++index1)
+        {
+            // Number of rejected neurons before the next accepted one has the geometric distribution.
+            const double gap = connection_probability < 1 ? std::floor(std::log(1 - dist(rng)) / log_rejection) : 0;
+            if (gap >= static_cast<double>(postsynaptic_pop_size - index1)) break;
+            index1 += static_cast<size_t>(gap);
+            synapses.emplace_back(syn_gen(index0, index1), index0, index1);
+        }
+    };
+}
+
+
+/**
+ * @brief Make a rule that connects a presynaptic neuron to a fixed number of random postsynaptic neurons.
+ * @details Postsynaptic neurons are chosen with replacement, as in the `fixed_number_post` connector.
+ * @param postsynaptic_pop_size postsynaptic population neuron count.
+ * @param neurons_count number of postsynaptic neurons.
+ * @param syn_gen generator of synapse parameters.
+ * @tparam SynapseType projection synapse type.
+ * @return connection rule.
+ */
+template <typename SynapseType>
+[[nodiscard]] typename core::ProceduralProjection<SynapseType>::FanOutRule fixed_number_post(
+    size_t postsynaptic_pop_size, size_t neurons_count,
+    parameters_generators::SynGen2ParamsType<SynapseType> syn_gen =
+        parameters_generators::default_synapse_gen<SynapseType>)
+{
+    return [postsynaptic_pop_size, neurons_count, syn_gen = std::move(syn_gen)](
+               size_t index0, core::Philox4x32 &rng, auto &synapses)
+    {
+        if (!postsynaptic_pop_size) return;
+        std::uniform_int_distribution<size_t> dist(0, postsynaptic_pop_size - 1);
+        synapses.reserve(neurons_count);
+        for (size_t i = 0; i < neurons_count; ++i)
+        {
+            const size_t index1 = dist(rng);
+            synapses.emplace_back(syn_gen(index0, index1), index0, index1);
+        }
+    };
+}
+
+
+/**
+ * @brief Make a rule that connects neurons with a probability depending on the distance between them.
+ * @details The rule compares a presynaptic neuron with every postsynaptic neuron.
+ * @param presynaptic_coordinates coordinates of presynaptic neurons.
+ * @param postsynaptic_coordinates coordinates of postsynaptic neurons.
+ * @param probability function that returns probability of a connection for a given distance.
+ * @param syn_gen generator of synapse parameters.
+ * @tparam SynapseType projection synapse type.
+ * @tparam Coordinate type of coordinates, for example `coordinates::cartesian::d2::coordinate<float>`.
+ * @return connection rule.
+ */
+template <typename SynapseType, typename Coordinate>
+[[nodiscard]] typename core::ProceduralProjection<SynapseType>::FanOutRule distance_based(
+    std::vector<Coordinate> presynaptic_coordinates, std::vector<Coordinate> postsynaptic_coordinates,
+    std::function<double(double)> probability,
+    parameters_generators::SynGen2ParamsType<SynapseType> syn_gen =
+        parameters_generators::default_synapse_gen<SynapseType>)
+{
+    // Rule copies share coordinates.
+    auto pre = std::make_shared<const std::vector<Coordinate>>(std::move(presynaptic_coordinates));
+    auto post = std::make_shared<const std::vector<Coordinate>>(std::move(postsynaptic_coordinates));
+
+    return [pre, post, probability = std::move(probability), syn_gen = std::move(syn_gen)](
+               size_t index0, core::Philox4x32 &rng, auto &synapses)
+    {
+        if (index0 >= pre->size()) return;
+        std::uniform_real_distribution<double> dist(0, 1);
+        for (size_t index1 = 0; index1 < post->size(); ++index1)
+        {
+            const double connection_probability =
+                probability(static_cast<double>(boost::geometry::distance((*pre)[index0], (*post)[index1])));
+            // A random number is taken for each pair, so that changing the function doesn't shift other pairs.
+            if (dist(rng) < connection_probability) synapses.emplace_back(syn_gen(index0, index1), index0, index1);
+        }
+    };
+}
+
+}  // namespace procedural
+
+}  // namespace knp::framework::projection
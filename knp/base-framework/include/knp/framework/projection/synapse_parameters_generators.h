@@ -75,6 +75,41 @@ typename knp::core::Projection<SynapseType>::SynapseParameters default_synapse_g
 }
 
 
+/**
+ * @brief The DefaultSynapseGen class is a definition of a synapse generator that makes default synapse parameters.
+ * @details Unlike `default_synapse_gen()`, the generator can be called with one or two indexes and can be inlined
+ * by projection creators.
+ * @tparam SynapseType synapse type.
+ */
+template <typename SynapseType>
+class DefaultSynapseGen
+{
+public:
+    /**
+     * @brief Type of the synapse parameters.
+     */
+    using SynapseParametersType = typename knp::core::Projection<SynapseType>::SynapseParameters;
+
+    /**
+     * @brief Generation operator.
+     * @return default synapse parameters.
+     */
+    SynapseParametersType operator()(size_t) const  // NOLINT
+    {
+        return SynapseParametersType();
+    }
+
+    /**
+     * @brief Generation operator.
+     * @return default synapse parameters.
+     */
+    SynapseParametersType operator()(size_t, size_t) const  // NOLINT
+    {
+        return SynapseParametersType();
+    }
+};
+
+
 /**
  * @brief The CopySynapseGen class is a definition of a synapse generator that copies parameters of the specified synapse.
  * @tparam SynapseType synapse type.
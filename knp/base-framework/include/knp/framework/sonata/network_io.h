@@ -23,6 +23,7 @@
 #include <knp/core/impexp.h>
 #include <knp/framework/network.h>
 
+#include <cstddef>
 #include <filesystem>
 
 /**
@@ -30,15 +31,85 @@
  */
 namespace knp::framework::sonata
 {
+/**
+ * @brief The SaveOptions structure defines how projection datasets are written to HDF5 files.
+ * @details Default values reproduce the plain SONATA layout: contiguous datasets without filters.
+ */
+struct SaveOptions
+{
+    /**
+     * @brief Number of dataset elements in a single HDF5 chunk.
+     * @details `0` means contiguous layout unless a filter or compact constant datasets are requested: in this case
+     * `default_chunk_size` is used.
+     */
+    size_t chunk_size_ = 0;
+
+    /**
+     * @brief Deflate (gzip) compression level from `1` to `9`. `0` disables compression.
+     */
+    unsigned compression_level_ = 0;
+
+    /**
+     * @brief Apply the shuffle filter before compression.
+     * @note Shuffle improves compression ratio of integer indexes and floating-point weights.
+     */
+    bool shuffle_ = false;
+
+    /**
+     * @brief Write datasets that contain a single repeated value (for example, `edge_type_id`) as chunked datasets
+     * with a fill value and no allocated data.
+     */
+    bool compact_constant_datasets_ = false;
+
+    /**
+     * @brief Extract per-field columns of a projection in parallel threads.
+     * @note HDF5 calls are always made from the calling thread.
+     */
+    bool parallel_ = false;
+
+    /**
+     * @brief Chunk size used when chunking is required but `chunk_size_` is `0`.
+     */
+    static constexpr size_t default_chunk_size = 65536;
+};
+
+
+/**
+ * @brief The LoadOptions structure defines how a network is loaded from SONATA files.
+ */
+struct LoadOptions
+{
+    /**
+     * @brief Defer loading of projection synapses.
+     * @details Loaded projections contain only UIDs and attributes, their synapses are read from the HDF5 file when
+     * a backend loads the projections or when `Projection::load_synapses()` is called. This way synapses are stored in
+     * memory once, by the backend. Projections of `core::InferenceProjections` are always loaded at once.
+     * @note The network files must not be changed or removed until projection synapses are loaded.
+     */
+    bool lazy_projections_ = false;
+};
+
+
 /**
  * @brief Save network to disk.
- * @note The network is saved in the SONATA format.
+ * @note The network is saved in the SONATA format. Synapses of inference projections are saved as edges, and the
+ * projection type is saved as the `projection_type` attribute of the projection group.
  * @param network network to save.
  * @param dir directory to save the network.
  */
 KNP_DECLSPEC void save_network(const Network &network, const std::filesystem::path &dir);
 
 
+/**
+ * @brief Save network to disk using the specified dataset layout.
+ * @note The network is saved in the SONATA format. Chunked and compressed datasets are readable by any HDF5 client.
+ * @param network network to save.
+ * @param dir directory to save the network.
+ * @param options dataset layout and compression options.
+ */
+KNP_DECLSPEC void save_network(const Network &network, const std::filesystem::path &dir, const SaveOptions &options);
+
+
 /**
  * @brief Load network from disk.
  * @param config_path path to network configuration file.
@@ -46,4 +117,13 @@ KNP_DECLSPEC void save_network(const Network &network, const std::filesystem::pa
  */
 KNP_DECLSPEC Network load_network(const std::filesystem::path &config_path);
 
+
+/**
+ * @brief Load network from disk.
+ * @param config_path path to network configuration file.
+ * @param options load options.
+ * @return loaded network.
+ */
+KNP_DECLSPEC Network load_network(const std::filesystem::path &config_path, const LoadOptions &options);
+
 }  // namespace knp::framework::sonata
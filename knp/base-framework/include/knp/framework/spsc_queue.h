@@ -0,0 +1,166 @@
+/**
+ * @file spsc_queue.h
+ * @brief Lock-free single-producer single-consumer queue.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+/**
+ * @brief Framework namespace.
+ */
+namespace knp::framework
+{
+/**
+ * @brief The SPSCQueue class is a definition of a bounded lock-free queue for exchanging values between exactly
+ * one producer thread and one consumer thread.
+ * @tparam T value type.
+ */
+template <class T>
+class SPSCQueue
+{
+public:
+    /**
+     * @brief Queue constructor.
+     * @param capacity maximum number of values in the queue.
+     * @throw std::invalid_argument if capacity is `0`.
+     */
+    explicit SPSCQueue(size_t capacity) : buffer_(capacity + 1)
+    {
+        if (!capacity) throw std::invalid_argument("Queue capacity must be greater than 0.");
+    }
+
+    /**
+     * @brief Deleted copy constructor.
+     */
+    SPSCQueue(const SPSCQueue &) = delete;
+
+    /**
+     * @brief Deleted copy operator.
+     */
+    SPSCQueue &operator=(const SPSCQueue &) = delete;
+
+public:
+    /**
+     * @brief Put a value to the queue.
+     * @note Must be called from the producer thread only.
+     * @param value value to put. The value is moved only if the method returns `true`.
+     * @return `true` if the value was put, `false` if the queue is full.
+     */
+    bool try_push(T &&value)
+    {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t next_tail = next(tail);
+        if (next_tail == head_.load(std::memory_order_acquire)) return false;
+        buffer_[tail] = std::move(value);
+        tail_.store(next_tail, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Get a value from the queue.
+     * @note Must be called from the consumer thread only.
+     * @param value variable that receives the value.
+     * @return `true` if a value was received, `false` if the queue is empty.
+     */
+    bool try_pop(T &value)
+    {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) return false;
+        value = std::move(buffer_[head]);
+        head_.store(next(head), std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Determine if the queue is empty.
+     * @note The result is exact only if neither producer nor consumer is running.
+     * @return `true` if the queue is empty.
+     */
+    [[nodiscard]] bool empty() const
+    {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Get maximum number of values in the queue.
+     * @return queue capacity.
+     */
+    [[nodiscard]] size_t capacity() const { return buffer_.size() - 1; }
+
+private:
+    [[nodiscard]] size_t next(size_t index) const { return index + 1 == buffer_.size() ? 0 : index + 1; }
+
+private:
+    std::vector<T> buffer_;
+    // Producer and consumer indexes are placed into different cache lines to avoid false sharing.
+    alignas(64) std::atomic<size_t> head_ = 0;
+    alignas(64) std::atomic<size_t> tail_ = 0;
+};
+
+
+/**
+ * @brief The Backoff class is a definition of a waiting strategy for a thread polling a lock-free queue.
+ * @details The thread yields first, then sleeps with exponentially growing intervals.
+ */
+class Backoff
+{
+public:
+    /**
+     * @brief Wait before the next polling attempt.
+     */
+    void wait()
+    {
+        if (attempt_ < yield_attempts)
+        {
+            ++attempt_;
+            std::this_thread::yield();
+            return;
+        }
+        std::this_thread::sleep_for(sleep_time_);
+        sleep_time_ = std::min(sleep_time_ * 2, max_sleep_time);
+    }
+
+    /**
+     * @brief Reset waiting strategy after a successful attempt.
+     */
+    void reset()
+    {
+        attempt_ = 0;
+        sleep_time_ = min_sleep_time;
+    }
+
+private:
+    static constexpr size_t yield_attempts = 64;
+    static constexpr std::chrono::microseconds min_sleep_time{1};
+    static constexpr std::chrono::microseconds max_sleep_time{1000};
+
+    size_t attempt_ = 0;
+    std::chrono::microseconds sleep_time_ = min_sleep_time;
+};
+
+}  // namespace knp::framework
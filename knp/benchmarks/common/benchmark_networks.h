@@ -0,0 +1,144 @@
+/**
+ * @file benchmark_networks.h
+ * @brief Synthetic networks and helpers for benchmarks.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <knp/backends/cpu-multi-threaded/backend.h>
+#include <knp/backends/cpu-single-threaded/backend.h>
+#include <knp/core/messaging/messaging.h>
+#include <knp/core/population.h>
+#include <knp/core/projection.h>
+#include <knp/framework/projection/creators.h>
+#include <knp/neuron-traits/blifat.h>
+#include <knp/synapse-traits/delta.h>
+
+#include <random>
+#include <vector>
+
+
+/**
+ * @brief Benchmarks namespace.
+ */
+namespace knp::benchmarks
+{
+using DeltaProjection = knp::core::Projection<knp::synapse_traits::DeltaSynapse>;
+using BLIFATPopulation = knp::core::Population<knp::neuron_traits::BLIFATNeuron>;
+
+
+// Backends with public initialization, the same way as in tests.
+class STBenchmarkBackend : public knp::backends::single_threaded_cpu::SingleThreadedCPUBackend
+{
+public:
+    void _init() override { knp::backends::single_threaded_cpu::SingleThreadedCPUBackend::_init(); }
+};
+
+
+class MTBenchmarkBackend : public knp::backends::multi_threaded_cpu::MultiThreadedCPUBackend
+{
+public:
+    explicit MTBenchmarkBackend(size_t thread_count) : MultiThreadedCPUBackend(thread_count) {}
+    void _init() override { knp::backends::multi_threaded_cpu::MultiThreadedCPUBackend::_init(); }
+};
+
+
+// Excitatory synapses with delays from 1 to 4 steps.
+inline DeltaProjection::SynapseParameters make_synapse_parameters(size_t from_index, size_t to_index)
+{
+    return DeltaProjection::SynapseParameters{
+        0.5F, static_cast<uint32_t>(1 + (from_index + to_index) % 4), knp::synapse_traits::OutputType::EXCITATORY};
+}
+
+
+// Projection with `fan_in` random presynaptic neurons for each postsynaptic neuron.
+inline DeltaProjection make_random_projection(
+    const knp::core::UID &presynaptic_uid, const knp::core::UID &postsynaptic_uid, size_t presynaptic_size,
+    size_t postsynaptic_size, size_t fan_in)
+{
+    return knp::framework::projection::creators::fixed_number_pre<knp::synapse_traits::DeltaSynapse>(
+        presynaptic_uid, postsynaptic_uid, presynaptic_size, postsynaptic_size, fan_in, make_synapse_parameters);
+}
+
+
+// Spike message with neurons chosen with the given probability.
+inline knp::core::messaging::SpikeMessage make_random_spikes(
+    const knp::core::UID &sender_uid, knp::core::Step step, size_t neurons_count, double rate, std::mt19937 &engine)
+{
+    std::bernoulli_distribution distribution(rate);
+    knp::core::messaging::SpikeMessage message{{sender_uid, step}, {}};
+    for (uint32_t index = 0; index < neurons_count; ++index)
+    {
+        if (distribution(engine)) message.neuron_indexes_.push_back(index);
+    }
+    return message;
+}
+
+
+/**
+ * @brief The RecurrentNetwork class is a definition of a benchmark network: a random input drives a population
+ * with random recurrent connections.
+ * @tparam Backend backend type.
+ */
+template <class Backend>
+class RecurrentNetwork
+{
+public:
+    template <typename... BackendArgs>
+    RecurrentNetwork(size_t neurons_count, size_t fan_in, double input_rate, BackendArgs... backend_args)
+        : backend_(backend_args...), neurons_count_(neurons_count), input_rate_(input_rate), engine_(0)
+    {
+        BLIFATPopulation population{
+            [](size_t) { return knp::neuron_traits::neuron_parameters<knp::neuron_traits::BLIFATNeuron>{}; },
+            neurons_count};
+        auto input_projection = knp::framework::projection::creators::one_to_one<knp::synapse_traits::DeltaSynapse>(
+            knp::core::UID{false}, population.get_uid(), neurons_count,
+            [](size_t) {
+                return DeltaProjection::SynapseParameters{1.0F, 1, knp::synapse_traits::OutputType::EXCITATORY};
+            });
+        auto recurrent_projection =
+            make_random_projection(population.get_uid(), population.get_uid(), neurons_count, neurons_count, fan_in);
+        const auto input_uid = input_projection.get_uid();
+
+        backend_.load_populations({population});
+        backend_.load_projections({input_projection, recurrent_projection});
+        backend_._init();
+        backend_.template subscribe<knp::core::messaging::SpikeMessage>(input_uid, {input_channel_uid_});
+    }
+
+    // Send random input and make a backend step.
+    void step()
+    {
+        endpoint_.send_message(
+            make_random_spikes(input_channel_uid_, backend_.get_step(), neurons_count_, input_rate_, engine_));
+        backend_._step();
+    }
+
+    Backend &get_backend() { return backend_; }
+
+private:
+    Backend backend_;
+    knp::core::MessageEndpoint endpoint_{backend_.get_message_bus().create_endpoint()};
+    const knp::core::UID input_channel_uid_;
+    size_t neurons_count_;
+    double input_rate_;
+    std::mt19937 engine_;
+};
+
+}  // namespace knp::benchmarks
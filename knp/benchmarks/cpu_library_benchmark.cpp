@@ -0,0 +1,115 @@
+/**
+ * @file cpu_library_benchmark.cpp
+ * @brief CPU backend calculation benchmarks.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <knp/backends/cpu-library/blifat_population.h>
+#include <knp/backends/cpu-library/delta_synapse_projection.h>
+
+#include <benchmark/benchmark.h>
+#include <benchmark_networks.h>
+
+#include <random>
+#include <vector>
+
+
+namespace kb = knp::benchmarks;
+
+
+// Arguments: population size.
+static void cpu_calculate_neurons_state_part(benchmark::State &state)
+{
+    const auto neurons_count = static_cast<size_t>(state.range(0));
+    kb::BLIFATPopulation population{
+        [](size_t) { return knp::neuron_traits::neuron_parameters<knp::neuron_traits::BLIFATNeuron>{}; },
+        neurons_count};
+
+    for (auto _ : state)
+    {
+        knp::backends::cpu::calculate_neurons_state_part(population, 0, neurons_count);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(neurons_count));
+}
+BENCHMARK(cpu_calculate_neurons_state_part)->Arg(1000)->Arg(100000);
+
+
+// Arguments: population size, fan-in, presynaptic firing rate in percents.
+static void cpu_calculate_delta_synapse_projection_data(benchmark::State &state)
+{
+    const auto neurons_count = static_cast<size_t>(state.range(0));
+    auto projection = kb::make_random_projection(
+        knp::core::UID{}, knp::core::UID{}, neurons_count, neurons_count, static_cast<size_t>(state.range(1)));
+    std::mt19937 engine(0);
+    const auto spikes = kb::make_random_spikes(
+        projection.get_presynaptic(), 0, neurons_count, static_cast<double>(state.range(2)) / 100, engine);
+
+    knp::backends::cpu::MessageQueue future_messages;
+    std::vector<size_t> activated_synapses;
+    knp::core::Step step = 1;
+    for (auto _ : state)
+    {
+        std::vector<knp::core::messaging::SpikeMessage> messages{spikes};
+        knp::backends::cpu::calculate_delta_synapse_projection_data(
+            projection, messages, future_messages, step, activated_synapses);
+        future_messages.erase(step);
+        ++step;
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(spikes.neuron_indexes_.size()));
+}
+BENCHMARK(cpu_calculate_delta_synapse_projection_data)->Args({10000, 100, 1})->Args({10000, 100, 10});
+
+
+// Compare fan-out and dense kernels to find the `dense_kernel_crossover` spike density.
+// Arguments: kernel (0 is fan-out, 1 is dense), presynaptic firing rate in tenths of a percent.
+static void cpu_projection_kernel(benchmark::State &state)
+{
+    // Projection of 200000 synapses with a fan-out of 100.
+    const size_t neurons_count = 2000;
+    auto projection =
+        kb::make_random_projection(knp::core::UID{}, knp::core::UID{}, neurons_count, neurons_count, 100);
+    const bool dense = state.range(0) != 0;
+    std::mt19937 engine(0);
+    const auto spikes = kb::make_random_spikes(
+        projection.get_presynaptic(), 0, neurons_count, static_cast<double>(state.range(1)) / 1000, engine);
+
+    knp::backends::cpu::MessageQueue future_messages;
+    std::vector<uint32_t> spike_mask;
+    std::vector<size_t> activated_synapses;
+    knp::core::Step step = 1;
+    for (auto _ : state)
+    {
+        std::vector<knp::core::messaging::SpikeMessage> messages{spikes};
+        if (dense)
+        {
+            knp::backends::cpu::calculate_delta_synapse_projection_dense_data(
+                projection, messages, future_messages, step, spike_mask);
+        }
+        else
+        {
+            knp::backends::cpu::calculate_delta_synapse_projection_data(
+                projection, messages, future_messages, step, activated_synapses);
+        }
+        future_messages.erase(step);
+        ++step;
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(spikes.neuron_indexes_.size() * 100));
+}
+BENCHMARK(cpu_projection_kernel)->ArgsProduct({{0, 1}, {5, 10, 20, 30, 40, 60, 100}});
@@ -0,0 +1,87 @@
+/**
+ * @file message_bus_benchmark.cpp
+ * @brief Message bus and serialization benchmarks.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <knp/core/message_bus.h>
+#include <knp/core/messaging/message_envelope.h>
+#include <knp/core/messaging/messaging.h>
+
+#include <benchmark/benchmark.h>
+#include <benchmark_networks.h>
+
+#include <random>
+
+
+namespace kb = knp::benchmarks;
+
+
+// Route a spike message from one endpoint to another. Arguments: number of spikes in a message.
+static void route_spike_message(benchmark::State &state, knp::core::MessageBus (*make_bus)())
+{
+    auto bus = make_bus();
+    auto sender = bus.create_endpoint();
+    auto receiver = bus.create_endpoint();
+    std::mt19937 engine(0);
+    const knp::core::UID sender_uid;
+    const auto message = kb::make_random_spikes(sender_uid, 0, static_cast<size_t>(state.range(0)), 1.0, engine);
+    auto &subscription = receiver.subscribe<knp::core::messaging::SpikeMessage>(knp::core::UID{}, {sender_uid});
+
+    for (auto _ : state)
+    {
+        sender.send_message(message);
+        bus.route_messages();
+        receiver.receive_all_messages();
+        subscription.clear_messages();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_CAPTURE(route_spike_message, cpu, &knp::core::MessageBus::construct_cpu_bus)->Arg(10)->Arg(10000);
+BENCHMARK_CAPTURE(route_spike_message, zmq, &knp::core::MessageBus::construct_zmq_bus)->Arg(10)->Arg(10000);
+
+
+// Arguments: number of spikes in a message.
+static void pack_spike_message(benchmark::State &state)
+{
+    std::mt19937 engine(0);
+    const auto message = kb::make_random_spikes(knp::core::UID{}, 0, static_cast<size_t>(state.range(0)), 1.0, engine);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(knp::core::messaging::pack_to_envelope(message));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(pack_spike_message)->Arg(10)->Arg(10000);
+
+
+static void unpack_spike_message(benchmark::State &state)
+{
+    std::mt19937 engine(0);
+    const auto buffer = knp::core::messaging::pack_to_envelope(
+        kb::make_random_spikes(knp::core::UID{}, 0, static_cast<size_t>(state.range(0)), 1.0, engine));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(knp::core::messaging::extract_from_envelope(buffer));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(unpack_spike_message)->Arg(10)->Arg(10000);
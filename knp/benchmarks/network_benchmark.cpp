@@ -0,0 +1,75 @@
+/**
+ * @file network_benchmark.cpp
+ * @brief End-to-end network benchmarks.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <benchmark/benchmark.h>
+#include <benchmark_networks.h>
+
+
+namespace kb = knp::benchmarks;
+
+
+namespace
+{
+template <class Network>
+void run_network(benchmark::State &state, Network &network)
+{
+    // Let network activity settle before measurement.
+    for (int step = 0; step < 10; ++step) network.step();
+
+    network.get_backend().enable_profiling();
+    for (auto _ : state) network.step();
+
+    const auto profile = network.get_backend().get_profile();
+    state.SetItemsProcessed(state.iterations());
+    state.counters["spikes_per_step"] = benchmark::Counter(
+        static_cast<double>(profile.spikes_emitted_) / static_cast<double>(state.iterations()));
+    state.counters["impacts_per_step"] = benchmark::Counter(
+        static_cast<double>(profile.impacts_sent_) / static_cast<double>(state.iterations()));
+}
+}  // namespace
+
+
+// Arguments: population size, fan-in, input firing rate in percents.
+static void network_single_threaded(benchmark::State &state)
+{
+    kb::RecurrentNetwork<kb::STBenchmarkBackend> network(
+        static_cast<size_t>(state.range(0)), static_cast<size_t>(state.range(1)),
+        static_cast<double>(state.range(2)) / 100);
+    run_network(state, network);
+}
+BENCHMARK(network_single_threaded)
+    ->ArgsProduct({{1000, 10000}, {10, 100}, {1, 5}})
+    ->Unit(benchmark::kMicrosecond);
+
+
+// Arguments: population size, fan-in, input firing rate in percents, thread count.
+static void network_multi_threaded(benchmark::State &state)
+{
+    kb::RecurrentNetwork<kb::MTBenchmarkBackend> network(
+        static_cast<size_t>(state.range(0)), static_cast<size_t>(state.range(1)),
+        static_cast<double>(state.range(2)) / 100, static_cast<size_t>(state.range(3)));
+    run_network(state, network);
+}
+BENCHMARK(network_multi_threaded)
+    ->ArgsProduct({{10000}, {100}, {1, 5}, {1, 2, 4}})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
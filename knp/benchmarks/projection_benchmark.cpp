@@ -0,0 +1,145 @@
+/**
+ * @file projection_benchmark.cpp
+ * @brief Projection benchmarks.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <knp/core/projection.h>
+
+#include <benchmark/benchmark.h>
+#include <benchmark_networks.h>
+
+#include <optional>
+#include <random>
+#include <vector>
+
+
+namespace kb = knp::benchmarks;
+
+
+// Arguments: presynaptic population size, fan-in.
+static void projection_find_synapses(benchmark::State &state)
+{
+    const auto neurons_count = static_cast<size_t>(state.range(0));
+    auto projection = kb::make_random_projection(
+        knp::core::UID{}, knp::core::UID{}, neurons_count, neurons_count, static_cast<size_t>(state.range(1)));
+    // Build index before measurement.
+    benchmark::DoNotOptimize(projection.find_synapses(0, kb::DeltaProjection::Search::by_presynaptic));
+
+    size_t neuron_index = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(
+            projection.find_synapses(neuron_index, kb::DeltaProjection::Search::by_presynaptic));
+        neuron_index = (neuron_index + 1) % neurons_count;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(projection_find_synapses)->Args({1000, 100})->Args({10000, 100})->Args({10000, 1000});
+
+
+// Make synapses that connect random neurons of populations of the given size.
+static std::vector<kb::DeltaProjection::Synapse> make_random_synapses(size_t neurons_count, size_t synapses_count)
+{
+    std::mt19937 engine{0};
+    std::uniform_int_distribution<size_t> distribution(0, neurons_count - 1);
+    std::vector<kb::DeltaProjection::Synapse> synapses;
+    synapses.reserve(synapses_count);
+    for (size_t i = 0; i < synapses_count; ++i)
+    {
+        const size_t from_index = distribution(engine);
+        const size_t to_index = distribution(engine);
+        synapses.emplace_back(kb::make_synapse_parameters(from_index, to_index), from_index, to_index);
+    }
+    return synapses;
+}
+
+
+// Add a batch of synapses to an indexed projection and search it, the index is updated incrementally.
+// Arguments: population size, fan-in, number of added synapses.
+static void projection_add_synapses_incremental(benchmark::State &state)
+{
+    const auto neurons_count = static_cast<size_t>(state.range(0));
+    const auto base = kb::make_random_projection(
+        knp::core::UID{}, knp::core::UID{}, neurons_count, neurons_count, static_cast<size_t>(state.range(1)));
+    const auto batch = make_random_synapses(neurons_count, static_cast<size_t>(state.range(2)));
+
+    // Projection is kept outside the loop, so its copying and destruction are not measured.
+    std::optional<kb::DeltaProjection> projection;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        projection.reset();
+        projection.emplace(base);
+        state.ResumeTiming();
+        projection->add_synapses([&batch](size_t index) { return batch[index]; }, batch.size());
+        benchmark::DoNotOptimize(projection->find_synapses(0, kb::DeltaProjection::Search::by_presynaptic));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batch.size()));
+}
+BENCHMARK(projection_add_synapses_incremental)
+    ->Args({10000, 100, 100})
+    ->Args({10000, 100, 10000})
+    ->Args({10000, 100, 1000000})
+    ->Unit(benchmark::kMillisecond);
+
+
+// Add the same batch of synapses to a projection without index and search it, the index is rebuilt from scratch.
+// Arguments: population size, fan-in, number of added synapses.
+static void projection_add_synapses_reindex(benchmark::State &state)
+{
+    const auto neurons_count = static_cast<size_t>(state.range(0));
+    const auto base = kb::make_random_projection(
+        knp::core::UID{}, knp::core::UID{}, neurons_count, neurons_count, static_cast<size_t>(state.range(1)));
+    const auto batch = make_random_synapses(neurons_count, static_cast<size_t>(state.range(2)));
+
+    std::optional<kb::DeltaProjection> projection;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        // Synapses added to an empty projection are not indexed until the first search.
+        projection.reset();
+        projection.emplace(base.get_presynaptic(), base.get_postsynaptic());
+        projection->add_synapses([&base](size_t index) { return base[index]; }, base.size());
+        state.ResumeTiming();
+        projection->add_synapses([&batch](size_t index) { return batch[index]; }, batch.size());
+        benchmark::DoNotOptimize(projection->find_synapses(0, kb::DeltaProjection::Search::by_presynaptic));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batch.size()));
+}
+BENCHMARK(projection_add_synapses_reindex)
+    ->Args({10000, 100, 100})
+    ->Args({10000, 100, 10000})
+    ->Args({10000, 100, 1000000})
+    ->Unit(benchmark::kMillisecond);
+
+
+static void projection_creation(benchmark::State &state)
+{
+    const auto neurons_count = static_cast<size_t>(state.range(0));
+    const auto fan_in = static_cast<size_t>(state.range(1));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(
+            kb::make_random_projection(knp::core::UID{}, knp::core::UID{}, neurons_count, neurons_count, fan_in));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(neurons_count * fan_in));
+}
+BENCHMARK(projection_creation)->Args({1000, 100})->Args({10000, 100})->Unit(benchmark::kMillisecond);
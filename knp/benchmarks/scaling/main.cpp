@@ -0,0 +1,287 @@
+/**
+ * @file main.cpp
+ * @brief Throughput and scaling harness for synthetic networks.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/backends/cpu-multi-threaded/backend.h>
+#include <knp/framework/backend_loader.h>
+#include <knp/framework/model.h>
+#include <knp/framework/model_executor.h>
+#include <knp/framework/sonata/network_io.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include "network_generators.h"
+
+#if defined(_WIN32)
+#    define NOMINMAX
+#    include <windows.h>
+// `windows.h` must be included first.
+#    include <psapi.h>
+#else
+#    include <sys/resource.h>
+#endif
+
+
+namespace po = boost::program_options;
+namespace ks = knp::benchmarks::scaling;
+
+
+namespace
+{
+/**
+ * @brief Results of a network run.
+ */
+struct RunResult
+{
+    size_t threads_count_ = 0;
+    size_t neurons_count_ = 0;
+    double seconds_ = 0;
+    double steps_per_second_ = 0;
+    double spikes_per_second_ = 0;
+    double events_per_second_ = 0;
+    size_t peak_rss_kb_ = 0;
+};
+
+
+// Peak resident set size of the process in kilobytes.
+size_t get_peak_rss_kb()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+    return counters.PeakWorkingSetSize / 1024;
+#else
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#    if defined(__APPLE__)
+    // macOS reports bytes.
+    return static_cast<size_t>(usage.ru_maxrss) / 1024;
+#    else
+    return static_cast<size_t>(usage.ru_maxrss);
+#    endif
+#endif
+}
+
+
+// Run a network and measure its throughput. Synaptic events are impacts sent by projections.
+RunResult run_network(
+    ks::GeneratedNetwork generated, std::shared_ptr<knp::core::Backend> backend, size_t steps, size_t warmup_steps,
+    double input_rate, unsigned seed)
+{
+    const knp::core::UID input_channel_uid;
+    const size_t input_size = generated.input_size_;
+    const auto input_projections = generated.input_projections_;
+    const size_t neurons_count = generated.neurons_count_;
+
+    knp::framework::Model model(std::move(generated.network_));
+    for (const auto &projection_uid : input_projections) model.add_input_channel(input_channel_uid, projection_uid);
+
+    auto engine = std::make_shared<std::mt19937>(seed);
+    auto input_gen = [engine, input_size, input_rate](knp::core::Step) -> knp::core::messaging::SpikeData
+    {
+        std::bernoulli_distribution distribution(input_rate);
+        knp::core::messaging::SpikeData spikes;
+        for (uint32_t index = 0; index < input_size; ++index)
+        {
+            if (distribution(*engine)) spikes.push_back(index);
+        }
+        return spikes;
+    };
+
+    knp::framework::ModelExecutor executor(model, backend, {{input_channel_uid, input_gen}});
+
+    // Let network activity settle before measurement.
+    executor.start([warmup_steps](knp::core::Step step) { return step < warmup_steps; });
+
+    executor.enable_profiling();
+    const auto start_time = std::chrono::steady_clock::now();
+    executor.start([last_step = warmup_steps + steps](knp::core::Step step) { return step < last_step; });
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+    const auto profile = executor.get_profile();
+
+    RunResult result;
+    result.neurons_count_ = neurons_count;
+    result.seconds_ = elapsed.count();
+    result.steps_per_second_ = static_cast<double>(steps) / result.seconds_;
+    result.spikes_per_second_ = static_cast<double>(profile.spikes_emitted_) / result.seconds_;
+    result.events_per_second_ = static_cast<double>(profile.impacts_sent_) / result.seconds_;
+    result.peak_rss_kb_ = get_peak_rss_kb();
+    return result;
+}
+
+
+void print_header(bool with_scaling)
+{
+    std::cout << "threads,neurons,seconds,steps_per_s,spikes_per_s,synaptic_events_per_s,peak_rss_kb";
+    if (with_scaling) std::cout << ",speedup,efficiency";
+    std::cout << std::endl;
+}
+
+
+void print_result(const RunResult &result, const RunResult *baseline, bool weak_scaling)
+{
+    std::cout << result.threads_count_ << ',' << result.neurons_count_ << ',' << std::fixed << std::setprecision(4)
+              << result.seconds_ << ',' << std::setprecision(1) << result.steps_per_second_ << ','
+              << result.spikes_per_second_ << ',' << result.events_per_second_ << ',' << result.peak_rss_kb_;
+
+    if (baseline)
+    {
+        // Strong scaling: the same work is done faster. Weak scaling: more work is done in the same time.
+        const double speedup = weak_scaling ? result.events_per_second_ / baseline->events_per_second_
+                                            : baseline->seconds_ / result.seconds_;
+        const double efficiency = speedup * static_cast<double>(baseline->threads_count_) /
+                                  static_cast<double>(result.threads_count_);
+        std::cout << ',' << std::setprecision(3) << speedup << ',' << efficiency;
+    }
+    std::cout << std::endl;
+}
+
+
+std::vector<size_t> parse_threads(const std::string &threads)
+{
+    std::vector<size_t> result;
+    std::stringstream stream(threads);
+    std::string item;
+    while (std::getline(stream, item, ','))
+    {
+        if (!item.empty()) result.push_back(std::stoul(item));
+    }
+    return result;
+}
+}  // namespace
+
+
+// Generate a synthetic network and run it on a backend library, or run it on the multi-threaded backend
+// with different thread counts to get a scaling curve.
+int main(int argc, char **argv)
+{
+    ks::NetworkParameters parameters;
+    std::string backend_path, save_path, threads, scaling;
+    size_t steps = 0, warmup_steps = 0;
+    double input_rate = 0;
+    unsigned seed = 0;
+
+    po::options_description options;
+    options.add_options()("help,h", "Produce help message.")(
+        "network,n", po::value(&parameters.kind_)->default_value(parameters.kind_),
+        "Network kind: balanced, layered, all-to-all.")(
+        "neurons", po::value(&parameters.neurons_count_)->default_value(parameters.neurons_count_),
+        "Total number of neurons. In weak scaling mode, number of neurons per thread.")(
+        "fan-in", po::value(&parameters.fan_in_)->default_value(parameters.fan_in_),
+        "Number of presynaptic neurons of each neuron.")(
+        "layers", po::value(&parameters.layers_count_)->default_value(parameters.layers_count_),
+        "Number of layers of layered and all-to-all networks.")(
+        "weight", po::value(&parameters.weight_)->default_value(parameters.weight_), "Excitatory synapse weight.")(
+        "rate,r", po::value(&input_rate)->default_value(0.05), "Firing probability of input neurons at each step.")(
+        "steps,s", po::value(&steps)->default_value(1000), "Number of measured steps.")(
+        "warmup", po::value(&warmup_steps)->default_value(20), "Number of steps before measurement.")(
+        "seed", po::value(&seed)->default_value(0), "Input generator seed.")(
+        "backend,b", po::value(&backend_path), "Path to backend library to run the network on.")(
+        "scaling", po::value(&scaling)->default_value("strong"),
+        "Scaling mode for the multi-threaded backend: strong or weak.")(
+        "threads,t", po::value(&threads)->default_value("1,2,4,8"),
+        "Comma-separated thread counts of the multi-threaded backend, used if no backend library is set.")(
+        "save", po::value(&save_path), "Save the generated network to a directory in SONATA format.");
+
+    po::variables_map options_map;
+    try
+    {
+        po::store(po::parse_command_line(argc, argv, options), options_map);
+        po::notify(options_map);
+    }
+    catch (const po::error &e)
+    {
+        std::cerr << e.what() << std::endl << options << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (options_map.count("help"))
+    {
+        std::cout << options << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    if (steps == 0 || input_rate < 0 || input_rate > 1)
+    {
+        std::cerr << "Number of steps must be positive and input rate must be in [0, 1]." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (options_map.count("save"))
+    {
+        std::cerr << "Saving network to " << save_path << "..." << std::endl;
+        knp::framework::sonata::save_network(ks::make_network(parameters).network_, save_path);
+    }
+
+    // Run on a backend library.
+    if (options_map.count("backend"))
+    {
+        knp::framework::BackendLoader backend_loader;
+        auto result = run_network(
+            ks::make_network(parameters), backend_loader.load(backend_path), steps, warmup_steps, input_rate, seed);
+        print_header(false);
+        print_result(result, nullptr, false);
+        return EXIT_SUCCESS;
+    }
+
+    // Scaling curve of the multi-threaded backend.
+    const bool weak_scaling = ("weak" == scaling);
+    if (!weak_scaling && "strong" != scaling)
+    {
+        std::cerr << "Unknown scaling mode \"" << scaling << "\"." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const auto threads_counts = parse_threads(threads);
+    if (threads_counts.empty())
+    {
+        std::cerr << "No thread counts set." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Peak RSS is reported for the whole process, so it doesn't decrease from run to run.
+    print_header(true);
+    std::vector<RunResult> results;
+    for (const auto threads_count : threads_counts)
+    {
+        auto run_parameters = parameters;
+        if (weak_scaling) run_parameters.neurons_count_ = parameters.neurons_count_ * threads_count;
+
+        auto result = run_network(
+            ks::make_network(run_parameters),
+            std::make_shared<knp::backends::multi_threaded_cpu::MultiThreadedCPUBackend>(threads_count), steps,
+            warmup_steps, input_rate, seed);
+        result.threads_count_ = threads_count;
+        results.push_back(result);
+        print_result(result, &results.front(), weak_scaling);
+    }
+
+    return EXIT_SUCCESS;
+}
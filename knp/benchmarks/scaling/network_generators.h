@@ -0,0 +1,291 @@
+/**
+ * @file network_generators.h
+ * @brief Generators of synthetic scalable networks.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <knp/core/population.h>
+#include <knp/core/projection.h>
+#include <knp/framework/network.h>
+#include <knp/framework/population/creators.h>
+#include <knp/framework/projection/creators.h>
+#include <knp/neuron-traits/blifat.h>
+#include <knp/synapse-traits/delta.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+/**
+ * @brief Scaling harness namespace.
+ */
+namespace knp::benchmarks::scaling
+{
+using DeltaProjection = knp::core::Projection<knp::synapse_traits::DeltaSynapse>;
+using BLIFATPopulation = knp::core::Population<knp::neuron_traits::BLIFATNeuron>;
+
+
+/**
+ * @brief Network parameters.
+ */
+struct NetworkParameters
+{
+    /**
+     * @brief Network kind: `balanced`, `layered` or `all-to-all`.
+     */
+    std::string kind_ = "balanced";
+
+    /**
+     * @brief Total number of neurons in all populations.
+     */
+    size_t neurons_count_ = 10000;
+
+    /**
+     * @brief Number of presynaptic neurons of each neuron. Not used by `all-to-all` networks.
+     */
+    size_t fan_in_ = 100;
+
+    /**
+     * @brief Number of layers of `layered` and `all-to-all` networks.
+     */
+    size_t layers_count_ = 3;
+
+    /**
+     * @brief Weight of excitatory synapses.
+     * @details Inhibitory synapses of balanced networks have weight multiplied by `inhibition_ratio_`.
+     */
+    float weight_ = 0.1F;
+
+    /**
+     * @brief Ratio of inhibitory to excitatory weights in balanced networks.
+     */
+    float inhibition_ratio_ = 4.0F;
+};
+
+
+/**
+ * @brief The GeneratedNetwork structure contains a network and projections that receive input spikes.
+ */
+struct GeneratedNetwork
+{
+    /**
+     * @brief Network.
+     */
+    knp::framework::Network network_;
+
+    /**
+     * @brief Input projection UIDs.
+     */
+    std::vector<knp::core::UID> input_projections_;
+
+    /**
+     * @brief Number of neurons receiving input spikes.
+     */
+    size_t input_size_ = 0;
+
+    /**
+     * @brief Number of neurons in all populations.
+     */
+    size_t neurons_count_ = 0;
+};
+
+
+namespace detail
+{
+// Delays from 1 to 4 steps are used to spread impacts over steps. The generator is thread-safe, so projections are
+// generated using all hardware threads.
+inline auto make_synapse_gen(float weight, knp::synapse_traits::OutputType type)
+{
+    return [weight, type](size_t from_index, size_t to_index)
+    {
+        return DeltaProjection::SynapseParameters{
+            weight, static_cast<uint32_t>(1 + (from_index + to_index) % 4), type};
+    };
+}
+
+
+// Input synapses make each input spike fire the target neuron.
+inline DeltaProjection make_input_projection(const knp::core::UID &population_uid, size_t neurons_count)
+{
+    return knp::framework::projection::creators::one_to_one<knp::synapse_traits::DeltaSynapse>(
+        knp::core::UID{false}, population_uid, neurons_count,
+        [](size_t)
+        { return DeltaProjection::SynapseParameters{1.0F, 1, knp::synapse_traits::OutputType::EXCITATORY}; });
+}
+}  // namespace detail
+
+
+/**
+ * @brief Generate a random balanced network of excitatory and inhibitory populations.
+ * @details 80% of neurons are excitatory. Each neuron gets `fan_in_` random presynaptic neurons, 80% of them are
+ * excitatory. Input spikes are sent to the excitatory population.
+ * @param parameters network parameters.
+ * @return generated network.
+ */
+inline GeneratedNetwork make_balanced_network(const NetworkParameters &parameters)
+{
+    namespace creators = knp::framework::projection::creators;
+    using knp::synapse_traits::DeltaSynapse;
+    using knp::synapse_traits::OutputType;
+
+    const size_t exc_count = std::max<size_t>(parameters.neurons_count_ * 4 / 5, 1);
+    const size_t inh_count = std::max<size_t>(parameters.neurons_count_ - exc_count, 1);
+    const size_t exc_fan_in = std::min(std::max<size_t>(parameters.fan_in_ * 4 / 5, 1), exc_count);
+    const size_t inh_fan_in = std::min(std::max<size_t>(parameters.fan_in_ - exc_fan_in, 1), inh_count);
+    const float inh_weight = parameters.weight_ * parameters.inhibition_ratio_;
+
+    auto exc = knp::framework::population::creators::make_default<knp::neuron_traits::BLIFATNeuron>(exc_count);
+    auto inh = knp::framework::population::creators::make_default<knp::neuron_traits::BLIFATNeuron>(inh_count);
+    const auto exc_uid = exc.get_uid();
+    const auto inh_uid = inh.get_uid();
+
+    GeneratedNetwork result;
+    auto input_projection = detail::make_input_projection(exc_uid, exc_count);
+    result.input_projections_.push_back(input_projection.get_uid());
+    result.input_size_ = exc_count;
+    result.neurons_count_ = exc_count + inh_count;
+
+    result.network_.add_population(std::move(exc));
+    result.network_.add_population(std::move(inh));
+    result.network_.add_projection(std::move(input_projection));
+    result.network_.add_projection(creators::fixed_number_pre<DeltaSynapse>(
+        exc_uid, exc_uid, exc_count, exc_count, exc_fan_in,
+        detail::make_synapse_gen(parameters.weight_, OutputType::EXCITATORY), 0));
+    result.network_.add_projection(creators::fixed_number_pre<DeltaSynapse>(
+        exc_uid, inh_uid, exc_count, inh_count, exc_fan_in,
+        detail::make_synapse_gen(parameters.weight_, OutputType::EXCITATORY), 0));
+    result.network_.add_projection(creators::fixed_number_pre<DeltaSynapse>(
+        inh_uid, exc_uid, inh_count, exc_count, inh_fan_in,
+        detail::make_synapse_gen(inh_weight, OutputType::INHIBITORY_CURRENT), 0));
+    result.network_.add_projection(creators::fixed_number_pre<DeltaSynapse>(
+        inh_uid, inh_uid, inh_count, inh_count, inh_fan_in,
+        detail::make_synapse_gen(inh_weight, OutputType::INHIBITORY_CURRENT), 0));
+
+    return result;
+}
+
+
+/**
+ * @brief Generate a feed-forward network of equal layers.
+ * @details Each neuron of a layer gets `fan_in_` random presynaptic neurons of the previous layer. Input spikes are
+ * sent to the first layer.
+ * @param parameters network parameters.
+ * @return generated network.
+ */
+inline GeneratedNetwork make_layered_network(const NetworkParameters &parameters)
+{
+    const size_t layers_count = std::max<size_t>(parameters.layers_count_, 1);
+    const size_t layer_size = std::max<size_t>(parameters.neurons_count_ / layers_count, 1);
+    const size_t fan_in = std::min(std::max<size_t>(parameters.fan_in_, 1), layer_size);
+
+    GeneratedNetwork result;
+    knp::core::UID previous_uid{false};
+    for (size_t layer = 0; layer < layers_count; ++layer)
+    {
+        auto population =
+            knp::framework::population::creators::make_default<knp::neuron_traits::BLIFATNeuron>(layer_size);
+        const auto uid = population.get_uid();
+        result.network_.add_population(std::move(population));
+
+        if (0 == layer)
+        {
+            auto input_projection = detail::make_input_projection(uid, layer_size);
+            result.input_projections_.push_back(input_projection.get_uid());
+            result.network_.add_projection(std::move(input_projection));
+        }
+        else
+        {
+            result.network_.add_projection(
+                knp::framework::projection::creators::fixed_number_pre<knp::synapse_traits::DeltaSynapse>(
+                    previous_uid, uid, layer_size, layer_size, fan_in,
+                    detail::make_synapse_gen(parameters.weight_, knp::synapse_traits::OutputType::EXCITATORY), 0));
+        }
+        previous_uid = uid;
+    }
+    result.input_size_ = layer_size;
+    result.neurons_count_ = layer_size * layers_count;
+
+    return result;
+}
+
+
+/**
+ * @brief Generate an MNIST-like stack: an input layer of 784 neurons followed by all-to-all connected layers.
+ * @details Hidden layers share `neurons_count_` equally. Synapse weights are scaled by the previous layer size,
+ * so that a neuron fires when about 5% of the previous layer fires. `fan_in_` and `weight_` are not used.
+ * @param parameters network parameters.
+ * @return generated network.
+ */
+inline GeneratedNetwork make_all_to_all_network(const NetworkParameters &parameters)
+{
+    constexpr size_t input_size = 28 * 28;
+    const size_t layers_count = std::max<size_t>(parameters.layers_count_, 1);
+    const size_t layer_size = std::max<size_t>(parameters.neurons_count_ / layers_count, 1);
+
+    GeneratedNetwork result;
+    auto input_population =
+        knp::framework::population::creators::make_default<knp::neuron_traits::BLIFATNeuron>(input_size);
+    knp::core::UID previous_uid = input_population.get_uid();
+    size_t previous_size = input_size;
+
+    auto input_projection = detail::make_input_projection(previous_uid, input_size);
+    result.input_projections_.push_back(input_projection.get_uid());
+    result.input_size_ = input_size;
+    result.neurons_count_ = input_size + layer_size * layers_count;
+    result.network_.add_population(std::move(input_population));
+    result.network_.add_projection(std::move(input_projection));
+
+    for (size_t layer = 0; layer < layers_count; ++layer)
+    {
+        auto population =
+            knp::framework::population::creators::make_default<knp::neuron_traits::BLIFATNeuron>(layer_size);
+        const auto uid = population.get_uid();
+        const float weight = 20.0F / static_cast<float>(previous_size);
+
+        result.network_.add_population(std::move(population));
+        result.network_.add_projection(
+            knp::framework::projection::creators::all_to_all<knp::synapse_traits::DeltaSynapse>(
+                previous_uid, uid, previous_size, layer_size,
+                detail::make_synapse_gen(weight, knp::synapse_traits::OutputType::EXCITATORY), 0));
+        previous_uid = uid;
+        previous_size = layer_size;
+    }
+
+    return result;
+}
+
+
+/**
+ * @brief Generate a network of the given kind.
+ * @param parameters network parameters.
+ * @return generated network.
+ * @throw std::invalid_argument if the network kind is unknown.
+ */
+inline GeneratedNetwork make_network(const NetworkParameters &parameters)
+{
+    if ("balanced" == parameters.kind_) return make_balanced_network(parameters);
+    if ("layered" == parameters.kind_) return make_layered_network(parameters);
+    if ("all-to-all" == parameters.kind_) return make_all_to_all_network(parameters);
+    throw std::invalid_argument("Unknown network kind \"" + parameters.kind_ + "\".");
+}
+
+}  // namespace knp::benchmarks::scaling
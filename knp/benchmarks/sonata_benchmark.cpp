@@ -0,0 +1,98 @@
+/**
+ * @file sonata_benchmark.cpp
+ * @brief SONATA network input/output benchmarks.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <knp/framework/network.h>
+#include <knp/framework/sonata/network_io.h>
+
+#include <benchmark/benchmark.h>
+#include <benchmark_networks.h>
+
+#include <filesystem>
+
+
+namespace kb = knp::benchmarks;
+
+
+namespace
+{
+knp::framework::Network make_network(size_t neurons_count, size_t fan_in)
+{
+    knp::framework::Network network;
+    kb::BLIFATPopulation population{
+        [](size_t) { return knp::neuron_traits::neuron_parameters<knp::neuron_traits::BLIFATNeuron>{}; },
+        neurons_count};
+    auto projection =
+        kb::make_random_projection(population.get_uid(), population.get_uid(), neurons_count, neurons_count, fan_in);
+    network.add_population(std::move(population));
+    network.add_projection(std::move(projection));
+    return network;
+}
+
+
+std::filesystem::path get_network_dir()
+{
+    return std::filesystem::temp_directory_path() / "knp_sonata_benchmark";
+}
+}  // namespace
+
+
+// Arguments: population size, fan-in, compression level.
+static void sonata_save_network(benchmark::State &state)
+{
+    const auto network = make_network(static_cast<size_t>(state.range(0)), static_cast<size_t>(state.range(1)));
+    knp::framework::sonata::SaveOptions options;
+    options.compression_level_ = static_cast<unsigned>(state.range(2));
+    options.shuffle_ = options.compression_level_ > 0;
+    const auto network_dir = get_network_dir();
+
+    for (auto _ : state)
+    {
+        std::filesystem::remove_all(network_dir);
+        std::filesystem::create_directories(network_dir);
+        knp::framework::sonata::save_network(network, network_dir, options);
+    }
+    std::filesystem::remove_all(network_dir);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(state.range(0) * state.range(1)));
+}
+BENCHMARK(sonata_save_network)->Args({10000, 100, 0})->Args({10000, 100, 4})->Unit(benchmark::kMillisecond);
+
+
+// Arguments: population size, fan-in, lazy projection loading.
+static void sonata_load_network(benchmark::State &state)
+{
+    const auto network_dir = get_network_dir();
+    std::filesystem::remove_all(network_dir);
+    std::filesystem::create_directories(network_dir);
+    knp::framework::sonata::save_network(
+        make_network(static_cast<size_t>(state.range(0)), static_cast<size_t>(state.range(1))), network_dir);
+    knp::framework::sonata::LoadOptions options;
+    options.lazy_projections_ = state.range(2) != 0;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(
+            knp::framework::sonata::load_network(network_dir, options));
+    }
+    std::filesystem::remove_all(network_dir);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(state.range(0) * state.range(1)));
+}
+BENCHMARK(sonata_load_network)->Args({10000, 100, 0})->Args({10000, 100, 1})->Unit(benchmark::kMillisecond);
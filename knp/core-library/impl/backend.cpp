@@ -157,6 +157,59 @@ void Backend::_uninit()
 }
 
 
+void Backend::enable_statistics(const UID& population_uid, const StatisticsSettings& settings)
+{
+    auto data_ranges = get_network_data();
+    for (auto& iter = *data_ranges.population_range.first; iter != *data_ranges.population_range.second; ++iter)
+    {
+        auto population = *iter;
+        if (std::visit([](const auto& p) { return p.get_uid(); }, population) != population_uid) continue;
+
+        const size_t neurons_count = std::visit([](const auto& p) { return p.size(); }, population);
+        statistics_.add_population(population_uid, neurons_count, settings, step_);
+        return;
+    }
+
+    throw std::logic_error("Backend doesn't contain population " + std::string(population_uid) + ".");
+}
+
+
+void Backend::enable_profiling(bool hardware_counters)
+{
+    std::vector<UID> entity_uids;
+    auto data_ranges = get_network_data();
+    for (auto& iter = *data_ranges.population_range.first; iter != *data_ranges.population_range.second; ++iter)
+    {
+        entity_uids.push_back(std::visit([](const auto& p) { return p.get_uid(); }, *iter));
+    }
+    for (auto& iter = *data_ranges.projection_range.first; iter != *data_ranges.projection_range.second; ++iter)
+    {
+        entity_uids.push_back(std::visit([](const auto& p) { return p.get_uid(); }, *iter));
+    }
+
+    profiler_.enable(entity_uids, hardware_counters);
+}
+
+
+MemoryUsage Backend::memory_usage() const
+{
+    return get_message_endpoint().memory_usage();
+}
+
+
+void Backend::route_messages()
+{
+    {
+        StepProfiler::ScopedTimer timer(profiler_.get_phase_counter(StepPhase::routing));
+        Tracer::Scope trace_scope(&tracer_, "route_messages", "bus");
+        profiler_.add_routed_messages(get_message_bus().route_messages());
+    }
+    StepProfiler::ScopedTimer timer(profiler_.get_phase_counter(StepPhase::receiving));
+    Tracer::Scope trace_scope(&tracer_, "receive_messages", "bus");
+    profiler_.add_received_messages(get_message_endpoint().receive_all_messages());
+}
+
+
 void Backend::select_devices(const std::set<UID>& uids)
 {
     for (auto&& device : get_devices())
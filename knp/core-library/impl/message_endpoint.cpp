@@ -233,6 +233,29 @@ void MessageEndpoint::update_senders()
 }
 
 
+MemoryUsage MessageEndpoint::memory_usage() const
+{
+    MemoryUsage result;
+    // Map nodes are considered to contain a key, a value and three tree pointers.
+    result.subscriptions_ = subscriptions_.size() * (sizeof(SubscriptionContainer::value_type) + 3 * sizeof(void *));
+    if (senders_) result.subscriptions_ += hash_container_bytes(*senders_);
+
+    for (const auto &[key, subscription_variant] : subscriptions_)
+    {
+        std::visit(
+            [&result](const auto &subscription)
+            {
+                result.subscriptions_ += hash_container_bytes(subscription.get_senders());
+                const auto &messages = subscription.get_messages();
+                result.slack_ += slack_bytes(messages);
+                for (const auto &message : messages) result.messages_ += messaging::message_bytes(message);
+            },
+            subscription_variant);
+    }
+    return result;
+}
+
+
 namespace cm = knp::core::messaging;
 
 #define INSTANCE_MESSAGES_FUNCTIONS(n, template_for_instance, message_type)                \
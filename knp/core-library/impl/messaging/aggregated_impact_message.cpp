@@ -0,0 +1,231 @@
+/**
+ * @file aggregated_impact_message.cpp
+ * @brief Aggregated impact message implementation.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <tuple>
+
+#include "aggregated_impact_message_impl.h"
+#include "uid_marshal.h"
+
+
+namespace knp::core::messaging
+{
+
+namespace
+{
+
+// A dense zero value changes a neuron if impacts are blocking or force the neuron.
+bool can_be_dense(knp::synapse_traits::OutputType type, bool is_forcing)
+{
+    return type != knp::synapse_traits::OutputType::BLOCKING &&
+           !(is_forcing && type == knp::synapse_traits::OutputType::EXCITATORY);
+}
+
+
+void make_dense(AggregatedImpacts &impacts)
+{
+    std::vector<float> values(impacts.neuron_indexes_.back() + 1, 0.F);
+    for (size_t i = 0; i < impacts.neuron_indexes_.size(); ++i) values[impacts.neuron_indexes_[i]] = impacts.values_[i];
+    impacts.values_ = std::move(values);
+    impacts.neuron_indexes_.clear();
+}
+
+}  // namespace
+
+
+bool AggregatedImpacts::operator==(const AggregatedImpacts &other) const
+{
+    return synapse_type_ == other.synapse_type_ && neuron_indexes_ == other.neuron_indexes_ && values_ == other.values_;
+}
+
+
+AggregatedImpactMessage aggregate_impacts(const SynapticImpactMessage &message)
+{
+    AggregatedImpactMessage result{
+        message.header_, message.presynaptic_population_uid_, message.postsynaptic_population_uid_,
+        message.is_forcing_, {}};
+
+    // The sort is stable to keep the order of blocking impacts on a neuron.
+    std::vector<const SynapticImpact *> sorted_impacts;
+    sorted_impacts.reserve(message.impacts_.size());
+    for (const auto &impact : message.impacts_) sorted_impacts.push_back(&impact);
+    std::stable_sort(
+        sorted_impacts.begin(), sorted_impacts.end(),
+        [](const SynapticImpact *first, const SynapticImpact *second)
+        {
+            return std::tie(first->synapse_type_, first->postsynaptic_neuron_index_) <
+                   std::tie(second->synapse_type_, second->postsynaptic_neuron_index_);
+        });
+
+    for (auto group_begin = sorted_impacts.begin(); group_begin != sorted_impacts.end();)
+    {
+        const auto type = (*group_begin)->synapse_type_;
+        const auto group_end = std::find_if(
+            group_begin, sorted_impacts.end(),
+            [type](const SynapticImpact *impact) { return impact->synapse_type_ != type; });
+
+        AggregatedImpacts group{type, {}, {}};
+        for (auto iter = group_begin; iter != group_end; ++iter)
+        {
+            const auto &impact = **iter;
+            if (!group.neuron_indexes_.empty() && group.neuron_indexes_.back() == impact.postsynaptic_neuron_index_)
+            {
+                if (type == knp::synapse_traits::OutputType::BLOCKING)
+                    group.values_.back() = impact.impact_value_;
+                else
+                    group.values_.back() += impact.impact_value_;
+                continue;
+            }
+            group.neuron_indexes_.push_back(impact.postsynaptic_neuron_index_);
+            group.values_.push_back(impact.impact_value_);
+        }
+
+        // Dense values take half as much memory as index-value pairs.
+        if (can_be_dense(type, message.is_forcing_) &&
+            2 * group.neuron_indexes_.size() > static_cast<size_t>(group.neuron_indexes_.back()) + 1)
+        {
+            make_dense(group);
+        }
+        result.impacts_.push_back(std::move(group));
+        group_begin = group_end;
+    }
+
+    return result;
+}
+
+
+bool operator==(const AggregatedImpactMessage &am1, const AggregatedImpactMessage &am2)
+{
+    return am1.header_.send_time_ == am2.header_.send_time_ && am1.header_.sender_uid_ == am2.header_.sender_uid_ &&
+           am1.presynaptic_population_uid_ == am2.presynaptic_population_uid_ &&
+           am1.postsynaptic_population_uid_ == am2.postsynaptic_population_uid_ && am1.is_forcing_ == am2.is_forcing_ &&
+           am1.impacts_ == am2.impacts_;
+}
+
+
+std::ostream &operator<<(std::ostream &stream, const AggregatedImpactMessage &msg)
+{
+    stream << msg.header_ << " " << msg.postsynaptic_population_uid_ << " " << msg.presynaptic_population_uid_ << " "
+           << static_cast<int>(msg.is_forcing_) << " " << msg.impacts_.size();
+    for (const auto &impacts : msg.impacts_)
+    {
+        stream << " " << static_cast<int>(impacts.synapse_type_) << " " << impacts.neuron_indexes_.size();
+        for (auto index : impacts.neuron_indexes_) stream << " " << index;
+        stream << " " << impacts.values_.size();
+        for (auto value : impacts.values_) stream << " " << value;
+    }
+    return stream;
+}
+
+
+std::istream &operator>>(std::istream &stream, AggregatedImpactMessage &msg)
+{
+    size_t groups_count = 0;
+    int forcing_buf;
+    stream >> msg.header_ >> msg.postsynaptic_population_uid_ >> msg.presynaptic_population_uid_ >> forcing_buf >>
+        groups_count;
+
+    msg.is_forcing_ = forcing_buf;
+    msg.impacts_.resize(groups_count);
+    for (auto &impacts : msg.impacts_)
+    {
+        int type;
+        size_t indexes_count = 0;
+        stream >> type >> indexes_count;
+        impacts.synapse_type_ = static_cast<knp::synapse_traits::OutputType>(type);
+        impacts.neuron_indexes_.resize(indexes_count);
+        for (auto &index : impacts.neuron_indexes_) stream >> index;
+
+        size_t values_count = 0;
+        stream >> values_count;
+        impacts.values_.resize(values_count);
+        for (auto &value : impacts.values_) stream >> value;
+    }
+    return stream;
+}
+
+
+::flatbuffers::uoffset_t pack_internal(::flatbuffers::FlatBufferBuilder &builder, const AggregatedImpactMessage &msg)
+{
+    SPDLOG_TRACE("Packing aggregated impact message...");
+
+    marshal::MessageHeader header{get_marshaled_uid(msg.header_.sender_uid_), msg.header_.send_time_};
+
+    // Nested tables must be created before the message table.
+    std::vector<::flatbuffers::Offset<marshal::AggregatedImpacts>> impacts;
+    impacts.reserve(msg.impacts_.size());
+    for (const auto &group : msg.impacts_)
+    {
+        impacts.push_back(marshal::CreateAggregatedImpactsDirect(
+            builder, static_cast<knp::synapse_traits::marshal::OutputType>(group.synapse_type_), &group.neuron_indexes_,
+            &group.values_));
+    }
+
+    auto pre_synaptic_uid = get_marshaled_uid(msg.presynaptic_population_uid_);
+    auto post_synaptic_uid = get_marshaled_uid(msg.postsynaptic_population_uid_);
+
+    return marshal::CreateAggregatedImpactMessageDirect(
+               builder, &header, &pre_synaptic_uid, &post_synaptic_uid, msg.is_forcing_, &impacts)
+        .o;
+}
+
+
+AggregatedImpactMessage unpack(const marshal::AggregatedImpactMessage *s_msg)
+{
+    SPDLOG_TRACE("Unpacking aggregated impact message FlatBuffers class...");
+    assert(s_msg);
+
+    const marshal::MessageHeader *const s_msg_header{s_msg->header()};
+
+    UID sender_uid{false};
+    UID presynaptic_uid{false};
+    UID postsynaptic_uid{false};
+    std::copy(
+        s_msg_header->sender_uid().data()->begin(),  // clang_sa_ignore [core.CallAndMessage]
+        s_msg_header->sender_uid().data()->end(),    // clang_sa_ignore [core.CallAndMessage]
+        sender_uid.tag.begin());
+    const auto &presynaptic_data = s_msg->presynaptic_population_uid()->data();
+    std::copy(presynaptic_data->begin(), presynaptic_data->end(), presynaptic_uid.tag.begin());
+    const auto &postsynaptic_data = s_msg->postsynaptic_population_uid()->data();
+    std::copy(postsynaptic_data->begin(), postsynaptic_data->end(), postsynaptic_uid.tag.begin());
+
+    std::vector<AggregatedImpacts> impacts;
+    if (s_msg->impacts())
+    {
+        impacts.reserve(s_msg->impacts()->size());
+        for (const auto *s_group : *s_msg->impacts())
+        {
+            AggregatedImpacts group{static_cast<knp::synapse_traits::OutputType>(s_group->output_type()), {}, {}};
+            if (s_group->neuron_indexes())
+                group.neuron_indexes_.assign(s_group->neuron_indexes()->begin(), s_group->neuron_indexes()->end());
+            if (s_group->values()) group.values_.assign(s_group->values()->begin(), s_group->values()->end());
+            impacts.push_back(std::move(group));
+        }
+    }
+
+    return AggregatedImpactMessage{
+        {sender_uid, s_msg_header->send_time()}, presynaptic_uid, postsynaptic_uid, s_msg->is_forcing(),
+        std::move(impacts)};
+}
+
+}  // namespace knp::core::messaging
@@ -30,6 +30,7 @@
 #endif
 #include <spdlog/spdlog.h>
 
+#include "aggregated_impact_message_impl.h"
 #include "spike_message_impl.h"
 #include "synaptic_impact_message_impl.h"
 
@@ -72,6 +73,9 @@ MessageVariant extract_from_envelope(const void *buffer)
         case marshal::Message_SynapticImpactMessage:
             SPDLOG_TRACE("Unpacking synaptic impact message from the envelope...");
             return unpack(msg_ev->message_as_SynapticImpactMessage());
+        case marshal::Message_AggregatedImpactMessage:
+            SPDLOG_TRACE("Unpacking aggregated impact message from the envelope...");
+            return unpack(msg_ev->message_as_AggregatedImpactMessage());
         default:
             SPDLOG_ERROR("Unknown message type {}.", static_cast<int>(msg_ev->message_type()));
             throw std::logic_error("Unknown message type.");
@@ -0,0 +1,162 @@
+/**
+ * @file perf_counters.cpp
+ * @brief Hardware performance counters implementation.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/core/perf_counters.h>
+
+#include <spdlog/spdlog.h>
+
+#if defined(__linux__)
+#    include <linux/perf_event.h>
+#    include <sys/ioctl.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+
+#    include <array>
+#    include <cerrno>
+#    include <cstring>
+#endif
+
+
+namespace knp::core
+{
+
+#if defined(__linux__)
+
+namespace
+{
+/**
+ * @brief The ThreadPerfCounters class is a definition of a counter group of a thread.
+ * @details Counters that can't be opened are skipped, so the group works on CPUs without some events.
+ */
+class ThreadPerfCounters
+{
+public:
+    ThreadPerfCounters()
+    {
+        // Order of events corresponds to fields of `PerfCounterValues`.
+        constexpr std::array<uint64_t, counters_count> configs = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES,
+            PERF_COUNT_HW_BRANCH_MISSES};
+
+        for (size_t index = 0; index < counters_count; ++index)
+        {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = configs[index];
+            attr.disabled = leader_fd_ < 0 ? 1 : 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP;
+
+            const int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, leader_fd_, 0));
+            if (fd < 0)
+            {
+                SPDLOG_DEBUG("Can't open performance counter {}: {}.", index, std::strerror(errno));
+                continue;
+            }
+            if (leader_fd_ < 0) leader_fd_ = fd;
+            fds_[opened_count_] = fd;
+            indexes_[opened_count_++] = index;
+        }
+
+        if (leader_fd_ >= 0 && ioctl(leader_fd_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP) != 0)
+        {
+            SPDLOG_DEBUG("Can't enable performance counters: {}.", std::strerror(errno));
+            close_all();
+        }
+    }
+
+    ~ThreadPerfCounters() { close_all(); }
+
+    ThreadPerfCounters(const ThreadPerfCounters &) = delete;
+    ThreadPerfCounters &operator=(const ThreadPerfCounters &) = delete;
+
+    [[nodiscard]] bool available() const { return leader_fd_ >= 0; }
+
+    bool read(PerfCounterValues &values) const
+    {
+        if (!available()) return false;
+
+        // Group read format: number of counters followed by counter values.
+        std::array<uint64_t, counters_count + 1> buffer{};
+        const auto read_size = ::read(leader_fd_, buffer.data(), sizeof(buffer));
+        if (read_size < static_cast<ssize_t>(sizeof(uint64_t) * (1 + opened_count_))) return false;
+
+        std::array<uint64_t, counters_count> result{};
+        for (size_t index = 0; index < opened_count_; ++index) result[indexes_[index]] = buffer[index + 1];
+        values = {result[0], result[1], result[2], result[3]};
+        return true;
+    }
+
+private:
+    void close_all()
+    {
+        for (size_t index = 0; index < opened_count_; ++index) ::close(fds_[index]);
+        opened_count_ = 0;
+        leader_fd_ = -1;
+    }
+
+private:
+    static constexpr size_t counters_count = 4;
+    int leader_fd_ = -1;
+    size_t opened_count_ = 0;
+    std::array<int, counters_count> fds_{};
+    std::array<size_t, counters_count> indexes_{};
+};
+
+
+ThreadPerfCounters &get_thread_counters()
+{
+    thread_local ThreadPerfCounters counters;
+    return counters;
+}
+}  // namespace
+
+
+bool perf_counters_supported()
+{
+    return get_thread_counters().available();
+}
+
+
+bool read_perf_counters(PerfCounterValues &values)
+{
+    return get_thread_counters().read(values);
+}
+
+#else
+
+bool perf_counters_supported()
+{
+    return false;
+}
+
+
+bool read_perf_counters(PerfCounterValues &)
+{
+    return false;
+}
+
+#endif
+
+}  // namespace knp::core
@@ -23,6 +23,11 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+
 
 // Index functions.
 template <class Index, class Connection>
@@ -49,53 +54,13 @@ std::vector<size_t> find_indexes_by_type(const Index &val, size_t neuron_index)
 }
 
 
-/**
- * @brief Remove a synapse with a given index.
- * @param index index of a synapse.
- * @return true if an element was found and erased.
- */
-template <class Index, class Projection>
-bool erase_synapse(Index &val, size_t index)
+// Preallocate index buckets, so that bulk insertion doesn't rehash.
+template <class Index>
+void reserve_index(Index &val, size_t size)
 {
-    auto num_erased = val.template get<typename Projection::mi_synapse_index>().erase(index);
-    return num_erased > 0;
-}
-
-
-/**
- * @brief Remove elements by their indexes in a single pass.
- * @tparam T value type.
- * @param data vector that will be modified by deletion.
- * @param to_remove indexes of the elements to remove
- * @warning Indexes must be sorted.
- */
-template <class T, class IndexContainer>
-void remove_by_index(std::vector<T> &data, const IndexContainer &to_remove)
-{
-    if (to_remove.empty()) return;
-
-    size_t cor_counter = 0;
-    for (const auto rem_index : to_remove)
-    {
-        data.erase(std::next(data.begin(), rem_index - cor_counter++));
-    }
-
-    // Cool but incorrect (MSVC\14.40.33807\include\vector(56) : Assertion failed: can't dereference out of range vector
-    // iterator):
-    // size_t removed = 0;
-    // auto next_to_remove = to_remove.begin();
-    // size_t index = *next_to_remove;
-    // while (index + removed < data.size())
-    //{
-    //    while (index + removed == *next_to_remove)
-    //    {
-    //        ++next_to_remove;
-    //        ++removed;
-    //    }
-    //    data[index] = std::move(data[index + removed]);
-    //    ++index;
-    //}
-    // data.resize(data.size() - removed);
+    val.template get<0>().reserve(size);
+    val.template get<1>().reserve(size);
+    val.template get<2>().reserve(size);
 }
 
 
@@ -165,12 +130,76 @@ Projection<SynapseType>::Projection(
 }
 
 
+template <typename SynapseType>
+Projection<SynapseType>::Projection(
+    UID presynaptic_uid, UID postsynaptic_uid, std::vector<Synapse> &&synapses)  //!OCLINT(Parameters used)
+    : presynaptic_uid_(presynaptic_uid), postsynaptic_uid_(postsynaptic_uid), parameters_(std::move(synapses))
+{
+    SPDLOG_DEBUG(
+        "Creating projection with UID = {}, presynaptic UID = {}, postsynaptic UID = {}, synapses = {}...",
+        std::string(get_uid()), std::string(presynaptic_uid_), std::string(postsynaptic_uid_), parameters_.size());
+    reindex();
+}
+
+
+template <typename SynapseType>
+Projection<SynapseType>::Projection(
+    UID uid, UID presynaptic_uid, UID postsynaptic_uid, std::vector<Synapse> &&synapses)  //!OCLINT(Parameters used)
+    : base_{uid},
+      presynaptic_uid_(presynaptic_uid),
+      postsynaptic_uid_(postsynaptic_uid),
+      parameters_(std::move(synapses))
+{
+    SPDLOG_DEBUG(
+        "Creating projection with UID = {}, presynaptic UID = {}, postsynaptic UID = {}, synapses = {}...",
+        std::string(get_uid()), std::string(presynaptic_uid_), std::string(postsynaptic_uid_), parameters_.size());
+    reindex();
+}
+
+
+template <typename SynapseType>
+Projection<SynapseType>::Projection(
+    UID uid, UID presynaptic_uid, UID postsynaptic_uid, std::vector<Synapse> &&synapses,  //!OCLINT(Parameters used)
+    EdgeIndex &&presynaptic_index, EdgeIndex &&postsynaptic_index)                        //!OCLINT(Parameters used)
+    : base_{uid},
+      presynaptic_uid_(presynaptic_uid),
+      postsynaptic_uid_(postsynaptic_uid),
+      parameters_(std::move(synapses))
+{
+    SPDLOG_DEBUG(
+        "Creating projection with UID = {}, presynaptic UID = {}, postsynaptic UID = {}, synapses = {}...",
+        std::string(get_uid()), std::string(presynaptic_uid_), std::string(postsynaptic_uid_), parameters_.size());
+    if (is_edge_index_valid<source_neuron_id>(presynaptic_index) &&
+        is_edge_index_valid<target_neuron_id>(postsynaptic_index))
+    {
+        edge_indexes_ = {std::move(presynaptic_index), std::move(postsynaptic_index)};
+        return;
+    }
+    SPDLOG_WARN("Synapse indexes of projection {} don't match synapses, rebuilding them.", std::string(get_uid()));
+    reindex();
+}
+
+
 template <typename SynapseType>
 std::vector<size_t> knp::core::Projection<SynapseType>::find_synapses(
     size_t neuron_id, Search search_criterion) const  //!OCLINT(Parameters used)
 {
-    reindex();
     std::vector<size_t> res;
+    if (edge_indexes_)
+    {
+        const auto &edge_index = (*edge_indexes_)[search_criterion == Search::by_presynaptic ? 0 : 1];
+        if (neuron_id >= edge_index.node_id_to_ranges_.size()) return res;
+        const auto &[first_range, last_range] = edge_index.node_id_to_ranges_[neuron_id];
+        for (size_t range = first_range; range < last_range; ++range)
+        {
+            const auto &[first_synapse, last_synapse] = edge_index.range_to_edge_id_[range];
+            for (size_t synapse_index = first_synapse; synapse_index < last_synapse; ++synapse_index)
+                res.push_back(synapse_index);
+        }
+        return res;
+    }
+
+    reindex();
     switch (search_criterion)
     {
         case Search::by_postsynaptic:
@@ -192,7 +221,10 @@ template <typename SynapseType>
 size_t knp::core::Projection<SynapseType>::add_synapses(
     SynapseGenerator generator, size_t num_iterations)  //!OCLINT(Parameters used)
 {
+    drop_edge_indexes();
     const size_t starting_size = parameters_.size();
+    const bool was_index_updated = is_index_updated_;
+    // Basic exception safety.
     is_index_updated_ = false;
     for (size_t i = 0; i < num_iterations; ++i)
     {
@@ -201,60 +233,214 @@ size_t knp::core::Projection<SynapseType>::add_synapses(
             parameters_.emplace_back(std::move(data.value()));
         }
     }
+    if (was_index_updated)
+    {
+        index_synapses(starting_size);
+        is_index_updated_ = true;
+    }
     return parameters_.size() - starting_size;
 }
 
 
+template <typename SynapseType>
+void knp::core::Projection<SynapseType>::update_synapses(
+    std::vector<size_t> to_remove, std::vector<Synapse> &&to_add)  //!OCLINT(Parameters used)
+{
+    drop_edge_indexes();
+    std::sort(to_remove.begin(), to_remove.end());
+    to_remove.erase(std::unique(to_remove.begin(), to_remove.end()), to_remove.end());
+    if (!to_remove.empty() && to_remove.back() >= parameters_.size())
+        throw std::out_of_range("Synapse index is out of range.");
+
+    remove_sorted_synapses(to_remove);
+
+    const size_t starting_size = parameters_.size();
+    const bool was_index_updated = is_index_updated_;
+    is_index_updated_ = false;
+    parameters_.insert(
+        parameters_.end(), std::make_move_iterator(to_add.begin()), std::make_move_iterator(to_add.end()));
+    if (was_index_updated)
+    {
+        index_synapses(starting_size);
+        is_index_updated_ = true;
+    }
+}
+
+
 template <typename SynapseType>
 void Projection<SynapseType>::clear()
 {
     parameters_.clear();
     index_.clear();
+    edge_indexes_.reset();
 }
 
 
 template <typename SynapseType>
 void knp::core::Projection<SynapseType>::remove_synapse(size_t index)  //!OCLINT
 {
-    is_index_updated_ = false;
-    parameters_.erase(parameters_.begin() + index);
+    if (index >= parameters_.size()) throw std::out_of_range("Synapse index is out of range.");
+    remove_sorted_synapses({index});
 }
 
 
 template <typename SynapseType>
 size_t knp::core::Projection<SynapseType>::remove_synapse_if(std::function<bool(const Synapse &)> predicate)  //!OCLINT
 {
-    const size_t starting_size = parameters_.size();
-    is_index_updated_ = false;
-    parameters_.resize(std::remove_if(parameters_.begin(), parameters_.end(), predicate) - parameters_.begin());
-    return starting_size - parameters_.size();
+    std::vector<size_t> synapses_to_remove;
+    for (size_t i = 0; i < parameters_.size(); ++i)
+    {
+        if (predicate(parameters_[i])) synapses_to_remove.push_back(i);
+    }
+    remove_sorted_synapses(synapses_to_remove);
+    return synapses_to_remove.size();
 }
 
 
 template <typename SynapseType>
 size_t knp::core::Projection<SynapseType>::remove_postsynaptic_neuron_synapses(size_t neuron_index)  //!OCLINT
 {
+    auto synapses_to_remove = find_synapses(neuron_index, Search::by_postsynaptic);
+    std::sort(synapses_to_remove.begin(), synapses_to_remove.end());
+    remove_sorted_synapses(synapses_to_remove);
+    return synapses_to_remove.size();
+}
+
+
+template <typename SynapseType>
+size_t knp::core::Projection<SynapseType>::remove_presynaptic_neuron_synapses(size_t neuron_index)  //!OCLINT
+{
+    auto synapses_to_remove = find_synapses(neuron_index, Search::by_presynaptic);
+    std::sort(synapses_to_remove.begin(), synapses_to_remove.end());
+    remove_sorted_synapses(synapses_to_remove);
+    return synapses_to_remove.size();
+}
+
+
+template <typename SynapseType>
+void knp::core::Projection<SynapseType>::remove_sorted_synapses(const std::vector<size_t> &to_remove)
+{
+    if (to_remove.empty()) return;
+    drop_edge_indexes();
+
     const size_t starting_size = parameters_.size();
-    bool was_index_updated = is_index_updated_;
+    const bool was_index_updated = is_index_updated_;
     // Basic exception safety.
     is_index_updated_ = false;
-    auto synapses_to_remove = find_synapses(neuron_index, Search::by_postsynaptic);
-    std::sort(synapses_to_remove.begin(), synapses_to_remove.end());
-    remove_by_index(parameters_, synapses_to_remove);
-    if (was_index_updated)
-        for (auto &synapse : synapses_to_remove) index_.erase(synapse);
 
-    is_index_updated_ = was_index_updated;
-    return starting_size - parameters_.size();
+    // Stable compaction: each remaining synapse after the first removed one is moved once.
+    auto next_removed = to_remove.cbegin();
+    size_t write_index = to_remove.front();
+    for (size_t read_index = write_index; read_index < starting_size; ++read_index)
+    {
+        if (next_removed != to_remove.cend() && *next_removed == read_index)
+        {
+            ++next_removed;
+            continue;
+        }
+        parameters_[write_index++] = std::move(parameters_[read_index]);
+    }
+    parameters_.erase(parameters_.begin() + static_cast<std::ptrdiff_t>(write_index), parameters_.end());
+
+    if (!was_index_updated) return;
+
+    // Patch synapse indexes of moved synapses. Indexes decrease, so ascending order avoids collisions.
+    auto &by_synapse_index = index_.template get<mi_synapse_index>();
+    for (const auto synapse_index : to_remove) by_synapse_index.erase(synapse_index);
+    size_t removed_count = 0;
+    next_removed = to_remove.cbegin();
+    for (size_t synapse_index = to_remove.front(); synapse_index < starting_size; ++synapse_index)
+    {
+        if (next_removed != to_remove.cend() && *next_removed == synapse_index)
+        {
+            ++next_removed;
+            ++removed_count;
+            continue;
+        }
+        by_synapse_index.modify(
+            by_synapse_index.find(synapse_index),
+            [removed_count](Connection &connection) { connection.index_ -= removed_count; });
+    }
+    is_index_updated_ = true;
 }
 
 
 template <typename SynapseType>
-size_t knp::core::Projection<SynapseType>::remove_presynaptic_neuron_synapses(size_t neuron_index)  //!OCLINT
+knp::core::MemoryUsage knp::core::Projection<SynapseType>::memory_usage() const
+{
+    MemoryUsage result;
+    result.parameters_ = used_bytes(parameters_);
+    result.slack_ = slack_bytes(parameters_);
+    // Each index node contains a connection and two pointers for each of three hashed indexes.
+    result.index_ = index_.size() * (sizeof(Connection) + 6 * sizeof(void *)) +
+                    (index_.template get<0>().bucket_count() + index_.template get<1>().bucket_count() +
+                     index_.template get<2>().bucket_count()) *
+                        sizeof(void *);
+    if (edge_indexes_)
+    {
+        for (const auto &edge_index : *edge_indexes_)
+            result.index_ += used_bytes(edge_index.node_id_to_ranges_) + used_bytes(edge_index.range_to_edge_id_);
+    }
+    return result;
+}
+
+
+template <typename SynapseType>
+void knp::core::Projection<SynapseType>::load_synapses()
+{
+    if (is_loaded()) return;
+
+    SPDLOG_DEBUG("Loading synapses of the projection with UID = {}...", std::string(get_uid()));
+    // The loader may replace the whole projection, so it must not be a member while it runs.
+    auto loader = std::move(synapse_loader_);
+    synapse_loader_ = nullptr;
+    try
+    {
+        loader(*this);
+    }
+    catch (...)
+    {
+        // Keep loading deferred, so that it can be retried.
+        synapse_loader_ = std::move(loader);
+        throw;
+    }
+}
+
+
+template <typename SynapseType>
+template <size_t neuron_id_index>
+bool knp::core::Projection<SynapseType>::is_edge_index_valid(const EdgeIndex &edge_index) const
+{
+    std::vector<bool> is_indexed(parameters_.size(), false);
+    size_t indexed_count = 0;
+    for (size_t neuron_index = 0; neuron_index < edge_index.node_id_to_ranges_.size(); ++neuron_index)
+    {
+        const auto &[first_range, last_range] = edge_index.node_id_to_ranges_[neuron_index];
+        if (first_range > last_range || last_range > edge_index.range_to_edge_id_.size()) return false;
+        for (size_t range = first_range; range < last_range; ++range)
+        {
+            const auto &[first_synapse, last_synapse] = edge_index.range_to_edge_id_[range];
+            if (first_synapse > last_synapse || last_synapse > parameters_.size()) return false;
+            for (size_t synapse_index = first_synapse; synapse_index < last_synapse; ++synapse_index)
+            {
+                if (std::get<neuron_id_index>(parameters_[synapse_index]) != neuron_index) return false;
+                if (is_indexed[synapse_index]) return false;
+                is_indexed[synapse_index] = true;
+            }
+            indexed_count += last_synapse - first_synapse;
+        }
+    }
+    return indexed_count == parameters_.size();
+}
+
+
+template <typename SynapseType>
+void knp::core::Projection<SynapseType>::drop_edge_indexes()
 {
-    // TODO: We now have a way to find them quickly, make use of it instead of disconnect_if.
-    return remove_synapse_if([neuron_index](const Synapse &synapse)
-                             { return std::get<knp::core::source_neuron_id>(synapse) == neuron_index; });
+    if (!edge_indexes_) return;
+    // The hashed index was not built while edge indexes were used.
+    edge_indexes_.reset();
+    reindex();
 }
 
 
@@ -267,7 +453,16 @@ void knp::core::Projection<SynapseType>::reindex() const
     }
 
     index_.clear();
-    for (size_t i = 0; i < parameters_.size(); ++i)
+    index_synapses(0);
+    is_index_updated_ = true;
+}
+
+
+template <typename SynapseType>
+void knp::core::Projection<SynapseType>::index_synapses(size_t first_synapse) const
+{
+    reserve_index(index_, parameters_.size());
+    for (size_t i = first_synapse; i < parameters_.size(); ++i)
     {
         auto &synapse = parameters_[i];
         insert_to_index(
@@ -275,7 +470,6 @@ void knp::core::Projection<SynapseType>::reindex() const
             Connection{
                 std::get<knp::core::source_neuron_id>(synapse), std::get<knp::core::target_neuron_id>(synapse), i});
     }
-    is_index_updated_ = true;
 }
 
 
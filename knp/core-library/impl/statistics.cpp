@@ -0,0 +1,145 @@
+/**
+ * @file statistics.cpp
+ * @brief Spike statistics implementation.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/core/statistics.h>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+
+namespace knp::core
+{
+
+namespace
+{
+constexpr Step no_spike = std::numeric_limits<Step>::max();
+}  // namespace
+
+
+double PopulationStatistics::get_firing_rate() const
+{
+    if (!steps_count_ || neuron_spikes_counts_.empty()) return 0;
+    return static_cast<double>(spikes_count_) / static_cast<double>(steps_count_) /
+           static_cast<double>(neuron_spikes_counts_.size());
+}
+
+
+std::vector<double> PopulationStatistics::get_neuron_firing_rates() const
+{
+    std::vector<double> result(neuron_spikes_counts_.size(), 0);
+    if (!steps_count_) return result;
+    std::transform(
+        neuron_spikes_counts_.begin(), neuron_spikes_counts_.end(), result.begin(),
+        [this](uint64_t count) { return static_cast<double>(count) / static_cast<double>(steps_count_); });
+    return result;
+}
+
+
+void StatisticsCollector::add_population(
+    const UID &population_uid, size_t neurons_count, const StatisticsSettings &settings, Step step)
+{
+    if (!settings.isi_bin_width_) throw std::invalid_argument("Histogram bin width must be greater than 0.");
+
+    SPDLOG_DEBUG("Collecting statistics for population {}.", std::string(population_uid));
+    PopulationData &data = populations_[population_uid];
+    data.statistics_.population_uid_ = population_uid;
+    data.statistics_.first_step_ = step;
+    data.statistics_.steps_count_ = 0;
+    data.statistics_.spikes_count_ = 0;
+    data.statistics_.neuron_spikes_counts_.assign(neurons_count, 0);
+    data.statistics_.isi_bin_width_ = settings.isi_bin_width_;
+    data.statistics_.isi_histogram_.assign(settings.isi_bins_count_, 0);
+    data.last_spike_steps_.assign(settings.isi_bins_count_ ? neurons_count : 0, no_spike);
+}
+
+
+void StatisticsCollector::remove_population(const UID &population_uid)
+{
+    populations_.erase(population_uid);
+}
+
+
+void StatisticsCollector::add_spikes(const messaging::SpikeMessage &message)
+{
+    auto iter = populations_.find(message.header_.sender_uid_);
+    if (iter == populations_.end()) return;
+
+    PopulationStatistics &statistics = iter->second.statistics_;
+    auto &neuron_counts = statistics.neuron_spikes_counts_;
+    auto &histogram = statistics.isi_histogram_;
+    auto &last_steps = iter->second.last_spike_steps_;
+    const Step step = message.header_.send_time_;
+
+    for (const auto neuron_index : message.neuron_indexes_)
+    {
+        if (neuron_index >= neuron_counts.size()) continue;
+        ++neuron_counts[neuron_index];
+        ++statistics.spikes_count_;
+        if (histogram.empty()) continue;
+
+        const Step last_step = last_steps[neuron_index];
+        last_steps[neuron_index] = step;
+        if (last_step == no_spike || last_step >= step) continue;
+        const size_t bin = (step - last_step - 1) / statistics.isi_bin_width_;
+        ++histogram[std::min(bin, histogram.size() - 1)];
+    }
+}
+
+
+PopulationStatistics StatisticsCollector::get_statistics(const UID &population_uid, Step step) const
+{
+    auto iter = populations_.find(population_uid);
+    if (iter == populations_.end())
+    {
+        throw std::out_of_range("Statistics are not collected for population " + std::string(population_uid) + ".");
+    }
+
+    PopulationStatistics result = iter->second.statistics_;
+    result.steps_count_ = step > result.first_step_ ? step - result.first_step_ : 0;
+    return result;
+}
+
+
+std::vector<PopulationStatistics> StatisticsCollector::get_statistics(Step step) const
+{
+    std::vector<PopulationStatistics> result;
+    result.reserve(populations_.size());
+    for (const auto &[uid, data] : populations_) result.push_back(get_statistics(uid, step));
+    return result;
+}
+
+
+void StatisticsCollector::reset(Step step)
+{
+    for (auto &[uid, data] : populations_)
+    {
+        data.statistics_.first_step_ = step;
+        data.statistics_.spikes_count_ = 0;
+        std::fill(data.statistics_.neuron_spikes_counts_.begin(), data.statistics_.neuron_spikes_counts_.end(), 0);
+        std::fill(data.statistics_.isi_histogram_.begin(), data.statistics_.isi_histogram_.end(), 0);
+    }
+}
+
+}  // namespace knp::core
@@ -0,0 +1,104 @@
+/**
+ * @file step_profiler.cpp
+ * @brief Step profiler implementation.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/core/step_profiler.h>
+
+#include <spdlog/spdlog.h>
+
+
+namespace knp::core
+{
+
+void StepProfiler::enable(const std::vector<UID> &entity_uids, bool hardware_counters)
+{
+    SPDLOG_DEBUG("Enabling step profiler for {} entities.", entity_uids.size());
+    hardware_counters_ = hardware_counters && perf_counters_supported();
+    if (hardware_counters && !hardware_counters_)
+    {
+        SPDLOG_WARN("Hardware performance counters are unavailable, only time is profiled.");
+    }
+
+    entities_.clear();
+    entity_uids_.clear();
+    entity_uids_.reserve(entity_uids.size());
+    for (const auto &uid : entity_uids)
+    {
+        if (entities_.try_emplace(uid).second) entity_uids_.push_back(uid);
+    }
+
+    steps_.set_hardware_counters(hardware_counters_);
+    for (auto &phase : phases_) phase.set_hardware_counters(hardware_counters_);
+    for (auto &[uid, counter] : entities_) counter.set_hardware_counters(hardware_counters_);
+    reset();
+    enabled_.store(true, std::memory_order_relaxed);
+}
+
+
+StepProfiler::Counter *StepProfiler::get_entity_counter(const UID &uid)
+{
+    if (!enabled()) return nullptr;
+    auto iter = entities_.find(uid);
+    return iter != entities_.end() ? &iter->second : nullptr;
+}
+
+
+StepProfile StepProfiler::get_profile() const
+{
+    StepProfile result;
+    const auto steps = steps_.get();
+    result.steps_count_ = steps.calls_count_;
+    result.steps_time_ns_ = steps.time_ns_;
+    for (size_t phase = 0; phase < step_phases_count; ++phase) result.phases_[phase] = phases_[phase].get();
+
+    result.entities_.reserve(entity_uids_.size());
+    for (const auto &uid : entity_uids_)
+    {
+        EntityProfile entity;
+        static_cast<TimeProfile &>(entity) = entities_.at(uid).get();
+        entity.uid_ = uid;
+        result.entities_.push_back(entity);
+    }
+
+    result.messages_routed_ = messages_routed_.load(std::memory_order_relaxed);
+    result.messages_received_ = messages_received_.load(std::memory_order_relaxed);
+    result.spikes_emitted_ = spikes_emitted_.load(std::memory_order_relaxed);
+    result.impacts_sent_ = impacts_sent_.load(std::memory_order_relaxed);
+    result.fan_out_projections_ = fan_out_projections_.load(std::memory_order_relaxed);
+    result.dense_projections_ = dense_projections_.load(std::memory_order_relaxed);
+    result.hardware_counters_ = hardware_counters_;
+    return result;
+}
+
+
+void StepProfiler::reset()
+{
+    steps_.reset();
+    for (auto &phase : phases_) phase.reset();
+    for (auto &[uid, counter] : entities_) counter.reset();
+    messages_routed_.store(0, std::memory_order_relaxed);
+    messages_received_.store(0, std::memory_order_relaxed);
+    spikes_emitted_.store(0, std::memory_order_relaxed);
+    impacts_sent_.store(0, std::memory_order_relaxed);
+    fan_out_projections_.store(0, std::memory_order_relaxed);
+    dense_projections_.store(0, std::memory_order_relaxed);
+}
+
+}  // namespace knp::core
@@ -0,0 +1,184 @@
+/**
+ * @file tracer.cpp
+ * @brief Tracer implementation.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/core/tracer.h>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+
+namespace knp::core
+{
+
+namespace
+{
+std::atomic<uint64_t> next_tracer_id = 0;
+
+// Write nanoseconds as microseconds, which are Chrome trace time units.
+void write_us(std::ostream &stream, uint64_t time_ns)
+{
+    stream << time_ns / 1000 << '.' << std::to_string(1000 + time_ns % 1000).substr(1);
+}
+}  // namespace
+
+
+Tracer::Tracer(size_t events_per_thread)
+    : id_(next_tracer_id.fetch_add(1, std::memory_order_relaxed)),
+      events_per_thread_(std::max<size_t>(events_per_thread, 1)),
+      origin_(std::chrono::steady_clock::now())
+{
+}
+
+
+Tracer::ThreadBuffer &Tracer::get_thread_buffer()
+{
+    // Buffers of the current thread for each tracer. Tracer IDs are unique, so entries of destroyed tracers are never
+    // matched. Buffers are released when the thread exits.
+    struct ThreadBuffers
+    {
+        struct Entry
+        {
+            uint64_t tracer_id_;
+            ThreadBuffer *buffer_;
+            // Expires when the tracer is destroyed.
+            std::weak_ptr<ThreadBuffer> owner_;
+        };
+
+        ~ThreadBuffers()
+        {
+            for (const auto &entry : entries_)
+            {
+                if (auto buffer = entry.owner_.lock()) buffer->released_.store(true, std::memory_order_release);
+            }
+        }
+
+        std::vector<Entry> entries_;
+    };
+    thread_local ThreadBuffers thread_buffers;
+
+    auto &entries = thread_buffers.entries_;
+    for (const auto &entry : entries)
+    {
+        if (entry.tracer_id_ == id_) return *entry.buffer_;
+    }
+
+    // Remove entries of destroyed tracers, so that a long-living thread doesn't accumulate them.
+    entries.erase(
+        std::remove_if(entries.begin(), entries.end(), [](const auto &entry) { return entry.owner_.expired(); }),
+        entries.end());
+
+    std::lock_guard lock(mutex_);
+    auto buffer_iter = std::find_if(
+        buffers_.begin(), buffers_.end(),
+        [](const auto &buffer) { return buffer->released_.exchange(false, std::memory_order_acq_rel); });
+    if (buffer_iter == buffers_.end())
+    {
+        buffers_.push_back(std::make_shared<ThreadBuffer>(events_per_thread_));
+        buffer_iter = buffers_.end() - 1;
+        SPDLOG_TRACE("Tracer {} created buffer #{}.", id_, buffers_.size() - 1);
+    }
+    entries.push_back({id_, buffer_iter->get(), *buffer_iter});
+    return **buffer_iter;
+}
+
+
+void Tracer::add_event(
+    const char *name, const char *category, std::chrono::steady_clock::time_point begin,
+    std::chrono::steady_clock::time_point end)
+{
+    auto &buffer = get_thread_buffer();
+    const uint64_t written = buffer.written_.load(std::memory_order_relaxed);
+    buffer.events_[written % buffer.events_.size()] = TraceEvent{name, category, to_ns(begin), to_ns(end)};
+    buffer.written_.store(written + 1, std::memory_order_release);
+}
+
+
+std::vector<std::vector<TraceEvent>> Tracer::get_events() const
+{
+    std::lock_guard lock(mutex_);
+    std::vector<std::vector<TraceEvent>> result;
+    result.reserve(buffers_.size());
+
+    for (const auto &buffer : buffers_)
+    {
+        const uint64_t written = buffer->written_.load(std::memory_order_acquire);
+        const size_t capacity = buffer->events_.size();
+        std::vector<TraceEvent> events;
+        events.reserve(std::min<uint64_t>(written, capacity));
+        for (uint64_t index = written > capacity ? written - capacity : 0; index < written; ++index)
+        {
+            events.push_back(buffer->events_[index % capacity]);
+        }
+        result.push_back(std::move(events));
+    }
+
+    return result;
+}
+
+
+void Tracer::write_chrome_trace(std::ostream &stream) const
+{
+    const auto events = get_events();
+
+    stream << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+    bool first = true;
+    for (size_t thread_index = 0; thread_index < events.size(); ++thread_index)
+    {
+        if (!first) stream << ',';
+        first = false;
+        stream << "\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << thread_index
+               << ", \"args\": {\"name\": \"Thread " << thread_index << "\"}}";
+
+        for (const auto &event : events[thread_index])
+        {
+            stream << ",\n{\"name\": \"" << event.name_ << "\", \"cat\": \"" << event.category_
+                   << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << thread_index << ", \"ts\": ";
+            write_us(stream, event.begin_ns_);
+            stream << ", \"dur\": ";
+            write_us(stream, event.end_ns_ > event.begin_ns_ ? event.end_ns_ - event.begin_ns_ : 0);
+            stream << '}';
+        }
+    }
+    stream << "\n]}\n";
+}
+
+
+void Tracer::save_chrome_trace(const std::filesystem::path &path) const
+{
+    SPDLOG_DEBUG("Saving trace to {}...", path.string());
+    std::ofstream stream(path);
+    if (!stream) throw std::runtime_error("Can't open file " + path.string() + ".");
+    write_chrome_trace(stream);
+}
+
+
+void Tracer::clear()
+{
+    std::lock_guard lock(mutex_);
+    for (auto &buffer : buffers_) buffer->written_.store(0, std::memory_order_relaxed);
+}
+
+}  // namespace knp::core
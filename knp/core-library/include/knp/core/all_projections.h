@@ -0,0 +1,72 @@
+/**
+ * @file all_projections.h
+ * @brief List of all projection types.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <knp/core/compact_projection.h>
+#include <knp/core/convolution_projection.h>
+#include <knp/core/procedural_projection.h>
+#include <knp/core/projection.h>
+#include <knp/synapse-traits/all_traits.h>
+
+#include <variant>
+
+#include <boost/mp11.hpp>
+
+
+/**
+ * @brief Core library namespace.
+ */
+namespace knp::core
+{
+/**
+ * @brief List of projection types that store synapses in other ways than `Projection`.
+ * @details The projections are used for inference and support only delta synapses.
+ */
+using InferenceProjections = boost::mp11::mp_list<
+    CompactProjection<synapse_traits::DeltaSynapse>, ProceduralProjection<synapse_traits::DeltaSynapse>,
+    ConvolutionProjection<synapse_traits::DeltaSynapse>>;
+
+
+/**
+ * @brief List of projection types based on synapse types specified in `knp::synapse_traits::AllSynapses`.
+ * @details `AllProjections` takes the value of `Projection<SynapseType_1>, Projection<SynapseType_2>, ...,
+ * Projection<SynapseType_n>`, where `SynapseType_[1..n]` is the synapse type specified in
+ * `knp::synapse_traits::AllSynapses`, followed by `InferenceProjections`. \n For example, if
+ * `knp::synapse_traits::AllSynapses` contains DeltaSynapse and AdditiveSTDPSynapse types, then `AllProjections` =
+ * `Projection<DeltaSynapse>, Projection<AdditiveSTDPSynapse>, CompactProjection<DeltaSynapse>, ...`.
+ */
+using AllProjections = boost::mp11::mp_append<
+    boost::mp11::mp_transform<knp::core::Projection, knp::synapse_traits::AllSynapses>, InferenceProjections>;
+
+/**
+ * @brief Projection variant that contains any projection type specified in `AllProjections`.
+ * @details `AllProjectionVariants` takes the value of `std::variant<ProjectionType_1,..., ProjectionType_n>`, where
+ * `ProjectionType_[1..n]` is the projection type specified in `AllProjections`. \n For example, if `AllProjections`
+ * contains DeltaSynapse and AdditiveSTDPSynapse types, then `AllProjectionVariants = std::variant<DeltaSynapse,
+ * AdditiveSTDPSynapse>`. \n `AllProjectionVariants` retains the same order of message types as defined in
+ * `AllProjections`.
+ * @see ALL_SYNAPSES.
+ */
+using AllProjectionsVariant = boost::mp11::mp_rename<AllProjections, std::variant>;
+
+
+}  // namespace knp::core
@@ -21,13 +21,17 @@
 
 #pragma once
 
+#include <knp/core/all_projections.h>
 #include <knp/core/core.h>
 #include <knp/core/device.h>
 #include <knp/core/message_bus.h>
 #include <knp/core/population.h>
-#include <knp/core/projection.h>
+#include <knp/core/statistics.h>
+#include <knp/core/step_profiler.h>
+#include <knp/core/tracer.h>
 
 #include <atomic>
+#include <filesystem>
 #include <functional>
 #include <memory>
 #include <set>
@@ -234,6 +238,49 @@ public:
      */
     void start(const RunPredicate &run_predicate);
 
+    /**
+     * @brief Run a given number of steps.
+     * @details Unlike `start()`, no predicates are called between steps. Execution stops earlier if `stop()`
+     * is called.
+     * @param steps_count number of steps to run.
+     * @return number of steps made.
+     */
+    size_t run_steps(size_t steps_count)
+    {
+        return run_steps(steps_count, [](core::Step) {});
+    }
+
+    /**
+     * @brief Run a given number of steps, calling a function before each step.
+     * @details The function is not wrapped into `std::function`, so it can be inlined into the step loop.
+     * Execution stops earlier if `stop()` is called.
+     * @param steps_count number of steps to run.
+     * @param pre_step function that gets the number of the step to make.
+     * @tparam PreStep function type.
+     * @return number of steps made.
+     */
+    template <class PreStep>
+    size_t run_steps(size_t steps_count, PreStep &&pre_step)
+    {
+        pre_start();
+
+        size_t steps_made = 0;
+        try
+        {
+            for (; steps_made < steps_count && running(); ++steps_made)
+            {
+                pre_step(step_);
+                _step();
+            }
+        }
+        catch (...)
+        {
+            started_ = false;
+            throw;
+        }
+        return steps_made;
+    }
+
     /**
      * @brief Stop network execution on the backend.
      */
@@ -255,6 +302,120 @@ public:
      */
     virtual void start_learning() = 0;
 
+public:
+    /**
+     * @brief Start collecting spike statistics of a population.
+     * @details Statistics are accumulated during the backend step without exporting spike messages.
+     * If statistics of the population are already collected, they are reset.
+     * @param population_uid UID of a population loaded to the backend.
+     * @param settings statistics settings.
+     * @throw std::logic_error if the backend has no population with the given UID.
+     */
+    void enable_statistics(const UID &population_uid, const StatisticsSettings &settings = {});
+
+    /**
+     * @brief Stop collecting spike statistics of a population.
+     * @param population_uid population UID.
+     */
+    void disable_statistics(const UID &population_uid) { statistics_.remove_population(population_uid); }
+
+    /**
+     * @brief Get spike statistics of a population accumulated since the last reset.
+     * @param population_uid population UID.
+     * @throw std::out_of_range if statistics are not collected for the population.
+     * @return copy of population statistics.
+     */
+    [[nodiscard]] PopulationStatistics get_statistics(const UID &population_uid) const
+    {
+        return statistics_.get_statistics(population_uid, step_);
+    }
+
+    /**
+     * @brief Get spike statistics of all populations accumulated since the last reset.
+     * @return copies of population statistics.
+     */
+    [[nodiscard]] std::vector<PopulationStatistics> get_statistics() const { return statistics_.get_statistics(step_); }
+
+    /**
+     * @brief Reset accumulated spike statistics of all populations.
+     */
+    void reset_statistics() { statistics_.reset(step_); }
+
+public:
+    /**
+     * @brief Start profiling of backend steps.
+     * @details Time of step phases, populations and projections, and counts of messages, spikes and impacts are
+     * accumulated during steps. Accumulated data are reset.
+     * @param hardware_counters `true` to also account hardware performance counters, such as cycles and cache misses.
+     * Counters are accounted only if the system allows reading them.
+     * @note Populations and projections loaded after the call are not measured.
+     */
+    void enable_profiling(bool hardware_counters = false);
+
+    /**
+     * @brief Stop profiling of backend steps.
+     * @details Accumulated data are kept until they are reset or profiling is enabled again.
+     */
+    void disable_profiling() { profiler_.disable(); }
+
+    /**
+     * @brief Determine if profiling of backend steps is enabled.
+     * @return `true` if profiling is enabled.
+     */
+    [[nodiscard]] bool is_profiling_enabled() const { return profiler_.enabled(); }
+
+    /**
+     * @brief Get profiling data accumulated since the last reset.
+     * @return copy of profiling data.
+     */
+    [[nodiscard]] StepProfile get_profile() const { return profiler_.get_profile(); }
+
+    /**
+     * @brief Reset accumulated profiling data.
+     */
+    void reset_profile() { profiler_.reset(); }
+
+public:
+    /**
+     * @brief Start recording a timeline of backend steps.
+     * @details Backend phases, message routing and thread pool tasks are recorded to per-thread ring buffers.
+     */
+    void enable_tracing() { tracer_.enable(); }
+
+    /**
+     * @brief Stop recording a timeline of backend steps.
+     * @details Recorded events are kept until the trace is cleared.
+     */
+    void disable_tracing() { tracer_.disable(); }
+
+    /**
+     * @brief Determine if the timeline of backend steps is recorded.
+     * @return `true` if tracing is enabled.
+     */
+    [[nodiscard]] bool is_tracing_enabled() const { return tracer_.enabled(); }
+
+    /**
+     * @brief Save the recorded timeline in the Chrome trace JSON format.
+     * @details The file can be opened by `chrome://tracing` or Perfetto UI.
+     * @param path path to file.
+     * @throw std::runtime_error if the file cannot be opened.
+     */
+    void save_trace(const std::filesystem::path &path) const { tracer_.save_chrome_trace(path); }
+
+    /**
+     * @brief Remove all recorded timeline events.
+     */
+    void clear_trace() { tracer_.clear(); }
+
+public:
+    /**
+     * @brief Get memory used by the backend.
+     * @details The base implementation accounts the backend message endpoint. Backends add memory used by
+     * the loaded network and their own data, such as queues of future projection messages.
+     * @return memory usage.
+     */
+    [[nodiscard]] virtual MemoryUsage memory_usage() const;
+
 public:
     /**
      * @brief Get network execution status.
@@ -378,6 +539,34 @@ protected:
      */
     core::Step gad_step() { return step_++; }
 
+    /**
+     * @brief Account spikes sent by a population in statistics and step profile.
+     * @param message spike message sent by a population.
+     */
+    void collect_statistics(const messaging::SpikeMessage &message)
+    {
+        if (!statistics_.empty()) statistics_.add_spikes(message);
+        profiler_.add_spikes(message.neuron_indexes_.size());
+    }
+
+    /**
+     * @brief Get step profiler.
+     * @return step profiler.
+     */
+    StepProfiler &get_profiler() { return profiler_; }
+
+    /**
+     * @brief Get timeline tracer.
+     * @return tracer.
+     */
+    Tracer &get_tracer() { return tracer_; }
+
+    /**
+     * @brief Route messages via the message bus and receive them by the backend endpoint.
+     * @details Time of routing and receiving and message counts are accounted by the step profiler and the tracer.
+     */
+    void route_messages();
+
 private:
     void pre_start();
 
@@ -389,6 +578,9 @@ private:
     MessageBus message_bus_;
     MessageEndpoint message_endpoint_;
     core::Step step_ = 0;
+    StatisticsCollector statistics_;
+    StepProfiler profiler_;
+    Tracer tracer_;
 };
 
 }  // namespace knp::core
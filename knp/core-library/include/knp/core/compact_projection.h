@@ -0,0 +1,639 @@
+/**
+ * @file compact_projection.h
+ * @brief Compact read-only storage of projection synapses.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <knp/core/memory_usage.h>
+#include <knp/core/projection.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+/**
+ * @brief Core library namespace.
+ */
+namespace knp::core
+{
+/**
+ * @brief Formats of synaptic weights in compact storage.
+ */
+enum class WeightFormat
+{
+    /**
+     * @brief 32-bit floating point, weights are stored without loss.
+     */
+    float32,
+    /**
+     * @brief IEEE 754 half precision: 11 significant bits, values up to `65504`.
+     */
+    float16,
+    /**
+     * @brief Brain floating point: 8 significant bits and the `float` range.
+     */
+    bfloat16,
+    /**
+     * @brief 8-bit integers multiplied by a scale shared by all projection weights.
+     */
+    int8
+};
+
+
+/**
+ * @brief Convert a `float` value to half precision rounding to the nearest even value.
+ * @param value value to convert.
+ * @return bits of the half precision value.
+ */
+inline uint16_t float_to_half(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const auto sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+    const uint32_t abs_bits = bits & 0x7FFFFFFF;
+
+    // Infinity and NaN.
+    if (abs_bits >= 0x7F800000) return sign | 0x7C00 | (abs_bits > 0x7F800000 ? 0x0200 : 0);
+    // Values that round to a value greater than the maximum half value `65504`.
+    if (abs_bits >= 0x477FF000) return sign | 0x7C00;
+
+    uint32_t result;
+    uint32_t rest;
+    uint32_t half_ulp;
+    if (abs_bits >= 0x38800000)
+    {
+        // Normal values: rebias the exponent and cut the mantissa.
+        result = (abs_bits - 0x38000000) >> 13;
+        rest = abs_bits & 0x1FFF;
+        half_ulp = 0x1000;
+    }
+    else
+    {
+        // Subnormal values, values less than `2^-25` become zero.
+        if (abs_bits < 0x33000000) return sign;
+        const uint32_t shift = 126 - (abs_bits >> 23);
+        const uint32_t mantissa = (abs_bits & 0x7FFFFF) | 0x800000;
+        result = mantissa >> shift;
+        rest = mantissa & ((1U << shift) - 1);
+        half_ulp = 1U << (shift - 1);
+    }
+    // Carry of the mantissa rounding increments the exponent.
+    if (rest > half_ulp || (rest == half_ulp && (result & 1))) ++result;
+    return sign | static_cast<uint16_t>(result);
+}
+
+
+/**
+ * @brief Convert a half precision value to `float`.
+ * @param half bits of the half precision value.
+ * @return converted value.
+ */
+inline float half_to_float(uint16_t half)
+{
+    const uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+    const uint32_t exponent = (half >> 10) & 0x1F;
+    const uint32_t mantissa = half & 0x3FF;
+
+    uint32_t bits;
+    if (exponent == 0x1F)
+    {
+        bits = sign | 0x7F800000 | (mantissa << 13);
+    }
+    else if (exponent)
+    {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+    else
+    {
+        const float value = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -value : value;
+    }
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+
+/**
+ * @brief Convert a `float` value to bfloat16 rounding to the nearest even value.
+ * @param value value to convert.
+ * @return bits of the bfloat16 value.
+ */
+inline uint16_t float_to_bfloat16(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    // Keep NaN from becoming infinity after truncation.
+    if ((bits & 0x7FFFFFFF) > 0x7F800000) return static_cast<uint16_t>((bits >> 16) | 0x0040);
+    bits += 0x7FFF + ((bits >> 16) & 1);
+    return static_cast<uint16_t>(bits >> 16);
+}
+
+
+/**
+ * @brief Convert a bfloat16 value to `float`.
+ * @param value bits of the bfloat16 value.
+ * @return converted value.
+ */
+inline float bfloat16_to_float(uint16_t value)
+{
+    const uint32_t bits = static_cast<uint32_t>(value) << 16;
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+
+/**
+ * @brief The CompactProjection class is a definition of read-only projection storage that uses less memory than
+ * `Projection`.
+ * @details A `Projection` synapse of delta type takes 32 bytes, because it contains 64-bit neuron indexes and a
+ * 32-bit delay and output type for each synapse. Compact storage keeps:
+ * - 32-bit neuron indexes;
+ * - weights in the chosen `WeightFormat`;
+ * - delay once per projection if all synapses have the same delay, and once per delay run otherwise;
+ * - output type once per projection if all synapses have the same output type, and once per synapse otherwise.
+ *
+ * Synapses are grouped by presynaptic neuron, so synapses of a neuron take a contiguous range that is found without
+ * a hash index. If delays differ, synapses within a group are sorted by delay, so that synapses of a neuron with the
+ * same delay make a contiguous delay run. Otherwise synapse order within a group is the order of the source
+ * projection. Use compact storage for inference: synapses can't be changed, and weights can lose precision.
+ * Parameters declared uniform by projection shared parameters replace per-synapse values.
+ * @tparam SynapseType type of synapses. Only delta synapses are supported.
+ */
+template <class SynapseType>
+class CompactProjection
+{
+    static_assert(
+        std::is_same_v<SynapseType, synapse_traits::DeltaSynapse>, "Compact storage supports only delta synapses.");
+
+public:
+    /**
+     * @brief Type of the projection synapses.
+     */
+    using ProjectionSynapseType = SynapseType;
+
+    /**
+     * @brief Type of the source projection.
+     */
+    using ProjectionType = Projection<SynapseType>;
+
+    /**
+     * @brief Parameters of the specified synapse type.
+     */
+    using SynapseParameters = typename ProjectionType::SynapseParameters;
+
+    /**
+     * @brief Synapse description structure that contains synapse parameters and indexes of the associated neurons.
+     */
+    using Synapse = typename ProjectionType::Synapse;
+
+    /**
+     * @brief Type of stored neuron indexes.
+     */
+    using NeuronIndex = uint32_t;
+
+    /**
+     * @brief Range of synapses of a presynaptic neuron that have the same delay.
+     */
+    struct DelayRun
+    {
+        /**
+         * @brief Index of the first run synapse.
+         */
+        size_t begin_;
+
+        /**
+         * @brief Index after the last run synapse.
+         */
+        size_t end_;
+
+        /**
+         * @brief Delay of run synapses.
+         */
+        uint32_t delay_;
+    };
+
+public:
+    /**
+     * @brief Pack synapses of a projection.
+     * @details The compact projection gets UIDs and tags of the source projection and UIDs of its populations.
+     * @param projection source projection.
+     * @param weight_format format of stored weights.
+     * @throw std::out_of_range if a neuron index doesn't fit into 32 bits.
+     */
+    explicit CompactProjection(
+        const ProjectionType &projection, WeightFormat weight_format = WeightFormat::float16);
+
+public:
+    /**
+     * @brief Get projection UID.
+     * @return projection UID.
+     */
+    [[nodiscard]] const UID &get_uid() const { return base_.uid_; }
+
+    /**
+     * @brief Get tags used by the projection.
+     * @return projection tag map.
+     * @see TagMap.
+     */
+    [[nodiscard]] auto &get_tags() { return base_.tags_; }
+
+    /**
+     * @brief Get tags used by the projection.
+     * @note Constant method.
+     * @return projection tag map.
+     * @see TagMap.
+     */
+    [[nodiscard]] const auto &get_tags() const { return base_.tags_; }
+
+    /**
+     * @brief Get UID of the associated population from which this projection receives spikes.
+     * @return UID of the presynaptic population.
+     */
+    [[nodiscard]] const UID &get_presynaptic() const { return presynaptic_uid_; }
+
+    /**
+     * @brief Get UID of the associated population to which this projection sends signals.
+     * @return UID of the postsynaptic population.
+     */
+    [[nodiscard]] const UID &get_postsynaptic() const { return postsynaptic_uid_; }
+
+    /**
+     * @brief Count number of synapses in the projection.
+     * @return number of synapses.
+     */
+    [[nodiscard]] size_t size() const { return sources_.size(); }
+
+    /**
+     * @brief Get format of stored weights.
+     * @return weight format.
+     */
+    [[nodiscard]] WeightFormat get_weight_format() const { return weight_format_; }
+
+    /**
+     * @brief Get scale of `int8` weights.
+     * @return weight scale, `1` for other formats.
+     */
+    [[nodiscard]] float get_weight_scale() const { return weight_scale_; }
+
+public:
+    /**
+     * @brief Get synaptic weight.
+     * @param index synapse index.
+     * @return weight converted to `float`.
+     */
+    [[nodiscard]] float get_weight(size_t index) const
+    {
+        switch (weight_format_)
+        {
+            case WeightFormat::float16:
+                return half_to_float(weights_16_[index]);
+            case WeightFormat::bfloat16:
+                return bfloat16_to_float(weights_16_[index]);
+            case WeightFormat::int8:
+                return static_cast<float>(weights_8_[index]) * weight_scale_;
+            default:
+                return weights_32_[index];
+        }
+    }
+
+    /**
+     * @brief Get synaptic delay.
+     * @details The delay run of the synapse is found by binary search, iterate delay runs to get delays of many
+     * synapses.
+     * @param index synapse index.
+     * @return synaptic delay.
+     */
+    [[nodiscard]] uint32_t get_delay(size_t index) const
+    {
+        if (run_delays_.empty()) return delay_;
+        const auto [first_run, last_run] = find_delay_runs(sources_[index]);
+        // The synapse belongs to the last run of its neuron that starts before or at the synapse.
+        const auto next_run =
+            std::upper_bound(run_starts_.begin() + first_run, run_starts_.begin() + last_run, index);
+        return run_delays_[next_run - run_starts_.begin() - 1];
+    }
+
+    /**
+     * @brief Get synapse output type.
+     * @param index synapse index.
+     * @return output type.
+     */
+    [[nodiscard]] synapse_traits::OutputType get_output_type(size_t index) const
+    {
+        return output_types_.empty() ? output_type_ : static_cast<synapse_traits::OutputType>(output_types_[index]);
+    }
+
+    /**
+     * @brief Get index of the presynaptic neuron of a synapse.
+     * @param index synapse index.
+     * @return presynaptic neuron index.
+     */
+    [[nodiscard]] NeuronIndex get_source(size_t index) const { return sources_[index]; }
+
+    /**
+     * @brief Get index of the postsynaptic neuron of a synapse.
+     * @param index synapse index.
+     * @return postsynaptic neuron index.
+     */
+    [[nodiscard]] NeuronIndex get_target(size_t index) const { return targets_[index]; }
+
+    /**
+     * @brief Get synapse with parameters unpacked.
+     * @param index synapse index.
+     * @return synapse parameters and indexes.
+     */
+    [[nodiscard]] Synapse get_synapse(size_t index) const
+    {
+        return Synapse{
+            SynapseParameters{get_weight(index), get_delay(index), get_output_type(index)}, sources_[index],
+            targets_[index]};
+    }
+
+    /**
+     * @brief Get delay shared by all synapses.
+     * @return delay, or no value if synapses have different delays.
+     */
+    [[nodiscard]] std::optional<uint32_t> get_uniform_delay() const
+    {
+        return run_delays_.empty() ? std::optional<uint32_t>(delay_) : std::nullopt;
+    }
+
+    /**
+     * @brief Get output type shared by all synapses.
+     * @return output type, or no value if synapses have different output types.
+     */
+    [[nodiscard]] std::optional<synapse_traits::OutputType> get_uniform_output_type() const
+    {
+        return output_types_.empty() ? std::optional<synapse_traits::OutputType>(output_type_) : std::nullopt;
+    }
+
+    /**
+     * @brief Find synapses that originate from a neuron with the given index.
+     * @param neuron_index index of a presynaptic neuron.
+     * @return first and last (exclusive) index of the neuron synapses.
+     */
+    [[nodiscard]] std::pair<size_t, size_t> find_synapses(size_t neuron_index) const
+    {
+        if (neuron_index + 1 >= offsets_.size()) return {size(), size()};
+        return {offsets_[neuron_index], offsets_[neuron_index + 1]};
+    }
+
+    /**
+     * @brief Find delay runs of synapses that originate from a neuron with the given index.
+     * @details Runs are stored only if synapses have different delays, use `get_uniform_delay()` otherwise.
+     * @param neuron_index index of a presynaptic neuron.
+     * @return first and last (exclusive) index of the neuron delay runs, runs are sorted by delay.
+     */
+    [[nodiscard]] std::pair<size_t, size_t> find_delay_runs(size_t neuron_index) const
+    {
+        if (neuron_index + 1 >= run_offsets_.size()) return {0, 0};
+        return {run_offsets_[neuron_index], run_offsets_[neuron_index + 1]};
+    }
+
+    /**
+     * @brief Get delay run.
+     * @param run_index run index.
+     * @return synapse range and delay of the run.
+     */
+    [[nodiscard]] DelayRun get_delay_run(size_t run_index) const
+    {
+        return DelayRun{run_starts_[run_index], run_starts_[run_index + 1], run_delays_[run_index]};
+    }
+
+    /**
+     * @brief Unpack synapses into a projection.
+     * @details The projection has the same UIDs and tags as the compact projection. Synapses are grouped by
+     * presynaptic neuron.
+     * @return projection.
+     */
+    [[nodiscard]] ProjectionType unpack() const
+    {
+        std::vector<Synapse> synapses;
+        synapses.reserve(size());
+        size_t run_index = 0;
+        for (size_t index = 0; index < size(); ++index)
+        {
+            // Delay runs follow synapse order, so the run of the next synapse is the same or one of the next runs.
+            while (!run_delays_.empty() && run_starts_[run_index + 1] <= index) ++run_index;
+            const uint32_t delay = run_delays_.empty() ? delay_ : run_delays_[run_index];
+            synapses.emplace_back(
+                SynapseParameters{get_weight(index), delay, get_output_type(index)}, sources_[index], targets_[index]);
+        }
+
+        ProjectionType result(base_.uid_, presynaptic_uid_, postsynaptic_uid_, std::move(synapses));
+        result.get_tags() = base_.tags_;
+        return result;
+    }
+
+    /**
+     * @brief Get memory used by the compact projection.
+     * @details Range tables of presynaptic neurons and delay runs are accounted as index memory.
+     * @return memory usage.
+     */
+    [[nodiscard]] MemoryUsage memory_usage() const
+    {
+        MemoryUsage usage;
+        usage.parameters_ = sizeof(*this) + used_bytes(sources_) + used_bytes(targets_) + used_bytes(weights_32_) +
+                            used_bytes(weights_16_) + used_bytes(weights_8_) + used_bytes(run_delays_) +
+                            used_bytes(output_types_);
+        usage.index_ = used_bytes(offsets_) + used_bytes(run_offsets_) + used_bytes(run_starts_);
+        usage.slack_ = slack_bytes(sources_) + slack_bytes(targets_) + slack_bytes(weights_32_) +
+                       slack_bytes(weights_16_) + slack_bytes(weights_8_) + slack_bytes(run_delays_) +
+                       slack_bytes(output_types_) + slack_bytes(offsets_) + slack_bytes(run_offsets_) +
+                       slack_bytes(run_starts_);
+        return usage;
+    }
+
+private:
+    // Get synapse parameters with projection-uniform values applied.
+    static SynapseParameters get_parameters(const ProjectionType &projection, size_t index)
+    {
+        return projection.get_shared_parameters().synapses_parameters_.apply(
+            std::get<synapse_data>(projection[index]));
+    }
+
+    void pack_weights(const ProjectionType &projection, const std::vector<size_t> &order);
+    // Sort synapses of each presynaptic neuron by delay and fill the delay run tables.
+    void sort_by_delay(const ProjectionType &projection, std::vector<size_t> &order);
+
+    BaseData base_;
+    UID presynaptic_uid_;
+    UID postsynaptic_uid_;
+
+    WeightFormat weight_format_;
+    float weight_scale_ = 1.0F;
+    // Only the vector of the current weight format is filled.
+    std::vector<float> weights_32_;
+    std::vector<uint16_t> weights_16_;
+    std::vector<int8_t> weights_8_;
+
+    // Delay runs and per-synapse vectors are empty if all synapses have the same value.
+    uint32_t delay_ = synapse_traits::default_values<SynapseType>::delay_;
+    // Run `r` contains synapses from `run_starts_[r]` to `run_starts_[r + 1]` with delay `run_delays_[r]`.
+    std::vector<uint32_t> run_delays_;
+    std::vector<size_t> run_starts_;
+    // Runs of presynaptic neuron `i` have indexes from `run_offsets_[i]` to `run_offsets_[i + 1]`.
+    std::vector<size_t> run_offsets_;
+    synapse_traits::OutputType output_type_ = synapse_traits::default_values<SynapseType>::output_type_;
+    std::vector<uint8_t> output_types_;
+
+    std::vector<NeuronIndex> sources_;
+    std::vector<NeuronIndex> targets_;
+    // Synapses of presynaptic neuron `i` have indexes from `offsets_[i]` to `offsets_[i + 1]`.
+    std::vector<size_t> offsets_;
+};
+
+
+template <class SynapseType>
+CompactProjection<SynapseType>::CompactProjection(const ProjectionType &projection, WeightFormat weight_format)
+    : base_{projection.get_uid(), projection.get_tags()},
+      presynaptic_uid_(projection.get_presynaptic()),
+      postsynaptic_uid_(projection.get_postsynaptic()),
+      weight_format_(weight_format)
+{
+    constexpr size_t max_index = std::numeric_limits<NeuronIndex>::max();
+    size_t presynaptic_count = 0;
+    for (const auto &synapse : projection)
+    {
+        const size_t source = std::get<source_neuron_id>(synapse);
+        if (source > max_index || std::get<target_neuron_id>(synapse) > max_index)
+            throw std::out_of_range("Neuron index doesn't fit into compact projection storage.");
+        presynaptic_count = std::max(presynaptic_count, source + 1);
+    }
+
+    // Counting sort by presynaptic neuron keeps the synapse order within a group.
+    offsets_.assign(presynaptic_count + 1, 0);
+    for (const auto &synapse : projection) ++offsets_[std::get<source_neuron_id>(synapse) + 1];
+    std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+    std::vector<size_t> order(projection.size());
+    {
+        std::vector<size_t> positions(offsets_.begin(), offsets_.end() - 1);
+        for (size_t index = 0; index < projection.size(); ++index)
+            order[positions[std::get<source_neuron_id>(projection[index])]++] = index;
+    }
+
+    if (!order.empty())
+    {
+        const auto first_params = get_parameters(projection, order.front());
+        delay_ = first_params.delay_;
+        output_type_ = first_params.output_type_;
+    }
+    // Values declared uniform by the projection are not checked.
+    const bool uniform_delay = std::all_of(
+        order.begin(), order.end(),
+        [this, &projection](size_t index) { return get_parameters(projection, index).delay_ == delay_; });
+    if (!uniform_delay) sort_by_delay(projection, order);
+
+    sources_.reserve(order.size());
+    targets_.reserve(order.size());
+    for (const size_t index : order)
+    {
+        sources_.push_back(static_cast<NeuronIndex>(std::get<source_neuron_id>(projection[index])));
+        targets_.push_back(static_cast<NeuronIndex>(std::get<target_neuron_id>(projection[index])));
+    }
+
+    pack_weights(projection, order);
+
+    const bool uniform_output_type = std::all_of(
+        order.begin(), order.end(),
+        [this, &projection](size_t index) { return get_parameters(projection, index).output_type_ == output_type_; });
+
+    if (!uniform_output_type)
+    {
+        output_types_.reserve(order.size());
+        for (const size_t index : order)
+            output_types_.push_back(static_cast<uint8_t>(get_parameters(projection, index).output_type_));
+    }
+}
+
+
+template <class SynapseType>
+void CompactProjection<SynapseType>::sort_by_delay(const ProjectionType &projection, std::vector<size_t> &order)
+{
+    std::vector<uint32_t> delays(projection.size());
+    for (const size_t index : order) delays[index] = get_parameters(projection, index).delay_;
+    auto by_delay = [&delays](size_t first, size_t second) { return delays[first] < delays[second]; };
+
+    run_offsets_.reserve(offsets_.size());
+    for (size_t neuron_index = 0; neuron_index + 1 < offsets_.size(); ++neuron_index)
+    {
+        run_offsets_.push_back(run_delays_.size());
+        // The sort is stable to keep the source order of synapses with the same delay.
+        std::stable_sort(order.begin() + offsets_[neuron_index], order.begin() + offsets_[neuron_index + 1], by_delay);
+        for (size_t position = offsets_[neuron_index]; position < offsets_[neuron_index + 1]; ++position)
+        {
+            const uint32_t delay = delays[order[position]];
+            if (position != offsets_[neuron_index] && delay == run_delays_.back()) continue;
+            run_starts_.push_back(position);
+            run_delays_.push_back(delay);
+        }
+    }
+    run_offsets_.push_back(run_delays_.size());
+    run_starts_.push_back(order.size());
+}
+
+
+template <class SynapseType>
+void CompactProjection<SynapseType>::pack_weights(const ProjectionType &projection, const std::vector<size_t> &order)
+{
+    auto weight = [&projection](size_t index) { return get_parameters(projection, index).weight_; };
+
+    switch (weight_format_)
+    {
+        case WeightFormat::float16:
+            weights_16_.reserve(order.size());
+            for (const size_t index : order) weights_16_.push_back(float_to_half(weight(index)));
+            break;
+        case WeightFormat::bfloat16:
+            weights_16_.reserve(order.size());
+            for (const size_t index : order) weights_16_.push_back(float_to_bfloat16(weight(index)));
+            break;
+        case WeightFormat::int8:
+        {
+            float max_weight = 0;
+            for (const size_t index : order) max_weight = std::max(max_weight, std::abs(weight(index)));
+            // The scale maps the largest weight to `127`, a symmetric range keeps zero exact.
+            if (max_weight > 0) weight_scale_ = max_weight / 127.0F;
+            weights_8_.reserve(order.size());
+            for (const size_t index : order)
+            {
+                const float scaled = std::clamp(std::round(weight(index) / weight_scale_), -127.0F, 127.0F);
+                weights_8_.push_back(static_cast<int8_t>(scaled));
+            }
+            break;
+        }
+        default:
+            weights_32_.reserve(order.size());
+            for (const size_t index : order) weights_32_.push_back(weight(index));
+    }
+}
+
+}  // namespace knp::core
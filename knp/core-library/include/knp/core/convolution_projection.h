@@ -0,0 +1,377 @@
+/**
+ * @file convolution_projection.h
+ * @brief Projection with weights shared by a convolution kernel.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <knp/core/memory_usage.h>
+#include <knp/core/projection.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+/**
+ * @brief Core library namespace.
+ */
+namespace knp::core
+{
+/**
+ * @brief The ConvolutionGeometry structure contains sizes of a convolution.
+ * @details Neurons of a population are channels of images that are stored row by row, so the index of the neuron
+ * at row `y` and column `x` of channel `c` is `(c * height + y) * width + x`.
+ */
+struct ConvolutionGeometry
+{
+    /**
+     * @brief Number of presynaptic image channels.
+     */
+    size_t input_channels_ = 1;
+
+    /**
+     * @brief Presynaptic image height.
+     */
+    size_t input_height_ = 1;
+
+    /**
+     * @brief Presynaptic image width.
+     */
+    size_t input_width_ = 1;
+
+    /**
+     * @brief Number of postsynaptic image channels, one kernel is applied for each channel.
+     */
+    size_t output_channels_ = 1;
+
+    /**
+     * @brief Kernel height.
+     */
+    size_t kernel_height_ = 1;
+
+    /**
+     * @brief Kernel width.
+     */
+    size_t kernel_width_ = 1;
+
+    /**
+     * @brief Vertical distance between kernel positions.
+     */
+    size_t stride_y_ = 1;
+
+    /**
+     * @brief Horizontal distance between kernel positions.
+     */
+    size_t stride_x_ = 1;
+
+    /**
+     * @brief Number of zero rows added above and below the presynaptic image.
+     */
+    size_t padding_y_ = 0;
+
+    /**
+     * @brief Number of zero columns added to the left and to the right of the presynaptic image.
+     */
+    size_t padding_x_ = 0;
+
+    /**
+     * @brief Get postsynaptic image height.
+     * @return number of kernel positions in a column.
+     */
+    [[nodiscard]] size_t output_height() const
+    {
+        return (input_height_ + 2 * padding_y_ - kernel_height_) / stride_y_ + 1;
+    }
+
+    /**
+     * @brief Get postsynaptic image width.
+     * @return number of kernel positions in a row.
+     */
+    [[nodiscard]] size_t output_width() const
+    {
+        return (input_width_ + 2 * padding_x_ - kernel_width_) / stride_x_ + 1;
+    }
+
+    /**
+     * @brief Get number of presynaptic neurons.
+     * @return presynaptic population size.
+     */
+    [[nodiscard]] size_t input_size() const { return input_channels_ * input_height_ * input_width_; }
+
+    /**
+     * @brief Get number of postsynaptic neurons.
+     * @return postsynaptic population size.
+     */
+    [[nodiscard]] size_t output_size() const { return output_channels_ * output_height() * output_width(); }
+
+    /**
+     * @brief Get number of kernel weights.
+     * @return weight tensor size.
+     */
+    [[nodiscard]] size_t kernel_size() const
+    {
+        return output_channels_ * input_channels_ * kernel_height_ * kernel_width_;
+    }
+};
+
+
+/**
+ * @brief The ConvolutionProjection class is a definition of a projection whose synapses share weights of
+ * convolution kernels.
+ * @details A postsynaptic neuron at row `y` and column `x` of channel `c` is connected to the presynaptic neurons
+ * covered by the kernel of channel `c` placed at `(y * stride_y_ - padding_y_, x * stride_x_ - padding_x_)`. The
+ * synapse weight is the kernel weight at the position of the presynaptic neuron. Weights are stored as a tensor of
+ * `[output channel][input channel][kernel row][kernel column]` shape, and all synapses have the same delay and
+ * output type. The projection stores only the weight tensor, and synapses of a spiked neuron are found by
+ * arithmetic.
+ * @tparam SynapseType type of synapses. Only delta synapses are supported.
+ */
+template <class SynapseType>
+class ConvolutionProjection
+{
+    static_assert(
+        std::is_same_v<SynapseType, synapse_traits::DeltaSynapse>,
+        "Convolution projections support only delta synapses.");
+
+public:
+    /**
+     * @brief Type of the projection synapses.
+     */
+    using ProjectionSynapseType = SynapseType;
+
+    /**
+     * @brief Type of a projection that stores the same synapses.
+     */
+    using ProjectionType = Projection<SynapseType>;
+
+    /**
+     * @brief Parameters of the specified synapse type.
+     */
+    using SynapseParameters = typename ProjectionType::SynapseParameters;
+
+public:
+    /**
+     * @brief Construct a convolution projection.
+     * @param presynaptic_uid UID of the presynaptic population.
+     * @param postsynaptic_uid UID of the postsynaptic population.
+     * @param geometry convolution sizes.
+     * @param weights kernel weights.
+     * @param delay delay of all synapses.
+     * @param output_type output type of all synapses.
+     * @throw std::invalid_argument if sizes are inconsistent.
+     */
+    ConvolutionProjection(
+        UID presynaptic_uid, UID postsynaptic_uid, const ConvolutionGeometry &geometry, std::vector<float> weights,
+        uint32_t delay = synapse_traits::default_values<SynapseType>::delay_,
+        synapse_traits::OutputType output_type = synapse_traits::default_values<SynapseType>::output_type_)
+        : ConvolutionProjection(
+              UID{}, presynaptic_uid, postsynaptic_uid, geometry, std::move(weights), delay, output_type)
+    {
+    }
+
+    /**
+     * @brief Construct a convolution projection.
+     * @param uid projection UID.
+     * @param presynaptic_uid UID of the presynaptic population.
+     * @param postsynaptic_uid UID of the postsynaptic population.
+     * @param geometry convolution sizes.
+     * @param weights kernel weights.
+     * @param delay delay of all synapses.
+     * @param output_type output type of all synapses.
+     * @throw std::invalid_argument if sizes are inconsistent.
+     */
+    ConvolutionProjection(
+        UID uid, UID presynaptic_uid, UID postsynaptic_uid, const ConvolutionGeometry &geometry,
+        std::vector<float> weights, uint32_t delay = synapse_traits::default_values<SynapseType>::delay_,
+        synapse_traits::OutputType output_type = synapse_traits::default_values<SynapseType>::output_type_)
+        : base_{uid},
+          presynaptic_uid_(presynaptic_uid),
+          postsynaptic_uid_(postsynaptic_uid),
+          geometry_(geometry),
+          weights_(std::move(weights)),
+          delay_(delay),
+          output_type_(output_type)
+    {
+        if (!geometry_.stride_y_ || !geometry_.stride_x_ || !geometry_.kernel_height_ || !geometry_.kernel_width_)
+            throw std::invalid_argument("Convolution kernel and stride sizes must be positive.");
+        if (geometry_.kernel_height_ > geometry_.input_height_ + 2 * geometry_.padding_y_ ||
+            geometry_.kernel_width_ > geometry_.input_width_ + 2 * geometry_.padding_x_)
+            throw std::invalid_argument("Convolution kernel is larger than the padded input image.");
+        if (weights_.size() != geometry_.kernel_size())
+            throw std::invalid_argument("Number of convolution weights doesn't match the kernel size.");
+    }
+
+public:
+    /**
+     * @brief Get projection UID.
+     * @return projection UID.
+     */
+    [[nodiscard]] const UID &get_uid() const { return base_.uid_; }
+
+    /**
+     * @brief Get tags used by the projection.
+     * @return projection tag map.
+     * @see TagMap.
+     */
+    [[nodiscard]] auto &get_tags() { return base_.tags_; }
+
+    /**
+     * @brief Get tags used by the projection.
+     * @note Constant method.
+     * @return projection tag map.
+     * @see TagMap.
+     */
+    [[nodiscard]] const auto &get_tags() const { return base_.tags_; }
+
+    /**
+     * @brief Get UID of the associated population from which this projection receives spikes.
+     * @return UID of the presynaptic population.
+     */
+    [[nodiscard]] const UID &get_presynaptic() const { return presynaptic_uid_; }
+
+    /**
+     * @brief Get UID of the associated population to which this projection sends signals.
+     * @return UID of the postsynaptic population.
+     */
+    [[nodiscard]] const UID &get_postsynaptic() const { return postsynaptic_uid_; }
+
+    /**
+     * @brief Get convolution sizes.
+     * @return convolution geometry.
+     */
+    [[nodiscard]] const ConvolutionGeometry &get_geometry() const { return geometry_; }
+
+    /**
+     * @brief Get kernel weights.
+     * @details Weights can be changed, but the number of weights must not change.
+     * @return weight tensor.
+     */
+    [[nodiscard]] std::vector<float> &get_weights() { return weights_; }
+
+    /**
+     * @brief Get kernel weights.
+     * @note Constant method.
+     * @return weight tensor.
+     */
+    [[nodiscard]] const std::vector<float> &get_weights() const { return weights_; }
+
+    /**
+     * @brief Get delay of all synapses.
+     * @return synaptic delay.
+     */
+    [[nodiscard]] uint32_t get_delay() const { return delay_; }
+
+    /**
+     * @brief Get output type of all synapses.
+     * @return output type.
+     */
+    [[nodiscard]] synapse_traits::OutputType get_output_type() const { return output_type_; }
+
+public:
+    /**
+     * @brief Call a function for each synapse of a presynaptic neuron.
+     * @param neuron_index presynaptic neuron index.
+     * @param function functor that gets a weight index, a postsynaptic neuron index and a weight.
+     * @tparam Function functor type.
+     */
+    template <class Function>
+    void for_each_synapse(size_t neuron_index, Function &&function) const
+    {
+        const auto &g = geometry_;
+        if (neuron_index >= g.input_size()) return;
+        const size_t input_channel = neuron_index / (g.input_height_ * g.input_width_);
+        const size_t padded_y = neuron_index / g.input_width_ % g.input_height_ + g.padding_y_;
+        const size_t padded_x = neuron_index % g.input_width_ + g.padding_x_;
+        const size_t output_height = g.output_height();
+        const size_t output_width = g.output_width();
+
+        // Kernel positions that cover the neuron: `y * stride <= padded_y < y * stride + kernel_height`.
+        const size_t first_y = padded_y < g.kernel_height_ ? 0 : (padded_y - g.kernel_height_) / g.stride_y_ + 1;
+        const size_t last_y = std::min(padded_y / g.stride_y_ + 1, output_height);
+        const size_t first_x = padded_x < g.kernel_width_ ? 0 : (padded_x - g.kernel_width_) / g.stride_x_ + 1;
+        const size_t last_x = std::min(padded_x / g.stride_x_ + 1, output_width);
+
+        for (size_t output_channel = 0; output_channel < g.output_channels_; ++output_channel)
+        {
+            const size_t kernel_offset = (output_channel * g.input_channels_ + input_channel) * g.kernel_height_;
+            for (size_t y = first_y; y < last_y; ++y)
+            {
+                const size_t kernel_row = kernel_offset + padded_y - y * g.stride_y_;
+                const size_t output_row = (output_channel * output_height + y) * output_width;
+                for (size_t x = first_x; x < last_x; ++x)
+                {
+                    const size_t weight_index = kernel_row * g.kernel_width_ + padded_x - x * g.stride_x_;
+                    function(weight_index, output_row + x, weights_[weight_index]);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Create a projection that stores every synapse of the convolution.
+     * @details Use the method to save the network or to load it to backends that don't support convolutions.
+     * Synapses are grouped by presynaptic neuron. The projection has the same UIDs and tags.
+     * @return projection.
+     */
+    [[nodiscard]] ProjectionType materialize() const
+    {
+        std::vector<typename ProjectionType::Synapse> synapses;
+        for (size_t neuron_index = 0; neuron_index < geometry_.input_size(); ++neuron_index)
+        {
+            for_each_synapse(
+                neuron_index,
+                [this, neuron_index, &synapses](size_t, size_t postsynaptic_index, float weight)
+                {
+                    synapses.emplace_back(
+                        SynapseParameters{weight, delay_, output_type_}, neuron_index, postsynaptic_index);
+                });
+        }
+
+        ProjectionType result(base_.uid_, presynaptic_uid_, postsynaptic_uid_);
+        result.add_synapses([&synapses](size_t index) { return synapses[index]; }, synapses.size());
+        result.get_tags() = base_.tags_;
+        return result;
+    }
+
+    /**
+     * @brief Get memory used by the projection.
+     * @return memory usage.
+     */
+    [[nodiscard]] MemoryUsage memory_usage() const
+    {
+        MemoryUsage usage;
+        usage.parameters_ = sizeof(*this) + used_bytes(weights_);
+        usage.slack_ = slack_bytes(weights_);
+        return usage;
+    }
+
+private:
+    BaseData base_;
+    UID presynaptic_uid_;
+    UID postsynaptic_uid_;
+    ConvolutionGeometry geometry_;
+    std::vector<float> weights_;
+    uint32_t delay_;
+    synapse_traits::OutputType output_type_;
+};
+
+}  // namespace knp::core
@@ -0,0 +1,139 @@
+/**
+ * @file counter_rng.h
+ * @brief Counter-based random number generator.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+
+/**
+ * @brief Core library namespace.
+ */
+namespace knp::core
+{
+/**
+ * @brief The Philox4x32 class is a definition of the Philox4x32-10 counter-based random number generator.
+ * @details The generator output is a function of a key and a counter, so generators with the same key and
+ * different stream numbers produce independent sequences without any shared state. Use the stream number to
+ * get the same random numbers for an entity, for example a synapse or a neuron, regardless of the order in which
+ * entities are processed and the number of threads processing them.\n
+ * The class satisfies the `UniformRandomBitGenerator` requirements and can be used with standard distributions.
+ * @see Salmon J. K. et al. Parallel random numbers: as easy as 1, 2, 3.
+ */
+class Philox4x32
+{
+public:
+    /**
+     * @brief Type of generated values.
+     */
+    using result_type = uint32_t;
+
+    /**
+     * @brief Generator block type.
+     */
+    using Block = std::array<uint32_t, 4>;
+
+    /**
+     * @brief Generator key type.
+     */
+    using Key = std::array<uint32_t, 2>;
+
+public:
+    /**
+     * @brief Construct a generator.
+     * @param seed generator seed used as a key.
+     * @param stream number of an independent sequence of random numbers.
+     */
+    explicit Philox4x32(uint64_t seed = 0, uint64_t stream = 0)
+        : key_{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)},
+          counter_{0, 0, static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32)}
+    {
+    }
+
+    /**
+     * @brief Get minimum generated value.
+     * @return minimum value.
+     */
+    static constexpr result_type min() { return std::numeric_limits<result_type>::min(); }
+
+    /**
+     * @brief Get maximum generated value.
+     * @return maximum value.
+     */
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    /**
+     * @brief Generate a random value.
+     * @return random value.
+     */
+    result_type operator()()
+    {
+        if (position_ == block_.size())
+        {
+            block_ = generate(counter_, key_);
+            // The lower half of the counter numbers blocks within a stream.
+            if (!++counter_[0]) ++counter_[1];
+            position_ = 0;
+        }
+        return block_[position_++];
+    }
+
+    /**
+     * @brief Apply the Philox4x32-10 bijection to a counter.
+     * @param counter counter.
+     * @param key key.
+     * @return random block.
+     */
+    static constexpr Block generate(Block counter, Key key)
+    {
+        for (int round = 0; round < rounds; ++round)
+        {
+            if (round)
+            {
+                key[0] += key_increment_0;
+                key[1] += key_increment_1;
+            }
+            const uint64_t product_0 = static_cast<uint64_t>(multiplier_0) * counter[0];
+            const uint64_t product_1 = static_cast<uint64_t>(multiplier_1) * counter[2];
+            counter = {
+                static_cast<uint32_t>(product_1 >> 32) ^ counter[1] ^ key[0], static_cast<uint32_t>(product_1),
+                static_cast<uint32_t>(product_0 >> 32) ^ counter[3] ^ key[1], static_cast<uint32_t>(product_0)};
+        }
+        return counter;
+    }
+
+private:
+    static constexpr int rounds = 10;
+    static constexpr uint32_t multiplier_0 = 0xD2511F53;
+    static constexpr uint32_t multiplier_1 = 0xCD9E8D57;
+    static constexpr uint32_t key_increment_0 = 0x9E3779B9;
+    static constexpr uint32_t key_increment_1 = 0xBB67AE85;
+
+    Key key_;
+    Block counter_;
+    Block block_{};
+    size_t position_ = block_.size();
+};
+
+}  // namespace knp::core
@@ -0,0 +1,128 @@
+/**
+ * @file memory_usage.h
+ * @brief Memory footprint accounting.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+
+/**
+ * @brief Core library namespace.
+ */
+namespace knp::core
+{
+/**
+ * @brief The MemoryUsage structure contains memory used by an object, in bytes by category.
+ * @details Sizes of hash containers are estimated: node and bucket sizes of standard and Boost implementations
+ * are not public, so each node is considered to contain a value and a pointer for each index.
+ */
+struct MemoryUsage
+{
+    /**
+     * @brief Memory used by neuron or synapse parameters.
+     */
+    size_t parameters_ = 0;
+
+    /**
+     * @brief Memory used by projection search indexes.
+     */
+    size_t index_ = 0;
+
+    /**
+     * @brief Memory used by messages waiting to be processed, including message data.
+     */
+    size_t messages_ = 0;
+
+    /**
+     * @brief Memory used by subscriptions, excluding their messages.
+     */
+    size_t subscriptions_ = 0;
+
+    /**
+     * @brief Memory allocated by containers, but not used: capacity slack of vectors.
+     */
+    size_t slack_ = 0;
+
+    /**
+     * @brief Get total memory usage.
+     * @return sum of all categories.
+     */
+    [[nodiscard]] size_t total() const { return parameters_ + index_ + messages_ + subscriptions_ + slack_; }
+
+    /**
+     * @brief Add memory usage of another object.
+     * @param other memory usage to add.
+     * @return reference to this object.
+     */
+    MemoryUsage &operator+=(const MemoryUsage &other)
+    {
+        parameters_ += other.parameters_;
+        index_ += other.index_;
+        messages_ += other.messages_;
+        subscriptions_ += other.subscriptions_;
+        slack_ += other.slack_;
+        return *this;
+    }
+};
+
+
+/**
+ * @brief Get memory used by vector elements.
+ * @param vector vector.
+ * @tparam Vector vector type.
+ * @return size of elements in bytes.
+ */
+template <class Vector>
+[[nodiscard]] size_t used_bytes(const Vector &vector)
+{
+    return vector.size() * sizeof(typename Vector::value_type);
+}
+
+
+/**
+ * @brief Get memory allocated by a vector, but not used by its elements.
+ * @param vector vector.
+ * @tparam Vector vector type.
+ * @return size of capacity slack in bytes.
+ */
+template <class Vector>
+[[nodiscard]] size_t slack_bytes(const Vector &vector)
+{
+    return (vector.capacity() - vector.size()) * sizeof(typename Vector::value_type);
+}
+
+
+/**
+ * @brief Estimate memory used by a standard hash container.
+ * @details Each node is considered to contain the value and a pointer to the next node. Memory allocated by values
+ * themselves, such as vector data, is not included.
+ * @param container unordered set or map.
+ * @tparam Container container type.
+ * @return estimated size in bytes.
+ */
+template <class Container>
+[[nodiscard]] size_t hash_container_bytes(const Container &container)
+{
+    return container.size() * (sizeof(typename Container::value_type) + sizeof(void *)) +
+           container.bucket_count() * sizeof(void *);
+}
+
+}  // namespace knp::core
@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <knp/core/memory_usage.h>
 #include <knp/core/messaging/message_envelope.h>
 #include <knp/core/messaging/messaging.h>
 #include <knp/core/subscription.h>
@@ -196,6 +197,14 @@ public:
      */
     const SubscriptionContainer &get_endpoint_subscriptions() const { return subscriptions_; }
 
+    /**
+     * @brief Get memory used by the endpoint subscriptions.
+     * @details Memory of messages that were received by the endpoint, but not unloaded by receivers, is accounted
+     * as message memory. Sender sets are accounted as subscription memory.
+     * @return memory usage.
+     */
+    [[nodiscard]] MemoryUsage memory_usage() const;
+
     /**
      * @brief Get senders list.
      * @return weak pointer to unordered set of sender UIDs.
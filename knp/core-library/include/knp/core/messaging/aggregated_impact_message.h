@@ -0,0 +1,148 @@
+/**
+ * @file aggregated_impact_message.h
+ * @brief Aggregated impact message class.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <knp/synapse-traits/output_types.h>
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "message_header.h"
+#include "synaptic_impact_message.h"
+
+
+/**
+ * @brief Messaging namespace.
+ */
+namespace knp::core::messaging
+{
+
+/**
+ * @brief Structure that contains summed impacts of one output type on postsynaptic neurons.
+ * @details Values are either dense or sparse. Dense values are indexed by postsynaptic neuron index, sparse values
+ * correspond to neuron indexes sorted in ascending order.
+ */
+struct AggregatedImpacts
+{
+    /**
+     * @brief Synapse type that defines the value role inside the neuron function.
+     */
+    knp::synapse_traits::OutputType synapse_type_;
+
+    /**
+     * @brief Indexes of postsynaptic neurons in ascending order, empty if values are dense.
+     */
+    std::vector<uint32_t> neuron_indexes_;
+
+    /**
+     * @brief Summed impact values.
+     */
+    std::vector<float> values_;
+
+    /**
+     * @brief Determine if values are dense.
+     * @return `true` if a value index is a postsynaptic neuron index.
+     */
+    [[nodiscard]] bool is_dense() const { return neuron_indexes_.empty(); }
+
+    /**
+     * @brief Compare aggregated impacts.
+     * @return `true` if aggregated impacts are equal.
+     */
+    bool operator==(const AggregatedImpacts &) const;
+};
+
+
+/**
+ * @brief Structure of the aggregated impact message.
+ * @details The message replaces a synaptic impact message if the receiving neurons don't need to know which synapses
+ * made impacts. Impacts of one output type on one neuron are summed by the sender.
+ */
+struct AggregatedImpactMessage
+{
+    /**
+     * @brief Message header.
+     */
+    MessageHeader header_;
+
+    /**
+     * @brief UID of the population that sends spikes to the projection.
+     */
+    UID presynaptic_population_uid_;
+
+    /**
+     * @brief UID of the population that receives impacts from the projection.
+     */
+    UID postsynaptic_population_uid_;
+
+    /**
+     * @brief Boolean value that defines whether the signal is from a projection without plasticity.
+     * @see SynapticImpactMessage::is_forcing_.
+     */
+    bool is_forcing_ = false;
+
+    /**
+     * @brief Impact values grouped by output type, at most one group for each type.
+     */
+    std::vector<AggregatedImpacts> impacts_;
+};
+
+
+/**
+ * @brief Sum impacts of a synaptic impact message.
+ * @details Blocking impacts are not summed, the value of the last impact on a neuron is kept, as neurons apply it.
+ * Values are dense if more than half of neurons up to the largest impacted index get impacts. Blocking impacts and
+ * excitatory impacts of a forcing message are always sparse, because a dense value changes a neuron even if it is
+ * zero.
+ * @param message synaptic impact message.
+ * @return aggregated impact message with the same header and population UIDs.
+ */
+AggregatedImpactMessage aggregate_impacts(const SynapticImpactMessage &message);
+
+
+/**
+ * @brief Check if two aggregated impact messages are the same.
+ * @param am1 first message.
+ * @param am2 second message.
+ * @return `true` if both messages are the same.
+ */
+bool operator==(const AggregatedImpactMessage &am1, const AggregatedImpactMessage &am2);
+
+
+/**
+ * @brief Send aggregated impact message to an output stream.
+ * @param stream output stream.
+ * @param msg aggregated impact message to send to the output stream.
+ * @return output stream.
+ */
+std::ostream &operator<<(std::ostream &stream, const AggregatedImpactMessage &msg);
+
+
+/**
+ * @brief Get aggregated impact message from an input stream.
+ * @param stream input stream.
+ * @param msg aggregated impact message to get from the input stream.
+ * @return input stream.
+ */
+std::istream &operator>>(std::istream &stream, AggregatedImpactMessage &msg);
+
+}  // namespace knp::core::messaging
@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <knp/core/messaging/aggregated_impact_message.h>
 #include <knp/core/messaging/message_header.h>
 #include <knp/core/messaging/spike_message.h>
 #include <knp/core/messaging/synaptic_impact_message.h>
@@ -37,11 +38,49 @@ namespace knp::core::messaging
 /**
  * @brief List of all message types.
  */
-#define ALL_MESSAGES SpikeMessage, SynapticImpactMessage
+#define ALL_MESSAGES SpikeMessage, SynapticImpactMessage, AggregatedImpactMessage
 
 /**
  * @brief List of `boost::mp11` types. You can use the list to manage your message types.
  */
 using AllMessages = boost::mp11::mp_list<ALL_MESSAGES>;
 
+
+/**
+ * @brief Get memory used by a spike message.
+ * @param message spike message.
+ * @return size of the message and its allocated neuron indexes in bytes.
+ */
+inline size_t message_bytes(const SpikeMessage &message)
+{
+    return sizeof(message) + message.neuron_indexes_.capacity() * sizeof(SpikeIndex);
+}
+
+
+/**
+ * @brief Get memory used by a synaptic impact message.
+ * @param message synaptic impact message.
+ * @return size of the message and its allocated impacts in bytes.
+ */
+inline size_t message_bytes(const SynapticImpactMessage &message)
+{
+    return sizeof(message) + message.impacts_.capacity() * sizeof(SynapticImpact);
+}
+
+
+/**
+ * @brief Get memory used by an aggregated impact message.
+ * @param message aggregated impact message.
+ * @return size of the message and its allocated impact groups in bytes.
+ */
+inline size_t message_bytes(const AggregatedImpactMessage &message)
+{
+    size_t result = sizeof(message) + message.impacts_.capacity() * sizeof(AggregatedImpacts);
+    for (const auto &impacts : message.impacts_)
+    {
+        result += impacts.neuron_indexes_.capacity() * sizeof(uint32_t) + impacts.values_.capacity() * sizeof(float);
+    }
+    return result;
+}
+
 }  // namespace knp::core::messaging
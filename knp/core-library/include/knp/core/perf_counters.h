@@ -0,0 +1,89 @@
+/**
+ * @file perf_counters.h
+ * @brief Hardware performance counters of the current thread.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+
+/**
+ * @brief Core library namespace.
+ */
+namespace knp::core
+{
+/**
+ * @brief The PerfCounterValues structure contains values of hardware performance counters.
+ * @details Values of counters that are not supported by the CPU or the OS are always `0`.
+ */
+struct PerfCounterValues
+{
+    /**
+     * @brief Number of CPU cycles.
+     */
+    uint64_t cycles_ = 0;
+
+    /**
+     * @brief Number of retired instructions.
+     */
+    uint64_t instructions_ = 0;
+
+    /**
+     * @brief Number of last level cache misses.
+     */
+    uint64_t cache_misses_ = 0;
+
+    /**
+     * @brief Number of mispredicted branches.
+     */
+    uint64_t branch_misses_ = 0;
+
+    /**
+     * @brief Get counter differences.
+     * @param other values to subtract.
+     * @return differences of counter values.
+     */
+    [[nodiscard]] PerfCounterValues operator-(const PerfCounterValues &other) const
+    {
+        return {
+            cycles_ - other.cycles_, instructions_ - other.instructions_, cache_misses_ - other.cache_misses_,
+            branch_misses_ - other.branch_misses_};
+    }
+};
+
+
+/**
+ * @brief Determine if hardware performance counters can be read by the current thread.
+ * @details Counters are read with `perf_event_open` on Linux. They can be unavailable on other systems,
+ * in virtual machines without PMU access or if `kernel.perf_event_paranoid` forbids user space profiling.
+ * @return `true` if at least one counter can be read.
+ */
+[[nodiscard]] bool perf_counters_supported();
+
+
+/**
+ * @brief Read hardware performance counters of the current thread.
+ * @details Counters are opened on the first call in a thread and count user space events of the thread only.
+ * @param values counter values since the counters were opened.
+ * @return `true` if counters were read, `false` if they are unavailable.
+ */
+bool read_perf_counters(PerfCounterValues &values);
+
+}  // namespace knp::core
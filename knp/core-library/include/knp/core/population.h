@@ -22,6 +22,7 @@
 #pragma once
 
 #include <knp/core/core.h>
+#include <knp/core/memory_usage.h>
 #include <knp/core/messaging/synaptic_impact_message.h>
 #include <knp/core/uid.h>
 #include <knp/neuron-traits/all_traits.h>
@@ -232,6 +233,18 @@ public:  // NOLINT
      */
     [[nodiscard]] size_t size() const { return neurons_.size(); }
 
+    /**
+     * @brief Get memory used by the population.
+     * @return memory usage of neuron parameters and their capacity slack.
+     */
+    [[nodiscard]] MemoryUsage memory_usage() const
+    {
+        MemoryUsage result;
+        result.parameters_ = used_bytes(neurons_);
+        result.slack_ = slack_bytes(neurons_);
+        return result;
+    }
+
 private:
     BaseData base_;
     std::vector<NeuronParameters> neurons_;
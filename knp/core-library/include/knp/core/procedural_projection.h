@@ -0,0 +1,247 @@
+/**
+ * @file procedural_projection.h
+ * @brief Projection that generates synapses on demand.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <knp/core/counter_rng.h>
+#include <knp/core/memory_usage.h>
+#include <knp/core/projection.h>
+
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+/**
+ * @brief Core library namespace.
+ */
+namespace knp::core
+{
+/**
+ * @brief The ProceduralProjection class is a definition of a projection that stores a connection rule instead of
+ * synapses.
+ * @details Synapses of a presynaptic neuron are generated by the rule each time they are needed, for example when
+ * the neuron spikes. The rule gets a `Philox4x32` generator with the projection seed as a key and the neuron index as
+ * a stream number, so synapses of a neuron are the same on every generation, and the projection takes no memory
+ * for synapses. Synapses can't be changed, so procedural projections are used for inference.
+ * @tparam SynapseType type of synapses. Only delta synapses are supported.
+ */
+template <class SynapseType>
+class ProceduralProjection
+{
+    static_assert(
+        std::is_same_v<SynapseType, synapse_traits::DeltaSynapse>,
+        "Procedural projections support only delta synapses.");
+
+public:
+    /**
+     * @brief Type of the projection synapses.
+     */
+    using ProjectionSynapseType = SynapseType;
+
+    /**
+     * @brief Type of a projection that stores the same synapses.
+     */
+    using ProjectionType = Projection<SynapseType>;
+
+    /**
+     * @brief Parameters of the specified synapse type.
+     */
+    using SynapseParameters = typename ProjectionType::SynapseParameters;
+
+    /**
+     * @brief Synapse description structure that contains synapse parameters and indexes of the associated neurons.
+     */
+    using Synapse = typename ProjectionType::Synapse;
+
+    /**
+     * @brief Type of shared synapse parameters.
+     */
+    using SharedSynapseParameters = typename ProjectionType::SharedSynapseParameters;
+
+    /**
+     * @brief Connection rule type.
+     * @details The rule gets a presynaptic neuron index and a random generator, and appends synapses of the neuron
+     * to a vector. The rule must generate synapses only from random numbers of the generator, neuron indexes and
+     * constant data, and must be thread-safe.
+     */
+    using FanOutRule = std::function<void(size_t, Philox4x32 &, std::vector<Synapse> &)>;
+
+public:
+    /**
+     * @brief Construct a procedural projection.
+     * @param presynaptic_uid UID of the presynaptic population.
+     * @param postsynaptic_uid UID of the postsynaptic population.
+     * @param presynaptic_size number of presynaptic neurons.
+     * @param rule connection rule.
+     * @param seed seed of random numbers used by the rule.
+     */
+    ProceduralProjection(
+        UID presynaptic_uid, UID postsynaptic_uid, size_t presynaptic_size, FanOutRule rule, uint64_t seed)
+        : ProceduralProjection(UID{}, presynaptic_uid, postsynaptic_uid, presynaptic_size, std::move(rule), seed)
+    {
+    }
+
+    /**
+     * @brief Construct a procedural projection.
+     * @param uid projection UID.
+     * @param presynaptic_uid UID of the presynaptic population.
+     * @param postsynaptic_uid UID of the postsynaptic population.
+     * @param presynaptic_size number of presynaptic neurons.
+     * @param rule connection rule.
+     * @param seed seed of random numbers used by the rule.
+     * @throw std::invalid_argument if the rule is empty.
+     */
+    ProceduralProjection(
+        UID uid, UID presynaptic_uid, UID postsynaptic_uid, size_t presynaptic_size, FanOutRule rule, uint64_t seed)
+        : base_{uid},
+          presynaptic_uid_(presynaptic_uid),
+          postsynaptic_uid_(postsynaptic_uid),
+          presynaptic_size_(presynaptic_size),
+          rule_(std::move(rule)),
+          seed_(seed)
+    {
+        if (!rule_) throw std::invalid_argument("Procedural projection requires a connection rule.");
+    }
+
+public:
+    /**
+     * @brief Get projection UID.
+     * @return projection UID.
+     */
+    [[nodiscard]] const UID &get_uid() const { return base_.uid_; }
+
+    /**
+     * @brief Get tags used by the projection.
+     * @return projection tag map.
+     * @see TagMap.
+     */
+    [[nodiscard]] auto &get_tags() { return base_.tags_; }
+
+    /**
+     * @brief Get tags used by the projection.
+     * @note Constant method.
+     * @return projection tag map.
+     * @see TagMap.
+     */
+    [[nodiscard]] const auto &get_tags() const { return base_.tags_; }
+
+    /**
+     * @brief Get UID of the associated population from which this projection receives spikes.
+     * @return UID of the presynaptic population.
+     */
+    [[nodiscard]] const UID &get_presynaptic() const { return presynaptic_uid_; }
+
+    /**
+     * @brief Get UID of the associated population to which this projection sends signals.
+     * @return UID of the postsynaptic population.
+     */
+    [[nodiscard]] const UID &get_postsynaptic() const { return postsynaptic_uid_; }
+
+    /**
+     * @brief Get number of presynaptic neurons.
+     * @return number of neurons.
+     */
+    [[nodiscard]] size_t get_presynaptic_size() const { return presynaptic_size_; }
+
+    /**
+     * @brief Get seed of random numbers used by the connection rule.
+     * @return seed.
+     */
+    [[nodiscard]] uint64_t get_seed() const { return seed_; }
+
+    /**
+     * @brief Get parameters shared between all synapses.
+     * @details Uniform synapse parameters replace parameters generated by the rule.
+     * @return shared parameters.
+     */
+    SharedSynapseParameters &get_shared_parameters() { return shared_parameters_; }
+
+    /**
+     * @brief Get parameters shared between all synapses.
+     * @note Constant method.
+     * @return shared parameters.
+     */
+    const SharedSynapseParameters &get_shared_parameters() const { return shared_parameters_; }
+
+public:
+    /**
+     * @brief Generate synapses of a presynaptic neuron.
+     * @details The method is thread-safe if the rule is thread-safe.
+     * @param neuron_index presynaptic neuron index.
+     * @param synapses vector to fill. Previous vector contents are removed, but its capacity is reused.
+     */
+    void generate_synapses(size_t neuron_index, std::vector<Synapse> &synapses) const
+    {
+        synapses.clear();
+        if (neuron_index >= presynaptic_size_) return;
+        Philox4x32 generator(seed_, neuron_index);
+        rule_(neuron_index, generator, synapses);
+    }
+
+    /**
+     * @brief Generate all projection synapses and store them in a projection.
+     * @details Use the method to save the network or to train the projection. Synapses are grouped by presynaptic
+     * neuron. Shared parameters and tags are copied to the projection.
+     * @return projection with the same UIDs.
+     */
+    [[nodiscard]] ProjectionType materialize() const
+    {
+        std::vector<Synapse> synapses;
+        std::vector<Synapse> neuron_synapses;
+        for (size_t neuron_index = 0; neuron_index < presynaptic_size_; ++neuron_index)
+        {
+            generate_synapses(neuron_index, neuron_synapses);
+            synapses.insert(synapses.end(), neuron_synapses.begin(), neuron_synapses.end());
+        }
+
+        ProjectionType result(base_.uid_, presynaptic_uid_, postsynaptic_uid_);
+        result.add_synapses([&synapses](size_t index) { return std::move(synapses[index]); }, synapses.size());
+        result.get_shared_parameters() = shared_parameters_;
+        result.get_tags() = base_.tags_;
+        return result;
+    }
+
+    /**
+     * @brief Get memory used by the projection.
+     * @details Memory used by data captured by the rule is not included.
+     * @return memory usage.
+     */
+    [[nodiscard]] MemoryUsage memory_usage() const
+    {
+        MemoryUsage usage;
+        usage.parameters_ = sizeof(*this);
+        return usage;
+    }
+
+private:
+    BaseData base_;
+    UID presynaptic_uid_;
+    UID postsynaptic_uid_;
+    size_t presynaptic_size_;
+    FanOutRule rule_;
+    uint64_t seed_;
+    SharedSynapseParameters shared_parameters_;
+};
+
+}  // namespace knp::core
@@ -22,10 +22,12 @@
 #pragma once
 
 #include <knp/core/core.h>
+#include <knp/core/memory_usage.h>
 #include <knp/core/uid.h>
 #include <knp/synapse-traits/all_traits.h>
 
 #include <algorithm>
+#include <array>
 #include <functional>
 #include <optional>
 #include <tuple>
@@ -96,6 +98,12 @@ public:
      */
     using SynapseGenerator = std::function<std::optional<Synapse>(size_t)>;
 
+    /**
+     * @brief Function that fills the projection with synapses on demand.
+     * @details The function receives the projection to fill.
+     */
+    using SynapseLoader = std::function<void(ProjectionType &)>;
+
 public:
     /**
      * @brief Shared synapse parameters for the non-STDP variant of the projection.
@@ -153,6 +161,24 @@ public:
      */
     using SharedSynapseParameters = SharedSynapseParametersT<SynapseType>;
 
+    /**
+     * @brief The EdgeIndex structure contains indexes of projection synapses grouped by neuron.
+     * @details The structure has the layout of a SONATA edge index group: synapses of neuron `n` are the synapses
+     * of ranges `range_to_edge_id_[r]`, where `r` is in `node_id_to_ranges_[n]`. All ranges are half-open.
+     */
+    struct EdgeIndex
+    {
+        /**
+         * @brief First and last range index for each neuron.
+         */
+        std::vector<std::array<size_t, 2>> node_id_to_ranges_;
+
+        /**
+         * @brief First and last synapse index for each range.
+         */
+        std::vector<std::array<size_t, 2>> range_to_edge_id_;
+    };
+
 public:
     /**
      * @brief Construct an empty projection.
@@ -187,6 +213,41 @@ public:
      */
     Projection(UID uid, UID presynaptic_uid, UID postsynaptic_uid, SynapseGenerator generator, size_t num_iterations);
 
+    /**
+     * @brief Construct a projection from synapses generated in advance.
+     * @details Synapses are moved into the projection without copying.
+     * @param presynaptic_uid presynaptic population UID.
+     * @param postsynaptic_uid postsynaptic population UID.
+     * @param synapses projection synapses.
+     */
+    Projection(UID presynaptic_uid, UID postsynaptic_uid, std::vector<Synapse> &&synapses);
+
+    /**
+     * @brief Construct a projection from synapses generated in advance.
+     * @details Synapses are moved into the projection without copying.
+     * @param uid projection UID.
+     * @param presynaptic_uid presynaptic population UID.
+     * @param postsynaptic_uid postsynaptic population UID.
+     * @param synapses projection synapses.
+     */
+    Projection(UID uid, UID presynaptic_uid, UID postsynaptic_uid, std::vector<Synapse> &&synapses);
+
+    /**
+     * @brief Construct a projection from synapses and their indexes grouped by presynaptic and postsynaptic neuron.
+     * @details Synapse search uses the given indexes, so the projection doesn't insert each synapse to the hashed
+     * index. The hashed index is built if synapses are changed. If the indexes don't match synapses, the hashed index
+     * is built at once.
+     * @param uid projection UID.
+     * @param presynaptic_uid presynaptic population UID.
+     * @param postsynaptic_uid postsynaptic population UID.
+     * @param synapses projection synapses.
+     * @param presynaptic_index synapse indexes grouped by presynaptic neuron.
+     * @param postsynaptic_index synapse indexes grouped by postsynaptic neuron.
+     */
+    Projection(
+        UID uid, UID presynaptic_uid, UID postsynaptic_uid, std::vector<Synapse> &&synapses,
+        EdgeIndex &&presynaptic_index, EdgeIndex &&postsynaptic_index);
+
 public:
     /**
      * @brief Get projection UID.
@@ -255,6 +316,13 @@ public:
      */
     [[nodiscard]] size_t size() const { return parameters_.size(); }
 
+    /**
+     * @brief Get memory used by the projection.
+     * @details Index memory is estimated and includes index buckets even if the index is not built.
+     * @return memory usage of synapse parameters, the synapse index and capacity slack.
+     */
+    [[nodiscard]] MemoryUsage memory_usage() const;
+
     /**
      * @brief Get UID of the associated population from which this projection receives spikes.
      * @return UID of the presynaptic population.
@@ -292,12 +360,73 @@ public:
 
     /**
      * @brief Append connections to the existing projection.
+     * @details If the synapse index is built, new synapses are added to it without rebuilding.
      * @param generator synapse generation function.
      * @param num_iterations number of iterations to run the synapse generator.
      * @return number of synapses added to the projection, which can be less or equal to the `num_iterations` value.
      */
     size_t add_synapses(SynapseGenerator generator, size_t num_iterations);
 
+    /**
+     * @brief Remove and add synapses in a single batch.
+     * @details Synapses are removed in a single pass that keeps the order of remaining synapses, then new synapses
+     * are appended. If the synapse index is built, it is patched instead of being rebuilt, so the cost depends on the
+     * number of edited synapses and synapses that follow the first removed one.
+     * @param to_remove indexes of synapses to remove, in any order. Duplicate indexes are ignored.
+     * @param to_add synapses to append.
+     * @throw std::out_of_range if a synapse index is out of range.
+     */
+    void update_synapses(std::vector<size_t> to_remove, std::vector<Synapse> &&to_add);
+
+    /**
+     * @brief The Transaction class is a definition of a batch of synapse removals and additions.
+     * @details Changes are applied to the projection by `commit()` using `update_synapses()`. Changes that were not
+     * committed are discarded.
+     */
+    class Transaction
+    {
+    public:
+        /**
+         * @brief Construct a transaction.
+         * @param projection projection to change.
+         */
+        explicit Transaction(ProjectionType &projection) : projection_(projection) {}
+
+        /**
+         * @brief Add a synapse.
+         * @param synapse synapse to add.
+         */
+        void add_synapse(Synapse synapse) { to_add_.push_back(std::move(synapse)); }
+
+        /**
+         * @brief Remove a synapse.
+         * @param index synapse index before the transaction.
+         */
+        void remove_synapse(size_t index) { to_remove_.push_back(index); }
+
+        /**
+         * @brief Apply changes to the projection.
+         * @details The transaction is empty after the call.
+         */
+        void commit()
+        {
+            projection_.update_synapses(std::move(to_remove_), std::move(to_add_));
+            to_remove_.clear();
+            to_add_.clear();
+        }
+
+    private:
+        ProjectionType &projection_;
+        std::vector<size_t> to_remove_;
+        std::vector<Synapse> to_add_;
+    };
+
+    /**
+     * @brief Start a batch of synapse removals and additions.
+     * @return transaction.
+     */
+    [[nodiscard]] Transaction begin_transaction() { return Transaction(*this); }
+
     /**
      * @brief Remove all synapses from the projection.
      */
@@ -330,6 +459,27 @@ public:
      */
     size_t remove_presynaptic_neuron_synapses(size_t neuron_index);
 
+public:
+    /**
+     * @brief Defer synapse loading until `load_synapses()` is called.
+     * @details Until synapses are loaded, the projection contains no synapses, its copies are cheap and share
+     * the loader. Backends load synapses of their own projection copies, so the synapses exist in memory only once.
+     * @param loader function that fills the projection with synapses.
+     */
+    void set_synapse_loader(SynapseLoader loader) { synapse_loader_ = std::move(loader); }
+
+    /**
+     * @brief Determine if the projection synapses are loaded.
+     * @return `false` if synapse loading is deferred, `true` otherwise.
+     */
+    [[nodiscard]] bool is_loaded() const { return !synapse_loader_; }
+
+    /**
+     * @brief Load deferred synapses.
+     * @details The method does nothing if the synapses are already loaded.
+     */
+    void load_synapses();
+
 public:
     /**
      * @brief Lock the possibility to change synapses weights.
@@ -362,6 +512,15 @@ public:
 
 private:
     void reindex() const;
+    // Append connections of synapses starting from the given one to the index.
+    void index_synapses(size_t first_synapse) const;
+    // Remove synapses with sorted unique indexes keeping the synapse order and the index.
+    void remove_sorted_synapses(const std::vector<size_t> &to_remove);
+    // Check that the edge index contains each synapse once and only for its neuron.
+    template <size_t neuron_id_index>
+    [[nodiscard]] bool is_edge_index_valid(const EdgeIndex &edge_index) const;
+    // Stop using edge indexes because synapses are changed.
+    void drop_edge_indexes();
 
     BaseData base_;
 
@@ -413,29 +572,13 @@ private:
     mutable Index index_;
     mutable bool is_index_updated_ = false;
 
-    SharedSynapseParameters shared_parameters_;
-};
+    // Indexes restored from saved synapse ranges, they replace `index_` until synapses are changed.
+    std::optional<std::array<EdgeIndex, 2>> edge_indexes_;
 
+    SynapseLoader synapse_loader_;
 
-/**
- * @brief List of projection types based on synapse types specified in `knp::synapse_traits::AllSynapses`.
- * @details `AllProjections` takes the value of `Projection<SynapseType_1>, Projection<SynapseType_2>, ...,
- * Projection<SynapseType_n>`, where `SynapseType_[1..n]` is the synapse type specified in
- * `knp::synapse_traits::AllSynapses`. \n For example, if `knp::synapse_traits::AllSynapses` contains DeltaSynapse and
- * AdditiveSTDPSynapse types, then `AllProjections` = `Population<DeltaSynapse>, Population<AdditiveSTDPSynapse>`.
- */
-using AllProjections = boost::mp11::mp_transform<knp::core::Projection, knp::synapse_traits::AllSynapses>;
-
-/**
- * @brief Projection variant that contains any projection type specified in `AllProjections`.
- * @details `AllProjectionVariants` takes the value of `std::variant<ProjectionType_1,..., ProjectionType_n>`, where
- * `ProjectionType_[1..n]` is the projection type specified in `AllProjections`. \n For example, if `AllProjections`
- * contains DeltaSynapse and AdditiveSTDPSynapse types, then `AllProjectionVariants = std::variant<DeltaSynapse,
- * AdditiveSTDPSynapse>`. \n `AllProjectionVariants` retains the same order of message types as defined in
- * `AllProjections`.
- * @see ALL_SYNAPSES.
- */
-using AllProjectionsVariant = boost::mp11::mp_rename<AllProjections, std::variant>;
+    SharedSynapseParameters shared_parameters_;
+};
 
 
 }  // namespace knp::core
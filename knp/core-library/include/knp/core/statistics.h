@@ -0,0 +1,185 @@
+/**
+ * @file statistics.h
+ * @brief Spike statistics collected by backends.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <knp/core/core.h>
+#include <knp/core/messaging/spike_message.h>
+#include <knp/core/uid.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+
+/**
+ * @brief Core library namespace.
+ */
+namespace knp::core
+{
+/**
+ * @brief Settings of statistics collected for a population.
+ */
+struct StatisticsSettings
+{
+    /**
+     * @brief Number of bins in the histogram of interspike intervals, `0` to disable the histogram.
+     * @details The last bin also counts all intervals that are longer than the histogram range.
+     */
+    size_t isi_bins_count_ = 0;
+
+    /**
+     * @brief Width of a histogram bin in steps.
+     */
+    Step isi_bin_width_ = 1;
+};
+
+
+/**
+ * @brief The PopulationStatistics class is a definition of spike statistics of a population accumulated
+ * over a range of steps.
+ */
+struct PopulationStatistics
+{
+    /**
+     * @brief Population UID.
+     */
+    UID population_uid_{false};
+
+    /**
+     * @brief Step from which statistics are accumulated.
+     */
+    Step first_step_ = 0;
+
+    /**
+     * @brief Number of steps over which statistics are accumulated.
+     */
+    Step steps_count_ = 0;
+
+    /**
+     * @brief Total number of spikes.
+     */
+    uint64_t spikes_count_ = 0;
+
+    /**
+     * @brief Number of spikes of each neuron.
+     */
+    std::vector<uint64_t> neuron_spikes_counts_;
+
+    /**
+     * @brief Width of an interspike interval histogram bin in steps.
+     */
+    Step isi_bin_width_ = 1;
+
+    /**
+     * @brief Histogram of interspike intervals.
+     * @details Bin `i` counts intervals in the range `[i * isi_bin_width_ + 1, (i + 1) * isi_bin_width_]`.
+     */
+    std::vector<uint64_t> isi_histogram_;
+
+    /**
+     * @brief Get mean number of spikes per neuron per step.
+     * @return population firing rate.
+     */
+    [[nodiscard]] double get_firing_rate() const;
+
+    /**
+     * @brief Get number of spikes per step for each neuron.
+     * @return neuron firing rates.
+     */
+    [[nodiscard]] std::vector<double> get_neuron_firing_rates() const;
+};
+
+
+/**
+ * @brief The StatisticsCollector class is a definition of a collector that accumulates spike statistics
+ * of populations inside a backend.
+ * @details The collector preallocates all counters when a population is added, so accounting of a spike
+ * message costs a few increments per spike.
+ * @note The collector is not thread-safe.
+ */
+class StatisticsCollector
+{
+public:
+    /**
+     * @brief Start collecting statistics for a population.
+     * @details If statistics of the population are already collected, they are reset.
+     * @param population_uid population UID.
+     * @param neurons_count number of neurons in the population.
+     * @param settings statistics settings.
+     * @param step step from which statistics are accumulated.
+     */
+    void add_population(
+        const UID &population_uid, size_t neurons_count, const StatisticsSettings &settings, Step step);
+
+    /**
+     * @brief Stop collecting statistics for a population.
+     * @param population_uid population UID.
+     */
+    void remove_population(const UID &population_uid);
+
+    /**
+     * @brief Determine if the collector has no populations.
+     * @return `true` if statistics are not collected.
+     */
+    [[nodiscard]] bool empty() const { return populations_.empty(); }
+
+    /**
+     * @brief Account spikes from a message.
+     * @details Messages from populations without statistics are ignored.
+     * @param message spike message sent by a population.
+     */
+    void add_spikes(const messaging::SpikeMessage &message);
+
+    /**
+     * @brief Get statistics of a population.
+     * @param population_uid population UID.
+     * @param step current step.
+     * @throw std::out_of_range if statistics are not collected for the population.
+     * @return copy of population statistics.
+     */
+    [[nodiscard]] PopulationStatistics get_statistics(const UID &population_uid, Step step) const;
+
+    /**
+     * @brief Get statistics of all populations.
+     * @param step current step.
+     * @return copies of population statistics.
+     */
+    [[nodiscard]] std::vector<PopulationStatistics> get_statistics(Step step) const;
+
+    /**
+     * @brief Reset accumulated statistics of all populations.
+     * @param step step from which statistics are accumulated again.
+     */
+    void reset(Step step);
+
+private:
+    struct PopulationData
+    {
+        PopulationStatistics statistics_;
+        // Step of the last spike of each neuron, used to calculate interspike intervals.
+        std::vector<Step> last_spike_steps_;
+    };
+
+    std::unordered_map<UID, PopulationData, uid_hash> populations_;
+};
+
+}  // namespace knp::core
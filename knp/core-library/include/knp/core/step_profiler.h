@@ -0,0 +1,416 @@
+/**
+ * @file step_profiler.h
+ * @brief Profiler of backend execution steps.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <knp/core/core.h>
+#include <knp/core/perf_counters.h>
+#include <knp/core/uid.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+
+/**
+ * @brief Core library namespace.
+ */
+namespace knp::core
+{
+/**
+ * @brief Phases of a backend execution step.
+ */
+enum class StepPhase : size_t
+{
+    /**
+     * @brief Calculation of populations.
+     */
+    populations = 0,
+    /**
+     * @brief Calculation of projections.
+     */
+    projections = 1,
+    /**
+     * @brief Message routing by the message bus.
+     */
+    routing = 2,
+    /**
+     * @brief Message receiving by the backend endpoint.
+     */
+    receiving = 3
+};
+
+
+/**
+ * @brief Number of step phases.
+ */
+constexpr size_t step_phases_count = 4;
+
+
+/**
+ * @brief The TimeProfile structure contains wall time accumulated by a step phase or a network entity.
+ */
+struct TimeProfile
+{
+    /**
+     * @brief Number of measured calls.
+     */
+    uint64_t calls_count_ = 0;
+
+    /**
+     * @brief Total time of measured calls in nanoseconds.
+     */
+    uint64_t time_ns_ = 0;
+
+    /**
+     * @brief Hardware performance counters of measured calls.
+     * @details Counters are `0` if hardware counters are disabled or unavailable.
+     */
+    PerfCounterValues counters_;
+};
+
+
+/**
+ * @brief The EntityProfile structure contains wall time accumulated by a population or a projection.
+ */
+struct EntityProfile : TimeProfile
+{
+    /**
+     * @brief Population or projection UID.
+     */
+    UID uid_{false};
+};
+
+
+/**
+ * @brief The StepProfile structure contains profiling data accumulated over a range of steps.
+ */
+struct StepProfile
+{
+    /**
+     * @brief Number of profiled steps.
+     */
+    uint64_t steps_count_ = 0;
+
+    /**
+     * @brief Total time of profiled steps in nanoseconds.
+     */
+    uint64_t steps_time_ns_ = 0;
+
+    /**
+     * @brief Time of step phases, indexed by `StepPhase`.
+     */
+    std::array<TimeProfile, step_phases_count> phases_{};
+
+    /**
+     * @brief Time of populations and projections.
+     * @details For multi-threaded backends, entity time is a sum of time of all tasks calculating the entity.
+     */
+    std::vector<EntityProfile> entities_;
+
+    /**
+     * @brief Number of messages routed by the message bus.
+     */
+    uint64_t messages_routed_ = 0;
+
+    /**
+     * @brief Number of messages received by the backend endpoint.
+     */
+    uint64_t messages_received_ = 0;
+
+    /**
+     * @brief Number of spikes emitted by populations.
+     */
+    uint64_t spikes_emitted_ = 0;
+
+    /**
+     * @brief Number of synaptic impacts sent by projections.
+     */
+    uint64_t impacts_sent_ = 0;
+
+    /**
+     * @brief Number of projection calculations that found synapses of each spiked neuron by the fan-out index.
+     */
+    uint64_t fan_out_projections_ = 0;
+
+    /**
+     * @brief Number of projection calculations that swept all synapses with a mask of spiked neurons.
+     */
+    uint64_t dense_projections_ = 0;
+
+    /**
+     * @brief `true` if hardware performance counters were collected.
+     */
+    bool hardware_counters_ = false;
+
+    /**
+     * @brief Get time of a step phase.
+     * @param phase step phase.
+     * @return phase time profile.
+     */
+    [[nodiscard]] const TimeProfile &get_phase(StepPhase phase) const { return phases_[static_cast<size_t>(phase)]; }
+};
+
+
+/**
+ * @brief The StepProfiler class is a definition of a profiler that accumulates time and counters of backend steps.
+ * @details All counters are preallocated when profiling is enabled, and accounting is lock-free, so worker threads
+ * can account their tasks concurrently. Entities that are not registered when profiling is enabled are not measured.
+ * Optionally, hardware performance counters of the thread that runs a measured call are accounted together with time.
+ * @note Enable, disable and reset the profiler between steps.
+ */
+class StepProfiler
+{
+public:
+    /**
+     * @brief The Counter class is a definition of a lock-free time counter.
+     */
+    class Counter
+    {
+    public:
+        /**
+         * @brief Account a measured call.
+         * @param time call time.
+         */
+        void add(std::chrono::nanoseconds time)
+        {
+            calls_count_.fetch_add(1, std::memory_order_relaxed);
+            time_ns_.fetch_add(time.count(), std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Account hardware performance counters of a measured call.
+         * @param counters counter differences.
+         */
+        void add_counters(const PerfCounterValues &counters)
+        {
+            cycles_.fetch_add(counters.cycles_, std::memory_order_relaxed);
+            instructions_.fetch_add(counters.instructions_, std::memory_order_relaxed);
+            cache_misses_.fetch_add(counters.cache_misses_, std::memory_order_relaxed);
+            branch_misses_.fetch_add(counters.branch_misses_, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Determine if hardware performance counters are accounted.
+         * @return `true` if timers must read hardware counters.
+         */
+        [[nodiscard]] bool hardware_counters() const { return hardware_counters_; }
+
+        /**
+         * @brief Enable or disable accounting of hardware performance counters.
+         * @param enable `true` to read hardware counters in timers.
+         */
+        void set_hardware_counters(bool enable) { hardware_counters_ = enable; }
+
+        /**
+         * @brief Get accumulated time.
+         * @return time profile.
+         */
+        [[nodiscard]] TimeProfile get() const
+        {
+            return {
+                calls_count_.load(std::memory_order_relaxed), time_ns_.load(std::memory_order_relaxed),
+                {cycles_.load(std::memory_order_relaxed), instructions_.load(std::memory_order_relaxed),
+                 cache_misses_.load(std::memory_order_relaxed), branch_misses_.load(std::memory_order_relaxed)}};
+        }
+
+        /**
+         * @brief Reset accumulated time.
+         */
+        void reset()
+        {
+            calls_count_.store(0, std::memory_order_relaxed);
+            time_ns_.store(0, std::memory_order_relaxed);
+            cycles_.store(0, std::memory_order_relaxed);
+            instructions_.store(0, std::memory_order_relaxed);
+            cache_misses_.store(0, std::memory_order_relaxed);
+            branch_misses_.store(0, std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<uint64_t> calls_count_ = 0;
+        std::atomic<uint64_t> time_ns_ = 0;
+        std::atomic<uint64_t> cycles_ = 0;
+        std::atomic<uint64_t> instructions_ = 0;
+        std::atomic<uint64_t> cache_misses_ = 0;
+        std::atomic<uint64_t> branch_misses_ = 0;
+        bool hardware_counters_ = false;
+    };
+
+    /**
+     * @brief The ScopedTimer class is a definition of a timer that accounts its lifetime in a counter.
+     */
+    class ScopedTimer
+    {
+    public:
+        /**
+         * @brief Start timer.
+         * @param counter counter to account time in, `nullptr` to disable the timer.
+         */
+        explicit ScopedTimer(Counter *counter)
+            : counter_(counter),
+              start_(counter ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{}),
+              read_counters_(counter && counter->hardware_counters() && read_perf_counters(start_counters_))
+        {
+        }
+
+        /**
+         * @brief Stop timer and account its time.
+         */
+        ~ScopedTimer()
+        {
+            if (!counter_) return;
+            PerfCounterValues end_counters;
+            if (read_counters_ && read_perf_counters(end_counters))
+            {
+                counter_->add_counters(end_counters - start_counters_);
+            }
+            counter_->add(std::chrono::steady_clock::now() - start_);
+        }
+
+        ScopedTimer(const ScopedTimer &) = delete;
+        ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+    private:
+        Counter *counter_;
+        std::chrono::steady_clock::time_point start_;
+        PerfCounterValues start_counters_;
+        bool read_counters_;
+    };
+
+public:
+    /**
+     * @brief Enable profiling and register entities to measure.
+     * @details Accumulated data are reset. If hardware performance counters are requested but can't be read,
+     * only time is measured.
+     * @param entity_uids UIDs of populations and projections.
+     * @param hardware_counters `true` to account hardware performance counters.
+     */
+    void enable(const std::vector<UID> &entity_uids, bool hardware_counters = false);
+
+    /**
+     * @brief Disable profiling.
+     * @details Accumulated data are kept until the profiler is reset or enabled again.
+     */
+    void disable() { enabled_.store(false, std::memory_order_relaxed); }
+
+    /**
+     * @brief Determine if profiling is enabled.
+     * @return `true` if profiling is enabled.
+     */
+    [[nodiscard]] bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Get counter of a step phase.
+     * @param phase step phase.
+     * @return pointer to counter or `nullptr` if profiling is disabled.
+     */
+    [[nodiscard]] Counter *get_phase_counter(StepPhase phase)
+    {
+        return enabled() ? &phases_[static_cast<size_t>(phase)] : nullptr;
+    }
+
+    /**
+     * @brief Get counter of a population or a projection.
+     * @param uid entity UID.
+     * @return pointer to counter or `nullptr` if profiling is disabled or the entity is not registered.
+     */
+    [[nodiscard]] Counter *get_entity_counter(const UID &uid);
+
+    /**
+     * @brief Get counter of whole steps.
+     * @return pointer to counter or `nullptr` if profiling is disabled.
+     */
+    [[nodiscard]] Counter *get_step_counter() { return enabled() ? &steps_ : nullptr; }
+
+    /**
+     * @brief Account messages routed by the message bus.
+     * @param count number of messages.
+     */
+    void add_routed_messages(size_t count) { add(messages_routed_, count); }
+
+    /**
+     * @brief Account messages received by the backend endpoint.
+     * @param count number of messages.
+     */
+    void add_received_messages(size_t count) { add(messages_received_, count); }
+
+    /**
+     * @brief Account spikes emitted by populations.
+     * @param count number of spikes.
+     */
+    void add_spikes(size_t count) { add(spikes_emitted_, count); }
+
+    /**
+     * @brief Account synaptic impacts sent by projections.
+     * @param count number of impacts.
+     */
+    void add_impacts(size_t count) { add(impacts_sent_, count); }
+
+    /**
+     * @brief Account projection calculations that used the fan-out kernel.
+     * @param count number of calculations.
+     */
+    void add_fan_out_projections(size_t count) { add(fan_out_projections_, count); }
+
+    /**
+     * @brief Account projection calculations that used the dense kernel.
+     * @param count number of calculations.
+     */
+    void add_dense_projections(size_t count) { add(dense_projections_, count); }
+
+    /**
+     * @brief Get profiling data accumulated since the last reset.
+     * @return copy of profiling data.
+     */
+    [[nodiscard]] StepProfile get_profile() const;
+
+    /**
+     * @brief Reset accumulated profiling data.
+     */
+    void reset();
+
+private:
+    void add(std::atomic<uint64_t> &counter, size_t count)
+    {
+        if (enabled()) counter.fetch_add(count, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<bool> enabled_ = false;
+    bool hardware_counters_ = false;
+    Counter steps_;
+    std::array<Counter, step_phases_count> phases_;
+    // Entity order is kept to return entities in the order of registration.
+    std::vector<UID> entity_uids_;
+    std::unordered_map<UID, Counter, uid_hash> entities_;
+    std::atomic<uint64_t> messages_routed_ = 0;
+    std::atomic<uint64_t> messages_received_ = 0;
+    std::atomic<uint64_t> spikes_emitted_ = 0;
+    std::atomic<uint64_t> impacts_sent_ = 0;
+    std::atomic<uint64_t> fan_out_projections_ = 0;
+    std::atomic<uint64_t> dense_projections_ = 0;
+};
+
+}  // namespace knp::core
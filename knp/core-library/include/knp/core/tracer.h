@@ -0,0 +1,213 @@
+/**
+ * @file tracer.h
+ * @brief Tracer of backend execution events.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+
+/**
+ * @brief Core library namespace.
+ */
+namespace knp::core
+{
+/**
+ * @brief The TraceEvent structure contains a traced time interval.
+ */
+struct TraceEvent
+{
+    /**
+     * @brief Event name.
+     * @note The name must be a string literal or have static storage duration.
+     */
+    const char *name_ = nullptr;
+
+    /**
+     * @brief Event category.
+     * @note The category must be a string literal or have static storage duration.
+     */
+    const char *category_ = nullptr;
+
+    /**
+     * @brief Start of the interval in nanoseconds since the tracer creation.
+     */
+    uint64_t begin_ns_ = 0;
+
+    /**
+     * @brief End of the interval in nanoseconds since the tracer creation.
+     */
+    uint64_t end_ns_ = 0;
+};
+
+
+/**
+ * @brief The Tracer class is a definition of a tracer that records begin and end times of execution events.
+ * @details Each thread writes events to its own ring buffer, so recording an event doesn't take locks except
+ * the first event of a thread. If a ring buffer is full, the oldest events of the thread are overwritten. The buffer
+ * of an exited thread is reused by the next thread that records events, so the number of buffers doesn't grow when
+ * thread pools are recreated.
+ * Recorded events can be saved in the Chrome trace JSON format, which can be opened by `chrome://tracing`
+ * or Perfetto UI.
+ * @note Save and clear the trace when traced threads don't record events.
+ */
+class Tracer
+{
+public:
+    /**
+     * @brief The Scope class is a definition of a traced scope.
+     * @details An event is recorded when the scope is destroyed.
+     */
+    class Scope
+    {
+    public:
+        /**
+         * @brief Start a traced scope.
+         * @param tracer tracer to record the event to, `nullptr` to disable tracing of the scope.
+         * @param name event name.
+         * @param category event category.
+         */
+        Scope(Tracer *tracer, const char *name, const char *category)
+            : tracer_(tracer && tracer->enabled() ? tracer : nullptr),
+              name_(name),
+              category_(category),
+              begin_(tracer_ ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{})
+        {
+        }
+
+        /**
+         * @brief Finish a traced scope and record the event.
+         */
+        ~Scope()
+        {
+            if (tracer_) tracer_->add_event(name_, category_, begin_, std::chrono::steady_clock::now());
+        }
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+    private:
+        Tracer *tracer_;
+        const char *name_;
+        const char *category_;
+        std::chrono::steady_clock::time_point begin_;
+    };
+
+public:
+    /**
+     * @brief Default size of a thread ring buffer.
+     */
+    static constexpr size_t default_events_per_thread = 1 << 16;
+
+    /**
+     * @brief Tracer constructor.
+     * @param events_per_thread number of events kept for each thread.
+     */
+    explicit Tracer(size_t events_per_thread = default_events_per_thread);
+
+    /**
+     * @brief Start recording events.
+     */
+    void enable() { enabled_.store(true, std::memory_order_relaxed); }
+
+    /**
+     * @brief Stop recording events.
+     * @details Recorded events are kept until the tracer is cleared.
+     */
+    void disable() { enabled_.store(false, std::memory_order_relaxed); }
+
+    /**
+     * @brief Determine if the tracer records events.
+     * @return `true` if tracing is enabled.
+     */
+    [[nodiscard]] bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Record an event of the current thread.
+     * @param name event name.
+     * @param category event category.
+     * @param begin event start time.
+     * @param end event end time.
+     */
+    void add_event(
+        const char *name, const char *category, std::chrono::steady_clock::time_point begin,
+        std::chrono::steady_clock::time_point end);
+
+    /**
+     * @brief Get recorded events of all threads.
+     * @return vectors of events for each thread that recorded events, oldest events first.
+     */
+    [[nodiscard]] std::vector<std::vector<TraceEvent>> get_events() const;
+
+    /**
+     * @brief Write recorded events in the Chrome trace JSON format.
+     * @param stream output stream.
+     */
+    void write_chrome_trace(std::ostream &stream) const;
+
+    /**
+     * @brief Save recorded events to a file in the Chrome trace JSON format.
+     * @param path path to file.
+     * @throw std::runtime_error if the file cannot be opened.
+     */
+    void save_chrome_trace(const std::filesystem::path &path) const;
+
+    /**
+     * @brief Remove all recorded events.
+     */
+    void clear();
+
+private:
+    struct ThreadBuffer
+    {
+        explicit ThreadBuffer(size_t capacity) : events_(capacity) {}
+        std::vector<TraceEvent> events_;
+        // Number of events written to the buffer, including overwritten events.
+        std::atomic<uint64_t> written_ = 0;
+        // The thread that used the buffer has exited.
+        std::atomic<bool> released_ = false;
+    };
+
+    ThreadBuffer &get_thread_buffer();
+
+    uint64_t to_ns(std::chrono::steady_clock::time_point time) const
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(time - origin_).count();
+    }
+
+private:
+    const uint64_t id_;
+    const size_t events_per_thread_;
+    const std::chrono::steady_clock::time_point origin_;
+    std::atomic<bool> enabled_ = false;
+    mutable std::mutex mutex_;
+    // Threads keep weak pointers to buffers to release them on exit.
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+};
+
+}  // namespace knp::core
@@ -31,11 +31,46 @@ py::class_<knp::framework::ModelExecutor, boost::noncopyable>(
     .def("__init__", py::make_constructor(&create_model_executor), "Construct model executor.")
     .def("start", &start_model_executor, "Start model execution.")
     .def("start", &start_model_executor_predicate, "Start model execution with a predicate.")
+    .def(
+        "run_for", &knp::framework::ModelExecutor::run_for,
+        "Run model execution for a number of steps, updating outputs after each batch of steps.")
+    .def("run_for", &run_executor_for, "Run model execution for a number of steps.")
     .def("stop", &knp::framework::ModelExecutor::stop, "Stop model execution.")
     .def("add_spike_observer", &add_executor_spike_observer, "Add spike observer to model executor.")
     .def("add_impact_observer", &add_executor_impact_observer, "Add impact message observer to model executor.")
     .def("start_learning", &knp::framework::ModelExecutor::start_learning, "Unlock synapse weights.")
     .def("stop_learning", &knp::framework::ModelExecutor::stop_learning, "Lock synapse weights.")
+    .def(
+        "enable_statistics", &knp::framework::ModelExecutor::enable_statistics,
+        "Start collecting spike statistics of a population inside the backend.")
+    .def(
+        "enable_statistics", &enable_executor_statistics,
+        "Start collecting spike statistics of a population inside the backend.")
+    .def(
+        "get_statistics", &knp::framework::ModelExecutor::get_statistics,
+        "Get spike statistics of a population accumulated since the last reset.")
+    .def(
+        "reset_statistics", &knp::framework::ModelExecutor::reset_statistics,
+        "Reset accumulated spike statistics of all populations.")
+    .def(
+        "enable_profiling", &knp::framework::ModelExecutor::enable_profiling,
+        executor_enable_profiling_overloads(py::args("hardware_counters"), "Start profiling of backend steps."))
+    .def("disable_profiling", &knp::framework::ModelExecutor::disable_profiling, "Stop profiling of backend steps.")
+    .def(
+        "get_profile", &knp::framework::ModelExecutor::get_profile,
+        "Get profiling data of backend steps accumulated since the last reset.")
+    .def(
+        "reset_profile", &knp::framework::ModelExecutor::reset_profile,
+        "Reset accumulated profiling data of backend steps.")
+    .def(
+        "enable_tracing", &knp::framework::ModelExecutor::enable_tracing,
+        "Start recording a timeline of backend steps.")
+    .def(
+        "disable_tracing", &knp::framework::ModelExecutor::disable_tracing,
+        "Stop recording a timeline of backend steps.")
+    .def(
+        "save_trace", &save_executor_trace,
+        "Save the recorded timeline of backend steps in the Chrome trace JSON format.")
     .def("get_backend", &knp::framework::ModelExecutor::get_backend, "Get reference of backend object.")
     .def(
         "get_output_channel", &get_output_channel, py::return_value_policy<py::reference_existing_object>(),
@@ -24,9 +24,15 @@
 #include <knp/framework/model_executor.h>
 
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
+#include <boost/python.hpp>
+
+
+BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(executor_enable_profiling_overloads, enable_profiling, 0, 1);
+
 
 template <class DataOut, class DataIn>
 struct BinaryFunction
@@ -128,6 +134,24 @@ void add_executor_impact_observer(
 }
 
 
+void enable_executor_statistics(knp::framework::ModelExecutor &self, const knp::core::UID &population_uid)
+{
+    self.enable_statistics(population_uid);
+}
+
+
+size_t run_executor_for(knp::framework::ModelExecutor &self, size_t steps_count)
+{
+    return self.run_for(steps_count);
+}
+
+
+void save_executor_trace(knp::framework::ModelExecutor &self, const std::string &path)
+{
+    self.save_trace(path);
+}
+
+
 auto &get_output_channel(knp::framework::ModelExecutor &self, const knp::core::UID &channel_uid)
 {
     return self.get_loader().get_output_channel(channel_uid);
@@ -39,6 +39,9 @@ py::class_<knp::framework::Network>(
         "Remove a projection with the given UID from the network.")
     .add_property("populations_count", &knp::framework::Network::populations_count, "Count populations in the network.")
     .add_property("projections_count", &knp::framework::Network::projections_count, "Count projections in the network.")
+    .def(
+        "memory_usage", &knp::framework::Network::memory_usage,
+        "Get memory used by populations and projections of the network.")
     .def("get_uid", &get_entity_uid<knp::framework::Network>, "Get network UID.")
     .def("populations_range", py::range(&network_begin_populations, &network_end_populations), "Get populations range.")
     .def(
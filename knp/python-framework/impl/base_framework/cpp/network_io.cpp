@@ -22,8 +22,50 @@
 
 #ifdef KNP_IN_BASE_FW
 
-py::def("save_network", &knp::framework::sonata::save_network, "Save network to disk.");
+py::class_<knp::framework::sonata::SaveOptions>(
+    "SaveOptions", "The SaveOptions structure defines how projection datasets are written to HDF5 files.")
+    .def_readwrite(
+        "chunk_size", &knp::framework::sonata::SaveOptions::chunk_size_, "Number of dataset elements in a chunk.")
+    .def_readwrite(
+        "compression_level", &knp::framework::sonata::SaveOptions::compression_level_,
+        "Deflate compression level, 0 disables compression.")
+    .def_readwrite(
+        "shuffle", &knp::framework::sonata::SaveOptions::shuffle_, "Apply the shuffle filter before compression.")
+    .def_readwrite(
+        "compact_constant_datasets", &knp::framework::sonata::SaveOptions::compact_constant_datasets_,
+        "Write constant datasets without allocating data.")
+    .def_readwrite(
+        "parallel", &knp::framework::sonata::SaveOptions::parallel_, "Extract projection columns in parallel.");
 
-py::def("load_network", &knp::framework::sonata::load_network, "Load network from disk.");
+py::def(
+    "save_network",
+    static_cast<void (*)(const knp::framework::Network &, const std::filesystem::path &)>(
+        &knp::framework::sonata::save_network),
+    "Save network to disk.");
+
+py::def(
+    "save_network",
+    static_cast<void (*)(
+        const knp::framework::Network &, const std::filesystem::path &, const knp::framework::sonata::SaveOptions &)>(
+        &knp::framework::sonata::save_network),
+    "Save network to disk using the specified dataset layout.");
+
+py::class_<knp::framework::sonata::LoadOptions>(
+    "LoadOptions", "The LoadOptions structure defines how a network is loaded from SONATA files.")
+    .def_readwrite(
+        "lazy_projections", &knp::framework::sonata::LoadOptions::lazy_projections_,
+        "Defer loading of projection synapses until a backend loads projections.");
+
+py::def(
+    "load_network",
+    static_cast<knp::framework::Network (*)(const std::filesystem::path &)>(&knp::framework::sonata::load_network),
+    "Load network from disk.");
+
+py::def(
+    "load_network",
+    static_cast<knp::framework::Network (*)(
+        const std::filesystem::path &, const knp::framework::sonata::LoadOptions &)>(
+        &knp::framework::sonata::load_network),
+    "Load network from disk using the specified options.");
 
 #endif  // KNP_IN_BASE_FW
@@ -21,8 +21,8 @@
 
 #pragma once
 
+#include <knp/core/all_projections.h>
 #include <knp/core/population.h>
-#include <knp/core/projection.h>
 #include <knp/framework/network.h>
 
 #include <utility>
@@ -28,9 +28,18 @@ py::class_<knp::framework::io::output::OutputChannel, boost::noncopyable>(
     .def("get_uid", &get_entity_uid<knp::framework::io::output::OutputChannel>, "Get output channel UID.")
     .def(
         "update", &knp::framework::io::output::OutputChannel::update,
+        "Unload spike messages from the endpoint into the message buffer and get all buffered messages.")
+    .def(
+        "unload_messages", &knp::framework::io::output::OutputChannel::unload_messages,
         "Unload spike messages from the endpoint into the message buffer.")
     .def(
         "read_some_from_buffer", &read_from_buffer,
-        "Read a specified interval of messages from sorted internal message buffer.")
+        "Read a specified interval of messages from the message buffer and remove them from the buffer.")
+    .def(
+        "get_max_buffered_steps", &knp::framework::io::output::OutputChannel::get_max_buffered_steps,
+        "Get maximum number of steps kept in the message buffer.")
+    .def(
+        "set_max_buffered_steps", &knp::framework::io::output::OutputChannel::set_max_buffered_steps,
+        "Limit number of steps kept in the message buffer.")
     .def("__init__", &construct_output_channel, "Initialize output channel attributes.");
 #endif  // KNP_IN_BASE_FW
@@ -21,7 +21,12 @@ limitations under the License.
 """
 
 # pylint: disable = no-name-in-module
-from knp.base_framework._knp_python_framework_base_framework import save_network, load_network
+from knp.base_framework._knp_python_framework_base_framework import (
+    LoadOptions,
+    SaveOptions,
+    save_network,
+    load_network,
+)
 
 
-__all__ = ['save_network', 'load_network']
+__all__ = ['LoadOptions', 'SaveOptions', 'save_network', 'load_network']
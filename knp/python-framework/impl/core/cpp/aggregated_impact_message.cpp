@@ -0,0 +1,55 @@
+/**
+ * @file aggregated_impact_message.cpp
+ * @brief Python bindings for AggregatedImpactMessage.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "common.h"
+
+
+#if defined(KNP_IN_CORE)
+
+namespace msg = knp::core::messaging;
+
+py::class_<msg::AggregatedImpacts>(
+    "AggregatedImpacts", "Structure that contains summed impacts of one output type on postsynaptic neurons.")
+    .def_readwrite(
+        "synapse_type", &msg::AggregatedImpacts::synapse_type_,
+        "Synapse type that defines the value role inside the neuron function.")
+    .def_readwrite(
+        "neuron_indexes", &msg::AggregatedImpacts::neuron_indexes_,
+        "Indexes of postsynaptic neurons in ascending order, empty if values are dense.")
+    .def_readwrite("values", &msg::AggregatedImpacts::values_, "Summed impact values.")
+    .def("is_dense", &msg::AggregatedImpacts::is_dense, "Determine if values are dense.");
+
+
+py::class_<msg::AggregatedImpactMessage>("AggregatedImpactMessage", "Structure of the aggregated impact message.")
+    .def_readwrite("header", &msg::AggregatedImpactMessage::header_, "Message header.")
+    .def_readwrite(
+        "presynaptic_population_uid", &msg::AggregatedImpactMessage::presynaptic_population_uid_,
+        "UID of the population that sends spikes to the projection.")
+    .def_readwrite(
+        "postsynaptic_population_uid", &msg::AggregatedImpactMessage::postsynaptic_population_uid_,
+        "UID of the population that receives impacts from the projection.")
+    .def_readwrite(
+        "impacts", &msg::AggregatedImpactMessage::impacts_,
+        "Impact values grouped by output type, at most one group for each type.")
+    .def_readwrite(
+        "is_forcing", &msg::AggregatedImpactMessage::is_forcing_,
+        "Boolean value that defines whether the signal is from a projection without plasticity.");
+
+#endif
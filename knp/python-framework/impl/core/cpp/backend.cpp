@@ -192,6 +192,52 @@ py::class_<BackendWrapper, boost::noncopyable>(
     .def("get_step", &core::Backend::get_step, "Get current step.")
     .def("stop_learning", &core::Backend::stop_learning, "Stop learning.")
     .def("start_learning", &core::Backend::start_learning, "Restart learning.")
+    .def(
+        "enable_statistics",
+        make_handler([](core::Backend &self, const core::UID &population_uid, const core::StatisticsSettings &settings)
+                     { self.enable_statistics(population_uid, settings); }),
+        "Start collecting spike statistics of a population.")
+    .def(
+        "enable_statistics",
+        make_handler([](core::Backend &self, const core::UID &population_uid)
+                     { self.enable_statistics(population_uid); }),
+        "Start collecting spike statistics of a population.")
+    .def("disable_statistics", &core::Backend::disable_statistics, "Stop collecting spike statistics of a population.")
+    .def(
+        "get_statistics",
+        make_handler([](core::Backend &self, const core::UID &population_uid)
+                     { return self.get_statistics(population_uid); }),
+        "Get spike statistics of a population accumulated since the last reset.")
+    .def(
+        "get_all_statistics",
+        make_handler(
+            [](core::Backend &self)
+            {
+                py::list result;
+                for (auto &statistics : self.get_statistics()) result.append(statistics);
+                return result;
+            }),
+        "Get spike statistics of all populations accumulated since the last reset.")
+    .def("reset_statistics", &core::Backend::reset_statistics, "Reset accumulated spike statistics of all populations.")
+    .def(
+        "run_steps", make_handler([](core::Backend &self, size_t steps_count) { return self.run_steps(steps_count); }),
+        "Run a given number of network steps without predicates.")
+    .def(
+        "enable_profiling", &core::Backend::enable_profiling,
+        backend_enable_profiling_overloads(py::args("hardware_counters"), "Start profiling of backend steps."))
+    .def("disable_profiling", &core::Backend::disable_profiling, "Stop profiling of backend steps.")
+    .def("is_profiling_enabled", &core::Backend::is_profiling_enabled, "Determine if profiling is enabled.")
+    .def("get_profile", &core::Backend::get_profile, "Get profiling data accumulated since the last reset.")
+    .def("reset_profile", &core::Backend::reset_profile, "Reset accumulated profiling data.")
+    .def("enable_tracing", &core::Backend::enable_tracing, "Start recording a timeline of backend steps.")
+    .def("disable_tracing", &core::Backend::disable_tracing, "Stop recording a timeline of backend steps.")
+    .def("is_tracing_enabled", &core::Backend::is_tracing_enabled, "Determine if the timeline is recorded.")
+    .def(
+        "save_trace",
+        make_handler([](core::Backend &self, const std::string &path) { self.save_trace(path); }),
+        "Save the recorded timeline in the Chrome trace JSON format.")
+    .def("clear_trace", &core::Backend::clear_trace, "Remove all recorded timeline events.")
+    .def("memory_usage", &core::Backend::memory_usage, "Get memory used by the backend.")
     .def(
         "subscribe",
         make_handler(
@@ -0,0 +1,29 @@
+/**
+ * @file backend.h
+ * @brief Python bindings header for common Backend class.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <knp/core/backend.h>
+
+#include <boost/python.hpp>
+
+
+BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(backend_enable_profiling_overloads, enable_profiling, 0, 1);
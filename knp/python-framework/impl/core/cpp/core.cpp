@@ -24,6 +24,7 @@
 #include <filesystem>
 
 #include "any_converter.h"
+#include "backend.h"
 #include "common.h"
 #include "message_endpoint.h"
 #include "optional_converter.h"
@@ -80,16 +81,20 @@ BOOST_PYTHON_MODULE(KNP_FULL_LIBRARY_NAME)
     //    boost::python::import("libknp_python_framework_neuron_traits");
 
 #define KNP_IN_CORE
-#include "backend.cpp"                  // NOLINT
-#include "device.cpp"                   // NOLINT
-#include "message_bus.cpp"              // NOLINT
-#include "message_endpoint.cpp"         // NOLINT
-#include "message_header.cpp"           // NOLINT
-#include "population.cpp"               // NOLINT
-#include "projection.cpp"               // NOLINT
-#include "spike_message.cpp"            // NOLINT
-#include "subscription.cpp"             // NOLINT
-#include "synaptic_impact_message.cpp"  // NOLINT
-#include "uid.cpp"                      // NOLINT
+#include "aggregated_impact_message.cpp"  // NOLINT
+#include "backend.cpp"                    // NOLINT
+#include "device.cpp"                     // NOLINT
+#include "memory_usage.cpp"               // NOLINT
+#include "message_bus.cpp"                // NOLINT
+#include "message_endpoint.cpp"           // NOLINT
+#include "message_header.cpp"             // NOLINT
+#include "population.cpp"                 // NOLINT
+#include "projection.cpp"                 // NOLINT
+#include "spike_message.cpp"              // NOLINT
+#include "statistics.cpp"                 // NOLINT
+#include "step_profiler.cpp"              // NOLINT
+#include "subscription.cpp"               // NOLINT
+#include "synaptic_impact_message.cpp"    // NOLINT
+#include "uid.cpp"                        // NOLINT
 #undef KNP_IN_CORE
 }
@@ -0,0 +1,39 @@
+/**
+ * @file memory_usage.cpp
+ * @brief Python bindings for memory footprint accounting.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common.h"
+
+
+#if defined(KNP_IN_CORE)
+
+py::class_<core::MemoryUsage>(
+    "MemoryUsage", "The MemoryUsage structure contains memory used by an object, in bytes by category.")
+    .def_readonly("parameters", &core::MemoryUsage::parameters_, "Memory used by neuron or synapse parameters.")
+    .def_readonly("index", &core::MemoryUsage::index_, "Memory used by projection search indexes.")
+    .def_readonly(
+        "messages", &core::MemoryUsage::messages_,
+        "Memory used by messages waiting to be processed, including message data.")
+    .def_readonly(
+        "subscriptions", &core::MemoryUsage::subscriptions_, "Memory used by subscriptions, excluding their messages.")
+    .def_readonly("slack", &core::MemoryUsage::slack_, "Memory allocated by containers, but not used.")
+    .add_property("total", &core::MemoryUsage::total, "Total memory usage.");
+
+#endif
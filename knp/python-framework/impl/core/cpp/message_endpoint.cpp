@@ -68,6 +68,7 @@ py::class_<core::MessageEndpoint, boost::noncopyable, std::shared_ptr<core::Mess
     .add_property(
         "subscription_key", &core::MessageEndpoint::get_subscription_key,
         "Get subscription key from a subscription variant.")
+    .def("memory_usage", &core::MessageEndpoint::memory_usage, "Get memory used by the endpoint subscriptions.")
     .def(
         "subscribe",
         make_handler(
@@ -87,6 +87,9 @@ namespace nt = knp::neuron_traits;
                     "Get an iterator of the population.")                                                              \
                 .def(                                                                                                  \
                     "__len__", &core::Population<nt::neuron_type>::size, "Count number of neurons in the population.") \
+                .def(                                                                                                  \
+                    "memory_usage", &core::Population<nt::neuron_type>::memory_usage,                                  \
+                    "Get memory used by the population.")                                                              \
                 .def(                                                                                                  \
                     "__getitem__",                                                                                     \
                     static_cast<core::Population<nt::neuron_type>::NeuronParameters &(                                 \
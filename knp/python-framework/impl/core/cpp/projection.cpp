@@ -102,6 +102,12 @@ py::class_<core::Synapse>(
                 .add_property(                                                                                         \
                     "uid", make_handler([](core::Projection<st::synapse_type> &proj) { return proj.get_uid(); }),      \
                     "Get projection UID.")                                                                             \
+                .add_property(                                                                                         \
+                    "is_loaded", &core::Projection<st::synapse_type>::is_loaded,                                       \
+                    "Determine if the projection synapses are loaded.")                                                \
+                .def(                                                                                                  \
+                    "load_synapses", &core::Projection<st::synapse_type>::load_synapses,                               \
+                    "Load deferred synapses.")                                                                         \
                 .def(                                                                                                  \
                     "__iter__",                                                                                        \
                     py::range(                                                                                         \
@@ -113,6 +119,9 @@ py::class_<core::Synapse>(
                 .def(                                                                                                  \
                     "__len__", &core::Projection<st::synapse_type>::size,                                              \
                     "Count number of synapses in the projection.")                                                     \
+                .def(                                                                                                  \
+                    "memory_usage", &core::Projection<st::synapse_type>::memory_usage,                                 \
+                    "Get memory used by the projection.")                                                              \
                 .def(                                                                                                  \
                     "__getitem__",                                                                                     \
                     static_cast<core::Projection<st::synapse_type>::Synapse &(                                         \
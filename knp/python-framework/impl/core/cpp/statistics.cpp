@@ -0,0 +1,81 @@
+/**
+ * @file statistics.cpp
+ * @brief Python bindings for spike statistics.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common.h"
+
+
+#if defined(KNP_IN_CORE)
+
+py::class_<core::StatisticsSettings>("StatisticsSettings", "Settings of statistics collected for a population.")
+    .def_readwrite(
+        "isi_bins_count", &core::StatisticsSettings::isi_bins_count_,
+        "Number of bins in the histogram of interspike intervals, 0 to disable the histogram.")
+    .def_readwrite(
+        "isi_bin_width", &core::StatisticsSettings::isi_bin_width_, "Width of a histogram bin in steps.");
+
+
+py::class_<core::PopulationStatistics>(
+    "PopulationStatistics",
+    "The PopulationStatistics class is a definition of spike statistics of a population accumulated over a range of "
+    "steps.")
+    .def_readonly("population_uid", &core::PopulationStatistics::population_uid_, "Population UID.")
+    .def_readonly("first_step", &core::PopulationStatistics::first_step_, "Step from which statistics are accumulated.")
+    .def_readonly(
+        "steps_count", &core::PopulationStatistics::steps_count_,
+        "Number of steps over which statistics are accumulated.")
+    .def_readonly("spikes_count", &core::PopulationStatistics::spikes_count_, "Total number of spikes.")
+    .def_readonly(
+        "isi_bin_width", &core::PopulationStatistics::isi_bin_width_,
+        "Width of an interspike interval histogram bin in steps.")
+    .add_property(
+        "neuron_spikes_counts",
+        make_handler(
+            [](const core::PopulationStatistics &self)
+            {
+                py::list result;
+                for (auto count : self.neuron_spikes_counts_) result.append(count);
+                return result;
+            }),
+        "Number of spikes of each neuron.")
+    .add_property(
+        "isi_histogram",
+        make_handler(
+            [](const core::PopulationStatistics &self)
+            {
+                py::list result;
+                for (auto count : self.isi_histogram_) result.append(count);
+                return result;
+            }),
+        "Histogram of interspike intervals.")
+    .add_property(
+        "firing_rate", &core::PopulationStatistics::get_firing_rate, "Mean number of spikes per neuron per step.")
+    .add_property(
+        "neuron_firing_rates",
+        make_handler(
+            [](const core::PopulationStatistics &self)
+            {
+                py::list result;
+                for (auto rate : self.get_neuron_firing_rates()) result.append(rate);
+                return result;
+            }),
+        "Number of spikes per step for each neuron.");
+
+#endif
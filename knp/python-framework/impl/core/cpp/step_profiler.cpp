@@ -0,0 +1,94 @@
+/**
+ * @file step_profiler.cpp
+ * @brief Python bindings for step profiler data.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common.h"
+
+
+#if defined(KNP_IN_CORE)
+
+py::enum_<core::StepPhase>("StepPhase", "Phases of a backend execution step.")
+    .value("populations", core::StepPhase::populations)
+    .value("projections", core::StepPhase::projections)
+    .value("routing", core::StepPhase::routing)
+    .value("receiving", core::StepPhase::receiving);
+
+
+py::class_<core::PerfCounterValues>(
+    "PerfCounterValues", "The PerfCounterValues structure contains values of hardware performance counters.")
+    .def_readonly("cycles", &core::PerfCounterValues::cycles_, "Number of CPU cycles.")
+    .def_readonly("instructions", &core::PerfCounterValues::instructions_, "Number of retired instructions.")
+    .def_readonly("cache_misses", &core::PerfCounterValues::cache_misses_, "Number of last level cache misses.")
+    .def_readonly("branch_misses", &core::PerfCounterValues::branch_misses_, "Number of mispredicted branches.");
+
+
+py::def(
+    "perf_counters_supported", &core::perf_counters_supported,
+    "Determine if hardware performance counters can be read by the current thread.");
+
+
+py::class_<core::TimeProfile>(
+    "TimeProfile", "The TimeProfile structure contains wall time accumulated by a step phase or a network entity.")
+    .def_readonly("calls_count", &core::TimeProfile::calls_count_, "Number of measured calls.")
+    .def_readonly("time_ns", &core::TimeProfile::time_ns_, "Total time of measured calls in nanoseconds.")
+    .def_readonly("counters", &core::TimeProfile::counters_, "Hardware performance counters of measured calls.");
+
+
+py::class_<core::EntityProfile, py::bases<core::TimeProfile>>(
+    "EntityProfile", "The EntityProfile structure contains wall time accumulated by a population or a projection.")
+    .def_readonly("uid", &core::EntityProfile::uid_, "Population or projection UID.");
+
+
+py::class_<core::StepProfile>(
+    "StepProfile", "The StepProfile structure contains profiling data accumulated over a range of steps.")
+    .def_readonly("steps_count", &core::StepProfile::steps_count_, "Number of profiled steps.")
+    .def_readonly("steps_time_ns", &core::StepProfile::steps_time_ns_, "Total time of profiled steps in nanoseconds.")
+    .def_readonly(
+        "messages_routed", &core::StepProfile::messages_routed_, "Number of messages routed by the message bus.")
+    .def_readonly(
+        "messages_received", &core::StepProfile::messages_received_,
+        "Number of messages received by the backend endpoint.")
+    .def_readonly("spikes_emitted", &core::StepProfile::spikes_emitted_, "Number of spikes emitted by populations.")
+    .def_readonly("impacts_sent", &core::StepProfile::impacts_sent_, "Number of synaptic impacts sent by projections.")
+    .def_readonly(
+        "fan_out_projections", &core::StepProfile::fan_out_projections_,
+        "Number of projection calculations that used the fan-out kernel.")
+    .def_readonly(
+        "dense_projections", &core::StepProfile::dense_projections_,
+        "Number of projection calculations that used the dense kernel.")
+    .def_readonly(
+        "hardware_counters", &core::StepProfile::hardware_counters_,
+        "`True` if hardware performance counters were collected.")
+    .def(
+        "get_phase",
+        make_handler([](const core::StepProfile &self, core::StepPhase phase) { return self.get_phase(phase); }),
+        "Get time of a step phase.")
+    .add_property(
+        "entities",
+        make_handler(
+            [](const core::StepProfile &self)
+            {
+                py::list result;
+                for (const auto &entity : self.entities_) result.append(entity);
+                return result;
+            }),
+        "Time of populations and projections.");
+
+#endif
@@ -25,20 +25,28 @@ from knp.core._knp_python_framework_core import (
     UID,
     AdditiveSTDPDeltaSynapseParameters,
     AdditiveSTDPDeltaSynapseProjection,
+    AggregatedImpactMessageSubscription,
     Backend,
     BaseData,
     BLIFATNeuronPopulation,
     DeltaSynapseParameters,
     DeltaSynapseProjection,
+    MemoryUsage,
     MessageBus,
     MessageEndpoint,
+    PerfCounterValues,
+    PopulationStatistics,
     SpikeMessageSubscription,
+    StatisticsSettings,
+    StepPhase,
+    StepProfile,
     SynapticImpactMessageSubscription,
     SynapticResourceSTDPBLIFATNeuronPopulation,
     SynapticResourceSTDPDeltaSynapseParameters,
     SynapticResourceSTDPDeltaSynapseProjection,
     TagMap,
     continuously_uid_generator,
+    perf_counters_supported,
     uid_hash,
     uuid,
     uuid_variant_type,
@@ -53,16 +61,24 @@ __all__ = [
     'Backend',
     'BaseData',
     'DeltaSynapseParameters',
+    'MemoryUsage',
     'MessageBus',
     'MessageEndpoint',
+    'PerfCounterValues',
+    'PopulationStatistics',
     'SpikeMessageSubscription',
+    'StatisticsSettings',
+    'StepPhase',
+    'StepProfile',
     'SynapticImpactMessageSubscription',
+    'AggregatedImpactMessageSubscription',
     'SynapticResourceSTDPBLIFATNeuronPopulation',
     'SynapticResourceSTDPDeltaSynapseParameters',
     'SynapticResourceSTDPDeltaSynapseProjection',
     'TagMap',
     'uid_hash',
     'continuously_uid_generator',
+    'perf_counters_supported',
     'uuid',
     'uuid_variant_type',
 ]
@@ -23,6 +23,9 @@ limitations under the License.
 
 # pylint: disable = no-name-in-module
 from knp.core._knp_python_framework_core import (
+    AggregatedImpactMessage,
+    AggregatedImpactMessages,
+    AggregatedImpacts,
     MessageHeader,
     SpikeData,
     SpikeMessage,
@@ -39,4 +42,7 @@ __all__ = [
     'SynapticImpact',
     'SynapticImpactMessage',
     'SynapticImpactMessages',
+    'AggregatedImpacts',
+    'AggregatedImpactMessage',
+    'AggregatedImpactMessages',
 ]
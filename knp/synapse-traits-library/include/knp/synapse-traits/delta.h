@@ -23,6 +23,7 @@
 
 #include <cinttypes>
 #include <numeric>
+#include <optional>
 
 #include "output_types.h"
 #include "type_traits.h"
@@ -110,4 +111,42 @@ struct synapse_parameters<DeltaSynapse>
     knp::synapse_traits::OutputType output_type_;
 };
 
+
+/**
+ * @brief Structure for parameters shared between delta synapses of a projection.
+ * @details A set field declares the parameter uniform: the projection uses the shared value for every synapse and
+ * ignores per-synapse values. Declare uniform delay and output type to let backends write impacts of all synapses
+ * into a single message.
+ */
+template <>
+struct shared_synapse_parameters<DeltaSynapse>
+{
+    /**
+     * @brief Synaptic weight of all projection synapses.
+     */
+    std::optional<float> weight_;
+
+    /**
+     * @brief Synaptic delay of all projection synapses.
+     */
+    std::optional<uint32_t> delay_;
+
+    /**
+     * @brief Synapse type of all projection synapses.
+     */
+    std::optional<knp::synapse_traits::OutputType> output_type_;
+
+    /**
+     * @brief Get parameters of a synapse with uniform values applied.
+     * @param synapse_params per-synapse parameters.
+     * @return parameters used by the projection.
+     */
+    [[nodiscard]] synapse_parameters<DeltaSynapse> apply(const synapse_parameters<DeltaSynapse> &synapse_params) const
+    {
+        return synapse_parameters<DeltaSynapse>{
+            weight_.value_or(synapse_params.weight_), delay_.value_or(synapse_params.delay_),
+            output_type_.value_or(synapse_params.output_type_)};
+    }
+};
+
 }  // namespace knp::synapse_traits
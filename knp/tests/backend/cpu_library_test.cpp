@@ -0,0 +1,360 @@
+/**
+ * @file cpu_library_test.cpp
+ * @brief CPU library projection kernels test.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/backends/cpu-library/blifat_population.h>
+#include <knp/backends/cpu-library/delta_synapse_projection.h>
+#include <knp/core/projection.h>
+#include <knp/synapse-traits/delta.h>
+
+#include <generators.h>
+#include <tests_common.h>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace kcpu = knp::backends::cpu;
+using DeltaProjection = knp::core::Projection<knp::synapse_traits::DeltaSynapse>;
+using Impacts = std::map<uint64_t, std::vector<knp::core::messaging::SynapticImpact>>;
+
+
+// Projection where each of 4 presynaptic neurons is connected to 3 postsynaptic neurons with delays 1, 2 and 3.
+DeltaProjection make_delay_projection()
+{
+    return DeltaProjection{
+        knp::core::UID{}, knp::core::UID{},
+        [](size_t index)
+        {
+            return DeltaProjection::Synapse{
+                {static_cast<float>(index + 1), static_cast<uint32_t>(index % 3 + 1),
+                 knp::synapse_traits::OutputType::EXCITATORY},
+                index / 3,
+                index % 3};
+        },
+        12};
+}
+
+
+// Impacts of the queue by the step on which they are sent.
+Impacts get_impacts(const kcpu::MessageQueue &future_messages)
+{
+    Impacts result;
+    for (const auto &[step, message] : future_messages) result[step] = message.impacts_;
+    return result;
+}
+
+
+// Number of impacts in all messages.
+size_t count_impacts(const Impacts &impacts)
+{
+    size_t result = 0;
+    for (const auto &[step, step_impacts] : impacts) result += step_impacts.size();
+    return result;
+}
+
+
+// Impacts of all kernels for the same spikes.
+std::vector<Impacts> calculate_all_kernels(DeltaProjection &projection, const std::vector<uint32_t> &spikes)
+{
+    const size_t step = 10;
+    std::vector<knp::core::messaging::SpikeMessage> messages{{{knp::core::UID{}, step}, spikes}};
+    const auto message_in_data = kcpu::convert_spikes(messages.front());
+    std::mutex mutex;
+    std::vector<Impacts> result;
+
+    kcpu::MessageQueue future_messages;
+    std::vector<size_t> activated_synapses;
+    kcpu::calculate_delta_synapse_projection_data(projection, messages, future_messages, step, activated_synapses);
+    result.push_back(get_impacts(future_messages));
+
+    future_messages.clear();
+    std::vector<uint32_t> spike_mask;
+    kcpu::calculate_delta_synapse_projection_dense_data(projection, messages, future_messages, step, spike_mask);
+    result.push_back(get_impacts(future_messages));
+
+    future_messages.clear();
+    std::vector<std::pair<size_t, size_t>> synapse_spikes;
+    kcpu::calculate_projection_fan_out(projection, message_in_data, future_messages, step, synapse_spikes, mutex);
+    result.push_back(get_impacts(future_messages));
+
+    future_messages.clear();
+    kcpu::calculate_projection_part(projection, message_in_data, future_messages, step, 0, projection.size(), mutex);
+    result.push_back(get_impacts(future_messages));
+    return result;
+}
+
+
+TEST(CpuLibrarySuite, UniformParametersKernelTest)
+{
+    auto projection = make_delay_projection();
+    const std::vector<uint32_t> spikes{1, 3};
+
+    // Per-synapse parameters: impacts are sent on three steps.
+    for (const auto &impacts : calculate_all_kernels(projection, spikes))
+    {
+        ASSERT_EQ(impacts.size(), 3);
+        for (const auto &[step, step_impacts] : impacts)
+        {
+            ASSERT_EQ(step_impacts.size(), spikes.size());
+            for (const auto &impact : step_impacts)
+            {
+                ASSERT_EQ(impact.impact_value_, static_cast<float>(impact.connection_index_ + 1));
+                ASSERT_EQ(step, impact.postsynaptic_neuron_index_ + 10);
+            }
+        }
+    }
+
+    // Uniform parameters replace per-synapse ones, all impacts go to a single message.
+    auto &uniform_params = projection.get_shared_parameters().synapses_parameters_;
+    uniform_params.weight_ = 0.5F;
+    uniform_params.delay_ = 2;
+    uniform_params.output_type_ = knp::synapse_traits::OutputType::INHIBITORY_CURRENT;
+    for (const auto &impacts : calculate_all_kernels(projection, spikes))
+    {
+        ASSERT_EQ(impacts.size(), 1);
+        const auto &step_impacts = impacts.at(11);
+        ASSERT_EQ(step_impacts.size(), 3 * spikes.size());
+        for (const auto &impact : step_impacts)
+        {
+            ASSERT_EQ(impact.impact_value_, 0.5F);
+            ASSERT_EQ(impact.synapse_type_, knp::synapse_traits::OutputType::INHIBITORY_CURRENT);
+        }
+    }
+
+    // A single uniform parameter keeps others per-synapse.
+    uniform_params = {};
+    uniform_params.weight_ = 2.0F;
+    for (const auto &impacts : calculate_all_kernels(projection, spikes))
+    {
+        ASSERT_EQ(impacts.size(), 3);
+        for (const auto &[step, step_impacts] : impacts)
+        {
+            for (const auto &impact : step_impacts)
+            {
+                ASSERT_EQ(impact.impact_value_, 2.0F);
+                ASSERT_EQ(impact.synapse_type_, knp::synapse_traits::OutputType::EXCITATORY);
+            }
+        }
+    }
+}
+
+
+TEST(CpuLibrarySuite, DenseKernelEquivalenceTest)
+{
+    const size_t neurons_count = 50;
+    std::mt19937 engine(0);
+    std::uniform_int_distribution<size_t> neuron_distribution(0, neurons_count - 1);
+    std::uniform_int_distribution<uint32_t> delay_distribution(1, 3);
+    std::uniform_int_distribution<int> type_distribution(0, 1);
+    // Synapses are stored in random order, blocking ones make the result depend on the impact order.
+    DeltaProjection projection{
+        knp::core::UID{}, knp::core::UID{},
+        [&](size_t index)
+        {
+            const auto output_type = type_distribution(engine) ? knp::synapse_traits::OutputType::BLOCKING
+                                                               : knp::synapse_traits::OutputType::EXCITATORY;
+            return DeltaProjection::Synapse{
+                {static_cast<float>(index), delay_distribution(engine), output_type},
+                neuron_distribution(engine),
+                neuron_distribution(engine)};
+        },
+        1000};
+
+    const size_t step = 10;
+    std::vector<uint32_t> spike_mask;
+    std::vector<size_t> activated_synapses;
+    std::vector<std::pair<size_t, size_t>> synapse_spikes;
+    for (size_t spikes_count : {1, 5, 40})
+    {
+        // Spikes are unordered and some neurons spike twice.
+        std::vector<uint32_t> spikes;
+        for (size_t i = 0; i < spikes_count; ++i) spikes.push_back(static_cast<uint32_t>(neuron_distribution(engine)));
+        spikes.push_back(spikes.front());
+        std::vector<knp::core::messaging::SpikeMessage> messages{{{knp::core::UID{}, step}, spikes}};
+
+        kcpu::MessageQueue fan_out_messages;
+        const size_t fan_out_count = kcpu::calculate_delta_synapse_projection_data(
+            projection, messages, fan_out_messages, step, activated_synapses);
+        kcpu::MessageQueue dense_messages;
+        const size_t dense_count = kcpu::calculate_delta_synapse_projection_dense_data(
+            projection, messages, dense_messages, step, spike_mask);
+        const auto fan_out_impacts = get_impacts(fan_out_messages);
+        ASSERT_FALSE(fan_out_impacts.empty());
+        ASSERT_EQ(fan_out_impacts, get_impacts(dense_messages));
+        // Kernels return the number of added impacts.
+        ASSERT_EQ(fan_out_count, count_impacts(fan_out_impacts));
+        ASSERT_EQ(dense_count, fan_out_count);
+        // The mask is cleared for the next step.
+        ASSERT_TRUE(std::all_of(spike_mask.begin(), spike_mask.end(), [](uint32_t count) { return count == 0; }));
+
+        // Multi-threaded kernels: parts added in part order make the same impacts as the fan-out kernel.
+        const auto message_in_data = kcpu::convert_spikes(messages.front());
+        std::mutex mutex;
+        kcpu::MessageQueue mt_fan_out_messages;
+        const size_t mt_fan_out_count = kcpu::calculate_projection_fan_out(
+            projection, message_in_data, mt_fan_out_messages, step, synapse_spikes, mutex);
+        kcpu::MessageQueue parts_messages;
+        const size_t part_size = 64;
+        std::vector<kcpu::FutureImpacts> part_impacts((projection.size() + part_size - 1) / part_size);
+        // Parts are calculated in reverse order, as if they were finished by threads in this order.
+        for (size_t part = part_impacts.size(); part-- > 0;)
+        {
+            kcpu::calculate_projection_part_impacts(
+                projection, message_in_data, part_impacts[part], step, part * part_size, part_size);
+        }
+        for (const auto &impacts : part_impacts)
+        {
+            kcpu::add_future_impacts(projection, impacts, parts_messages, step, mutex);
+        }
+        ASSERT_EQ(get_impacts(mt_fan_out_messages), get_impacts(parts_messages));
+        ASSERT_EQ(mt_fan_out_count, count_impacts(get_impacts(mt_fan_out_messages)));
+    }
+}
+
+
+// Messages calculated without delay slots: the queue is searched for each impact.
+void calculate_unbucketed_data(
+    DeltaProjection &projection, const std::vector<uint32_t> &spikes, kcpu::MessageQueue &future_messages, size_t step)
+{
+    std::vector<size_t> activated_synapses;
+    for (auto neuron_index : spikes)
+    {
+        const auto synapses = projection.find_synapses(neuron_index, DeltaProjection::Search::by_presynaptic);
+        activated_synapses.insert(activated_synapses.end(), synapses.begin(), synapses.end());
+    }
+    std::sort(activated_synapses.begin(), activated_synapses.end());
+
+    for (auto synapse_index : activated_synapses)
+    {
+        const auto &synapse = projection[synapse_index];
+        const auto &synapse_params = std::get<knp::core::synapse_data>(synapse);
+        kcpu::get_future_impacts(projection, future_messages, synapse_params.delay_ + step - 1, step, true)
+            .push_back(knp::core::messaging::SynapticImpact{
+                synapse_index, synapse_params.weight_, synapse_params.output_type_,
+                static_cast<uint32_t>(std::get<knp::core::source_neuron_id>(synapse)),
+                static_cast<uint32_t>(std::get<knp::core::target_neuron_id>(synapse))});
+    }
+}
+
+
+TEST(CpuLibrarySuite, DelaySlotsEquivalenceTest)
+{
+    const size_t neurons_count = 50;
+    std::mt19937 engine(1);
+    std::uniform_int_distribution<size_t> neuron_distribution(0, neurons_count - 1);
+    std::uniform_int_distribution<uint32_t> delay_distribution(1, 8);
+    DeltaProjection projection{
+        knp::core::UID{}, knp::core::UID{},
+        [&](size_t index)
+        {
+            return DeltaProjection::Synapse{
+                {static_cast<float>(index), delay_distribution(engine), knp::synapse_traits::OutputType::EXCITATORY},
+                neuron_distribution(engine),
+                neuron_distribution(engine)};
+        },
+        1000};
+
+    auto to_map = [](const kcpu::MessageQueue &future_messages)
+    {
+        return std::map<uint64_t, knp::core::messaging::SynapticImpactMessage>(
+            future_messages.begin(), future_messages.end());
+    };
+
+    // Messages of previous steps stay in the queues, so impacts are appended to existing messages too.
+    kcpu::MessageQueue unbucketed_messages;
+    kcpu::MessageQueue fan_out_messages;
+    kcpu::MessageQueue dense_messages;
+    kcpu::MessageQueue parts_messages;
+    std::vector<uint32_t> spike_mask;
+    std::vector<size_t> activated_synapses;
+    std::mutex mutex;
+    for (size_t step = 1; step < 6; ++step)
+    {
+        std::vector<uint32_t> spikes;
+        for (size_t i = 0; i < step * 3; ++i) spikes.push_back(static_cast<uint32_t>(neuron_distribution(engine)));
+        std::vector<knp::core::messaging::SpikeMessage> messages{{{knp::core::UID{}, step}, spikes}};
+
+        calculate_unbucketed_data(projection, spikes, unbucketed_messages, step);
+        kcpu::calculate_delta_synapse_projection_data(projection, messages, fan_out_messages, step, activated_synapses);
+        kcpu::calculate_delta_synapse_projection_dense_data(projection, messages, dense_messages, step, spike_mask);
+        kcpu::calculate_projection_part(
+            projection, kcpu::convert_spikes(messages.front()), parts_messages, step, 0, projection.size(), mutex);
+
+        const auto unbucketed = to_map(unbucketed_messages);
+        ASSERT_FALSE(unbucketed.empty());
+        ASSERT_EQ(unbucketed, to_map(fan_out_messages));
+        ASSERT_EQ(unbucketed, to_map(dense_messages));
+        // The part kernel makes a single impact of a synapse with the weight multiplied by the spike count, so only
+        // messages are compared.
+        const auto parts = to_map(parts_messages);
+        ASSERT_EQ(parts.size(), unbucketed.size());
+        for (const auto &[future_step, message] : unbucketed)
+        {
+            const auto &parts_message = parts.at(future_step);
+            ASSERT_EQ(parts_message.presynaptic_population_uid_, message.presynaptic_population_uid_);
+            ASSERT_EQ(parts_message.postsynaptic_population_uid_, message.postsynaptic_population_uid_);
+        }
+    }
+}
+
+
+TEST(CpuLibrarySuite, ImpactMessagesOrderTest)
+{
+    using knp::core::messaging::AggregatedImpactMessage;
+    using knp::core::messaging::SynapticImpactMessage;
+
+    // Two projections block the same neuron for different periods, the last applied impact sets the period.
+    auto make_message = [](const knp::core::UID &sender_uid, float blocking_period)
+    {
+        return SynapticImpactMessage{
+            {sender_uid, 1},
+            knp::core::UID{},
+            knp::core::UID{},
+            false,
+            {{0, blocking_period, knp::synapse_traits::OutputType::BLOCKING, 0, 0}}};
+    };
+    const auto first_message = make_message(knp::core::UID{}, 3);
+    const auto second_message = make_message(knp::core::UID{}, 5);
+
+    auto get_blocking_period =
+        [](const std::vector<SynapticImpactMessage> &messages,
+           const std::vector<AggregatedImpactMessage> &aggregated_messages)
+    {
+        knp::testing::BLIFATPopulation population{knp::testing::neuron_generator, 1};
+        kcpu::process_inputs(population, messages, aggregated_messages);
+        return population[0].total_blocking_period_;
+    };
+
+    // Neither the order of received messages nor aggregation of impacts changes the result.
+    const auto blocking_period = get_blocking_period({first_message, second_message}, {});
+    ASSERT_EQ(get_blocking_period({second_message, first_message}, {}), blocking_period);
+    ASSERT_EQ(
+        get_blocking_period({first_message}, {knp::core::messaging::aggregate_impacts(second_message)}),
+        blocking_period);
+    ASSERT_EQ(
+        get_blocking_period({second_message}, {knp::core::messaging::aggregate_impacts(first_message)}),
+        blocking_period);
+}
@@ -22,14 +22,17 @@
 #include <knp/backends/cpu-multi-threaded/backend.h>
 #include <knp/backends/thread_pool/thread_pool_context.h>
 #include <knp/backends/thread_pool/thread_pool_executor.h>
+#include <knp/core/all_projections.h>
 #include <knp/core/population.h>
-#include <knp/core/projection.h>
 
 #include <generators.h>
 #include <spdlog/spdlog.h>
 #include <tests_common.h>
 
+#include <algorithm>
 #include <functional>
+#include <optional>
+#include <utility>
 #include <vector>
 
 
@@ -117,6 +120,266 @@ TEST(MultiThreadCpuSuite, SmallestNetwork)
 }
 
 
+TEST(MultiThreadCpuSuite, ProfilingTest)
+{
+    namespace kt = knp::testing;
+    kt::MTestingBack backend;
+
+    kt::BLIFATPopulation population{kt::neuron_generator, 1};
+    Projection loop_projection =
+        kt::DeltaProjection{population.get_uid(), population.get_uid(), kt::synapse_generator, 1};
+    Projection input_projection =
+        kt::DeltaProjection{knp::core::UID{false}, population.get_uid(), kt::input_projection_gen, 1};
+    knp::core::UID input_uid = std::visit([](const auto &proj) { return proj.get_uid(); }, input_projection);
+
+    backend.load_populations({population});
+    backend.load_projections({input_projection, loop_projection});
+
+    auto endpoint = backend.get_message_bus().create_endpoint();
+    knp::core::UID in_channel_uid;
+    backend.subscribe<knp::core::messaging::SpikeMessage>(input_uid, {in_channel_uid});
+    backend._init();
+
+    ASSERT_FALSE(backend.is_profiling_enabled());
+    backend.enable_profiling();
+    ASSERT_TRUE(backend.is_profiling_enabled());
+
+    for (knp::core::Step step = 0; step < 20; ++step)
+    {
+        send_messages_smallest_network(in_channel_uid, endpoint, step);
+        backend._step();
+    }
+
+    auto profile = backend.get_profile();
+    ASSERT_EQ(profile.steps_count_, 20);
+    ASSERT_EQ(profile.get_phase(knp::core::StepPhase::populations).calls_count_, 20);
+    ASSERT_EQ(profile.get_phase(knp::core::StepPhase::projections).calls_count_, 20);
+    ASSERT_EQ(profile.get_phase(knp::core::StepPhase::routing).calls_count_, 40);
+    ASSERT_EQ(profile.spikes_emitted_, 10);
+    ASSERT_GT(profile.impacts_sent_, 0);
+    // Projections start with the fan-out kernel and switch to the dense one, because all their synapses are activated.
+    ASSERT_GT(profile.fan_out_projections_, 0);
+    ASSERT_GT(profile.dense_projections_, 0);
+    ASSERT_GT(profile.messages_routed_, 0);
+    ASSERT_EQ(profile.entities_.size(), 3);
+    // Each step the population is calculated in three tasks: before inputs, inputs processing and after inputs.
+    ASSERT_EQ(profile.entities_[0].uid_, population.get_uid());
+    ASSERT_EQ(profile.entities_[0].calls_count_, 60);
+
+    backend.disable_profiling();
+    backend._step();
+    ASSERT_EQ(backend.get_profile().steps_count_, 20);
+
+    backend.reset_profile();
+    profile = backend.get_profile();
+    ASSERT_EQ(profile.steps_count_, 0);
+    ASSERT_EQ(profile.spikes_emitted_, 0);
+    ASSERT_EQ(profile.entities_[0].calls_count_, 0);
+}
+
+
+TEST(MultiThreadCpuSuite, ImpactAggregationTest)
+{
+    // Ten neurons in pairs: each neuron is connected to both neurons of the next pair, a neuron spikes if both
+    // neurons of the previous pair spike.
+    constexpr size_t neurons_count = 10;
+    auto run_network = [](bool aggregate_impacts)
+    {
+        knp::testing::MTestingBack backend;
+        knp::testing::BLIFATPopulation population{knp::testing::neuron_generator, neurons_count};
+        Projection input_projection = knp::testing::DeltaProjection{
+            knp::core::UID{false}, population.get_uid(),
+            [](size_t index) -> std::optional<knp::testing::DeltaProjection::Synapse>
+            {
+                return knp::testing::DeltaProjection::Synapse{
+                    {1.0, 1, knp::synapse_traits::OutputType::EXCITATORY}, index, index};
+            },
+            neurons_count};
+        Projection chain_projection = knp::testing::DeltaProjection{
+            population.get_uid(), population.get_uid(),
+            [](size_t index) -> std::optional<knp::testing::DeltaProjection::Synapse>
+            {
+                const size_t source = index / 2;
+                return knp::testing::DeltaProjection::Synapse{
+                    {0.6, 2, knp::synapse_traits::OutputType::EXCITATORY}, source,
+                    (source / 2 * 2 + 2 + index % 2) % neurons_count};
+            },
+            2 * neurons_count};
+        const auto input_uid = std::visit([](const auto &proj) { return proj.get_uid(); }, input_projection);
+        const auto chain_uid = std::visit([](const auto &proj) { return proj.get_uid(); }, chain_projection);
+
+        backend.load_populations({population});
+        backend.load_projections({input_projection, chain_projection});
+        backend._init();
+        if (aggregate_impacts) backend.enable_impact_aggregation();
+
+        auto endpoint = backend.get_message_bus().create_endpoint();
+        const knp::core::UID in_channel_uid, out_channel_uid, impacts_channel_uid;
+        backend.subscribe<knp::core::messaging::SpikeMessage>(input_uid, {in_channel_uid});
+        endpoint.subscribe<knp::core::messaging::SpikeMessage>(out_channel_uid, {population.get_uid()});
+        endpoint.subscribe<knp::core::messaging::SynapticImpactMessage>(impacts_channel_uid, {chain_uid});
+
+        std::vector<std::vector<uint32_t>> spikes;
+        size_t impact_messages_count = 0;
+        for (knp::core::Step step = 0; step < 30; ++step)
+        {
+            if (step % 10 == 0)
+            {
+                endpoint.send_message(knp::core::messaging::SpikeMessage{{in_channel_uid, step}, {0, 1}});
+            }
+            backend._step();
+            endpoint.receive_all_messages();
+            for (auto &message : endpoint.unload_messages<knp::core::messaging::SpikeMessage>(out_channel_uid))
+            {
+                std::sort(message.neuron_indexes_.begin(), message.neuron_indexes_.end());
+                spikes.push_back(message.neuron_indexes_);
+            }
+            impact_messages_count +=
+                endpoint.unload_messages<knp::core::messaging::SynapticImpactMessage>(impacts_channel_uid).size();
+        }
+        return std::make_pair(spikes, impact_messages_count);
+    };
+
+    const auto [spikes, impact_messages_count] = run_network(false);
+    const auto [aggregated_spikes, aggregated_impact_messages_count] = run_network(true);
+
+    // Spikes of the input neurons propagate along the chain.
+    ASSERT_GT(spikes.size(), 10);
+    ASSERT_EQ(spikes, aggregated_spikes);
+    // Synaptic impact messages are sent only if aggregation is disabled.
+    ASSERT_GT(impact_messages_count, 0);
+    ASSERT_EQ(aggregated_impact_messages_count, 0);
+}
+
+
+// Run ten neurons with an input projection to neurons 0 and 1 and a loop projection made by a function from the
+// population UID, return spikes of the population.
+template <class LoopProjectionMaker>
+std::vector<std::vector<uint32_t>> run_loop_network(LoopProjectionMaker make_loop_projection)
+{
+    constexpr size_t neurons_count = 10;
+    knp::testing::MTestingBack backend;
+    knp::testing::BLIFATPopulation population{knp::testing::neuron_generator, neurons_count};
+    Projection input_projection = knp::testing::DeltaProjection{
+        knp::core::UID{false}, population.get_uid(),
+        [](size_t index) -> std::optional<knp::testing::DeltaProjection::Synapse>
+        {
+            return knp::testing::DeltaProjection::Synapse{
+                {1.0, 1, knp::synapse_traits::OutputType::EXCITATORY}, index, index};
+        },
+        2};
+    Projection loop_projection = make_loop_projection(population.get_uid());
+    const auto input_uid = std::visit([](const auto &proj) { return proj.get_uid(); }, input_projection);
+
+    backend.load_populations({population});
+    backend.load_projections({input_projection, loop_projection});
+    backend._init();
+
+    auto endpoint = backend.get_message_bus().create_endpoint();
+    const knp::core::UID in_channel_uid, out_channel_uid;
+    backend.subscribe<knp::core::messaging::SpikeMessage>(input_uid, {in_channel_uid});
+    endpoint.subscribe<knp::core::messaging::SpikeMessage>(out_channel_uid, {population.get_uid()});
+
+    std::vector<std::vector<uint32_t>> spikes;
+    for (knp::core::Step step = 0; step < 30; ++step)
+    {
+        if (step % 10 == 0) endpoint.send_message(knp::core::messaging::SpikeMessage{{in_channel_uid, step}, {0, 1}});
+        backend._step();
+        endpoint.receive_all_messages();
+        for (auto &message : endpoint.unload_messages<knp::core::messaging::SpikeMessage>(out_channel_uid))
+        {
+            std::sort(message.neuron_indexes_.begin(), message.neuron_indexes_.end());
+            spikes.push_back(message.neuron_indexes_);
+        }
+    }
+    return spikes;
+}
+
+
+TEST(MultiThreadCpuSuite, CompactProjectionTest)
+{
+    // Each neuron is connected to both neurons of the next pair, pairs have different delays.
+    auto make_chain = [](const knp::core::UID &population_uid)
+    {
+        return knp::testing::DeltaProjection{
+            population_uid, population_uid,
+            [](size_t index) -> std::optional<knp::testing::DeltaProjection::Synapse>
+            {
+                const size_t source = index / 2;
+                return knp::testing::DeltaProjection::Synapse{
+                    {0.6, static_cast<uint32_t>(2 + source / 2 % 2), knp::synapse_traits::OutputType::EXCITATORY},
+                    source, (source / 2 * 2 + 2 + index % 2) % 10};
+            },
+            20};
+    };
+
+    const auto spikes = run_loop_network([&make_chain](const auto &uid) { return Projection{make_chain(uid)}; });
+    const auto compact_spikes = run_loop_network(
+        [&make_chain](const auto &uid)
+        { return Projection{knp::core::CompactProjection<knp::synapse_traits::DeltaSynapse>(make_chain(uid))}; });
+
+    // Compact weights are rounded, but the rounding doesn't change spikes.
+    ASSERT_GT(spikes.size(), 10);
+    ASSERT_EQ(spikes, compact_spikes);
+}
+
+
+TEST(MultiThreadCpuSuite, ProceduralProjectionTest)
+{
+    using ProceduralProjection = knp::core::ProceduralProjection<knp::synapse_traits::DeltaSynapse>;
+
+    // Each neuron is connected to both neurons of the next pair with random delays.
+    auto make_procedural = [](const knp::core::UID &population_uid)
+    {
+        return ProceduralProjection{
+            population_uid, population_uid, 10,
+            [](size_t neuron_index, knp::core::Philox4x32 &generator,
+               std::vector<ProceduralProjection::Synapse> &synapses)
+            {
+                for (size_t target_index = 0; target_index < 2; ++target_index)
+                {
+                    synapses.push_back(ProceduralProjection::Synapse{
+                        {1.2, 1 + generator() % 3, knp::synapse_traits::OutputType::EXCITATORY},
+                        neuron_index, (neuron_index / 2 * 2 + 2 + target_index) % 10});
+                }
+            },
+            42};
+    };
+
+    const auto spikes = run_loop_network(
+        [&make_procedural](const auto &uid) { return Projection{make_procedural(uid).materialize()}; });
+    const auto procedural_spikes =
+        run_loop_network([&make_procedural](const auto &uid) { return Projection{make_procedural(uid)}; });
+
+    ASSERT_GT(spikes.size(), 10);
+    ASSERT_EQ(spikes, procedural_spikes);
+}
+
+
+TEST(MultiThreadCpuSuite, ConvolutionProjectionTest)
+{
+    // A one-row image of ten neurons, each neuron excites the next one.
+    knp::core::ConvolutionGeometry geometry;
+    geometry.input_width_ = 10;
+    geometry.kernel_width_ = 3;
+    geometry.padding_x_ = 1;
+
+    auto make_convolution = [&geometry](const knp::core::UID &population_uid)
+    {
+        return knp::core::ConvolutionProjection<knp::synapse_traits::DeltaSynapse>{
+            population_uid, population_uid, geometry, {1.2F, 0.3F, 0.F}, 2};
+    };
+
+    const auto spikes = run_loop_network(
+        [&make_convolution](const auto &uid) { return Projection{make_convolution(uid).materialize()}; });
+    const auto convolution_spikes =
+        run_loop_network([&make_convolution](const auto &uid) { return Projection{make_convolution(uid)}; });
+
+    ASSERT_GT(spikes.size(), 10);
+    ASSERT_EQ(spikes, convolution_spikes);
+}
+
+
 TEST(MultiThreadCpuSuite, NeuronsGettingTest)
 {
     const knp::testing::MTestingBack backend;
@@ -0,0 +1,58 @@
+/**
+ * @file counter_rng_test.cpp
+ * @brief Counter-based random number generator tests.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/core/counter_rng.h>
+
+#include <tests_common.h>
+
+#include <vector>
+
+
+TEST(CounterRngSuite, PhiloxKnownAnswers)
+{
+    using Philox = knp::core::Philox4x32;
+
+    // Known answer tests of the Random123 library.
+    ASSERT_EQ(Philox::generate({0, 0, 0, 0}, {0, 0}), (Philox::Block{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+    ASSERT_EQ(
+        Philox::generate({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff}),
+        (Philox::Block{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+    ASSERT_EQ(
+        Philox::generate({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, {0xa4093822, 0x299f31d0}),
+        (Philox::Block{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+}
+
+
+TEST(CounterRngSuite, PhiloxStreams)
+{
+    auto generate = [](uint64_t seed, uint64_t stream)
+    {
+        knp::core::Philox4x32 rng(seed, stream);
+        std::vector<uint32_t> result(10);
+        for (auto &value : result) value = rng();
+        return result;
+    };
+
+    // The same seed and stream give the same sequence.
+    ASSERT_EQ(generate(1, 2), generate(1, 2));
+    ASSERT_NE(generate(1, 2), generate(1, 3));
+    ASSERT_NE(generate(1, 2), generate(2, 2));
+}
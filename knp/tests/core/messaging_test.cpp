@@ -96,3 +96,60 @@ TEST(MessageSuite, HeaderIOTest)
     ASSERT_EQ(header_in.sender_uid_, header_out.sender_uid_);
     ASSERT_EQ(header_in.send_time_, header_out.send_time_);
 }
+
+
+TEST(MessageSuite, AggregatedImpactToChannelTest)
+{
+    using knp::synapse_traits::OutputType;
+    const knp::core::UID uid{true}, pre_uid{true}, post_uid{true};
+    const size_t time = 7;
+
+    const knp::core::messaging::AggregatedImpactMessage message_in{
+        {uid, time},
+        pre_uid,
+        post_uid,
+        true,
+        {{OutputType::EXCITATORY, {}, {1.5F, 0, 2}}, {OutputType::BLOCKING, {3, 8}, {-1, 4}}}};
+    knp::core::messaging::AggregatedImpactMessage message_out;
+
+    std::stringstream stream;
+
+    stream << message_in;
+    stream >> message_out;
+
+    ASSERT_EQ(message_out, message_in);
+}
+
+
+TEST(MessageSuite, AggregateImpactsTest)
+{
+    using knp::synapse_traits::OutputType;
+    const knp::core::UID uid{true}, pre_uid{true}, post_uid{true};
+
+    // Excitatory impacts cover most neurons and become dense, inhibitory impacts stay sparse.
+    const std::vector<knp::core::messaging::SynapticImpact> impacts{
+        {0, 1, OutputType::EXCITATORY, 0, 2},      {1, 2, OutputType::EXCITATORY, 1, 0},
+        {2, 3, OutputType::EXCITATORY, 2, 2},      {3, 4, OutputType::INHIBITORY_CURRENT, 0, 10},
+        {4, 5, OutputType::BLOCKING, 1, 4},        {5, -6, OutputType::BLOCKING, 2, 4},
+        {6, 7, OutputType::INHIBITORY_CURRENT, 1, 10}};
+    knp::core::messaging::SynapticImpactMessage message{{uid, 3}, pre_uid, post_uid, false, impacts};
+
+    auto result = knp::core::messaging::aggregate_impacts(message);
+
+    ASSERT_EQ(result.header_.sender_uid_, uid);
+    ASSERT_EQ(result.header_.send_time_, 3);
+    ASSERT_EQ(result.presynaptic_population_uid_, pre_uid);
+    ASSERT_EQ(result.postsynaptic_population_uid_, post_uid);
+    ASSERT_EQ(result.impacts_.size(), 3);
+
+    ASSERT_EQ(result.impacts_[0], (knp::core::messaging::AggregatedImpacts{OutputType::EXCITATORY, {}, {2, 0, 4}}));
+    ASSERT_EQ(
+        result.impacts_[1], (knp::core::messaging::AggregatedImpacts{OutputType::INHIBITORY_CURRENT, {10}, {11}}));
+    // The last blocking impact on a neuron is kept.
+    ASSERT_EQ(result.impacts_[2], (knp::core::messaging::AggregatedImpacts{OutputType::BLOCKING, {4}, {-6}}));
+
+    // Excitatory impacts of a forcing message are not dense.
+    message.is_forcing_ = true;
+    result = knp::core::messaging::aggregate_impacts(message);
+    ASSERT_EQ(result.impacts_[0], (knp::core::messaging::AggregatedImpacts{OutputType::EXCITATORY, {0, 2}, {2, 4}}));
+}
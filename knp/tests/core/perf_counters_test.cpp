@@ -0,0 +1,80 @@
+/**
+ * @file perf_counters_test.cpp
+ * @brief Hardware performance counters testing.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/core/perf_counters.h>
+#include <knp/core/step_profiler.h>
+
+#include <tests_common.h>
+
+#include <numeric>
+#include <vector>
+
+
+TEST(PerfCountersSuite, ReadTest)
+{
+    knp::core::PerfCounterValues values;
+    // Counters can be unavailable in containers and virtual machines, then they are never read.
+    if (!knp::core::perf_counters_supported())
+    {
+        ASSERT_FALSE(knp::core::read_perf_counters(values));
+        return;
+    }
+
+    ASSERT_TRUE(knp::core::read_perf_counters(values));
+    std::vector<int> data(100000, 1);
+    volatile int sum = std::accumulate(data.begin(), data.end(), 0);
+    ASSERT_EQ(sum, 100000);
+
+    knp::core::PerfCounterValues new_values;
+    ASSERT_TRUE(knp::core::read_perf_counters(new_values));
+    ASSERT_GE(new_values.cycles_, values.cycles_);
+    ASSERT_GE(new_values.instructions_, values.instructions_);
+}
+
+
+TEST(PerfCountersSuite, ProfilerTest)
+{
+    knp::core::StepProfiler profiler;
+    profiler.enable({}, true);
+    {
+        knp::core::StepProfiler::ScopedTimer timer(profiler.get_phase_counter(knp::core::StepPhase::populations));
+        std::vector<int> data(100000, 1);
+        volatile int sum = std::accumulate(data.begin(), data.end(), 0);
+        ASSERT_EQ(sum, 100000);
+    }
+
+    const auto profile = profiler.get_profile();
+    const auto &phase = profile.get_phase(knp::core::StepPhase::populations);
+    ASSERT_EQ(phase.calls_count_, 1);
+    // Profiling works with or without hardware counters.
+    ASSERT_EQ(profile.hardware_counters_, knp::core::perf_counters_supported());
+    if (profile.hardware_counters_)
+    {
+        ASSERT_GT(phase.counters_.instructions_ + phase.counters_.cycles_, 0);
+    }
+    else
+    {
+        ASSERT_EQ(phase.counters_.instructions_, 0);
+    }
+
+    profiler.reset();
+    ASSERT_EQ(profiler.get_profile().get_phase(knp::core::StepPhase::populations).counters_.instructions_, 0);
+}
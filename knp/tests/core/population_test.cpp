@@ -81,3 +81,20 @@ TEST(PopulationSuite, SetNeuronParameter)
 
     ASSERT_EQ(150, population[p_index].potential_);
 }
+
+
+TEST(PopulationSuite, MemoryUsageTest)
+{
+    knp::core::Population<knp::neuron_traits::BLIFATNeuron> population(neuron_generator, neurons_count);
+
+    auto usage = population.memory_usage();
+    ASSERT_EQ(usage.parameters_, neurons_count * sizeof(BLIFATParams));
+    ASSERT_EQ(usage.index_, 0);
+
+    // Removed neurons keep their memory as capacity slack.
+    population.remove_neurons({1, 3, 5});
+    usage = population.memory_usage();
+    ASSERT_EQ(usage.parameters_, (neurons_count - 3) * sizeof(BLIFATParams));
+    ASSERT_EQ(usage.total(), usage.parameters_ + usage.slack_);
+    ASSERT_GE(usage.slack_, 3 * sizeof(BLIFATParams));
+}
@@ -19,6 +19,8 @@
  * limitations under the License.
  */
 
+#include <knp/core/compact_projection.h>
+#include <knp/core/convolution_projection.h>
 #include <knp/core/projection.h>
 #include <knp/synapse-traits/delta.h>
 
@@ -26,6 +28,8 @@
 
 #include <cstdlib>
 #include <optional>
+#include <set>
+#include <tuple>
 
 
 namespace knc = knp::core;
@@ -218,6 +222,76 @@ TEST(ProjectionSuite, SynapseRemoval)
 }
 
 
+TEST(ProjectionSuite, IncrementalIndexTest)
+{
+    const uint32_t presynaptic_size = 10;
+    const uint32_t postsynaptic_size = 10;
+    auto generator = make_dense_generator(
+        {presynaptic_size, postsynaptic_size}, {0.0, 1, knp::synapse_traits::OutputType::EXCITATORY});
+    DeltaProjection projection{knc::UID{}, knc::UID{}, generator, presynaptic_size * postsynaptic_size};
+
+    // Index is consistent with synapses if all found synapses match the search criterion and none is missed.
+    auto check_index = [&projection]()
+    {
+        for (size_t neuron = 0; neuron < 20; ++neuron)
+        {
+            auto synapses = projection.find_synapses(neuron, DeltaProjection::Search::by_presynaptic);
+            ASSERT_EQ(
+                synapses.size(),
+                std::count_if(
+                    projection.begin(), projection.end(),
+                    [neuron](const Synapse &synapse) { return std::get<knc::source_neuron_id>(synapse) == neuron; }));
+            for (auto index : synapses) ASSERT_EQ(std::get<knc::source_neuron_id>(projection[index]), neuron);
+
+            synapses = projection.find_synapses(neuron, DeltaProjection::Search::by_postsynaptic);
+            ASSERT_EQ(
+                synapses.size(),
+                std::count_if(
+                    projection.begin(), projection.end(),
+                    [neuron](const Synapse &synapse) { return std::get<knc::target_neuron_id>(synapse) == neuron; }));
+            for (auto index : synapses) ASSERT_EQ(std::get<knc::target_neuron_id>(projection[index]), neuron);
+        }
+    };
+
+    projection.add_synapses(
+        [](size_t index) -> std::optional<Synapse>
+        { return Synapse{{1.0, 1, knp::synapse_traits::OutputType::EXCITATORY}, 10 + index, index}; },
+        5);
+    check_index();
+
+    projection.remove_synapse(3);
+    ASSERT_EQ(std::get<knc::target_neuron_id>(projection[3]), 4);
+    check_index();
+
+    ASSERT_EQ(projection.remove_presynaptic_neuron_synapses(5), postsynaptic_size);
+    check_index();
+
+    ASSERT_EQ(
+        projection.remove_synapse_if(
+            [](const Synapse &synapse) { return std::get<knc::target_neuron_id>(synapse) == 7; }),
+        presynaptic_size - 1);
+    check_index();
+
+    // Removals refer to synapse indexes before the transaction, additions are appended after removals.
+    const size_t size_before = projection.size();
+    const auto last_synapse = projection[size_before - 1];
+    auto transaction = projection.begin_transaction();
+    transaction.remove_synapse(0);
+    transaction.remove_synapse(size_before - 2);
+    transaction.remove_synapse(0);
+    transaction.add_synapse(Synapse{{2.0, 1, knp::synapse_traits::OutputType::EXCITATORY}, 19, 19});
+    ASSERT_EQ(projection.size(), size_before);
+    transaction.commit();
+    ASSERT_EQ(projection.size(), size_before - 1);
+    ASSERT_EQ(
+        std::get<knc::source_neuron_id>(projection[size_before - 3]), std::get<knc::source_neuron_id>(last_synapse));
+    ASSERT_EQ(std::get<knc::target_neuron_id>(projection[size_before - 2]), 19);
+    check_index();
+
+    ASSERT_THROW(projection.update_synapses({projection.size()}, {}), std::out_of_range);
+}
+
+
 TEST(ProjectionSuite, LockTest)
 {
     DeltaProjection projection(knc::UID{}, knc::UID{});
@@ -268,3 +342,282 @@ TEST(ProjectionSuite, GetUIDTest)
     ASSERT_EQ(projection.get_presynaptic(), uid_from);
     ASSERT_EQ(projection.get_postsynaptic(), uid_to);
 }
+
+
+TEST(ProjectionSuite, ConstructFromSynapsesTest)
+{
+    const knc::UID uid, uid_from, uid_to;
+    std::vector<DeltaProjection::Synapse> synapses;
+    synapses.emplace_back(SynapseParameters{1.0, 1, knp::synapse_traits::OutputType::EXCITATORY}, 0, 1);
+    synapses.emplace_back(SynapseParameters{2.0, 2, knp::synapse_traits::OutputType::EXCITATORY}, 1, 1);
+    const auto *data = synapses.data();
+
+    const DeltaProjection projection{uid, uid_from, uid_to, std::move(synapses)};
+    ASSERT_EQ(projection.get_uid(), uid);
+    ASSERT_EQ(projection.size(), 2);
+    // Synapse storage is taken over, not copied.
+    ASSERT_EQ(&*projection.begin(), data);
+    ASSERT_EQ(projection.find_synapses(1, DeltaProjection::Search::by_postsynaptic).size(), 2);
+}
+
+
+TEST(ProjectionSuite, EdgeIndexTest)
+{
+    const knc::UID uid, uid_from, uid_to;
+    auto make_synapses = []()
+    {
+        std::vector<DeltaProjection::Synapse> synapses;
+        synapses.emplace_back(SynapseParameters{}, 0, 1);
+        synapses.emplace_back(SynapseParameters{}, 1, 0);
+        synapses.emplace_back(SynapseParameters{}, 0, 0);
+        return synapses;
+    };
+    // Synapses of presynaptic neuron 0 are in two ranges.
+    DeltaProjection::EdgeIndex presynaptic_index{{{0, 2}, {2, 3}}, {{0, 1}, {2, 3}, {1, 2}}};
+    DeltaProjection::EdgeIndex postsynaptic_index{{{0, 1}, {1, 2}}, {{1, 3}, {0, 1}}};
+
+    DeltaProjection projection{
+        uid, uid_from, uid_to, make_synapses(), DeltaProjection::EdgeIndex{presynaptic_index},
+        DeltaProjection::EdgeIndex{postsynaptic_index}};
+    ASSERT_EQ(projection.find_synapses(0, DeltaProjection::Search::by_presynaptic), std::vector<size_t>({0, 2}));
+    ASSERT_EQ(projection.find_synapses(0, DeltaProjection::Search::by_postsynaptic), std::vector<size_t>({1, 2}));
+    ASSERT_TRUE(projection.find_synapses(2, DeltaProjection::Search::by_presynaptic).empty());
+
+    // Changed synapses are found by the hashed index.
+    projection.remove_synapse(0);
+    ASSERT_EQ(projection.find_synapses(0, DeltaProjection::Search::by_presynaptic), std::vector<size_t>({1}));
+
+    // Indexes that don't match synapses are replaced by the hashed index.
+    postsynaptic_index.range_to_edge_id_[1] = {1, 2};
+    const DeltaProjection mismatched{
+        uid, uid_from, uid_to, make_synapses(), std::move(presynaptic_index), std::move(postsynaptic_index)};
+    auto found = mismatched.find_synapses(1, DeltaProjection::Search::by_postsynaptic);
+    ASSERT_EQ(found, std::vector<size_t>({0}));
+}
+
+
+TEST(ProjectionSuite, DeferredLoadingTest)
+{
+    const knc::UID uid_from, uid_to;
+    size_t loads_count = 0;
+    DeltaProjection projection{uid_from, uid_to};
+    projection.set_synapse_loader(
+        [&loads_count](DeltaProjection &target)
+        {
+            ++loads_count;
+            target.add_synapses(
+                make_dense_generator({2, 3}, {0.0, 1, knp::synapse_traits::OutputType::EXCITATORY}), 6);
+        });
+    ASSERT_FALSE(projection.is_loaded());
+    ASSERT_EQ(projection.size(), 0);
+
+    // Copies share the loader and load synapses independently.
+    DeltaProjection projection_copy = projection;
+    projection_copy.load_synapses();
+    ASSERT_TRUE(projection_copy.is_loaded());
+    ASSERT_EQ(projection_copy.size(), 6);
+    ASSERT_EQ(projection_copy.get_uid(), projection.get_uid());
+    ASSERT_FALSE(projection.is_loaded());
+
+    projection.load_synapses();
+    projection.load_synapses();
+    ASSERT_EQ(loads_count, 2);
+    ASSERT_EQ(projection.find_synapses(1, DeltaProjection::Search::by_presynaptic).size(), 3);
+}
+
+
+TEST(ProjectionSuite, MemoryUsageTest)
+{
+    const size_t presynaptic_size = 3;
+    const size_t postsynaptic_size = 4;
+    auto generator = make_dense_generator(
+        {presynaptic_size, postsynaptic_size}, {0.0, 1, knp::synapse_traits::OutputType::EXCITATORY});
+    DeltaProjection projection{knc::UID{}, knc::UID{}, generator, presynaptic_size * postsynaptic_size};
+
+    ASSERT_EQ(projection.find_synapses(1, DeltaProjection::Search::by_presynaptic).size(), postsynaptic_size);
+    const auto usage = projection.memory_usage();
+    ASSERT_EQ(usage.parameters_, projection.size() * sizeof(Synapse));
+    // Each indexed synapse is stored in the index as three neuron and synapse indexes.
+    ASSERT_GE(usage.index_, projection.size() * 3 * sizeof(size_t));
+}
+
+
+TEST(ProjectionSuite, HalfConversionTest)
+{
+    ASSERT_EQ(knc::float_to_half(1.0F), 0x3C00);
+    ASSERT_EQ(knc::float_to_half(-2.0F), 0xC000);
+    ASSERT_EQ(knc::float_to_half(0.1F), 0x2E66);
+    ASSERT_EQ(knc::float_to_half(65504.0F), 0x7BFF);
+    // Overflow and the smallest subnormal value.
+    ASSERT_EQ(knc::float_to_half(65520.0F), 0x7C00);
+    ASSERT_EQ(knc::float_to_half(5.9604645e-8F), 0x0001);
+    ASSERT_EQ(knc::float_to_half(1e-9F), 0x0000);
+
+    for (const uint16_t half : {0x0001, 0x03FF, 0x0400, 0x3555, 0x3C00, 0x7BFF, 0xBC01})
+        ASSERT_EQ(knc::float_to_half(knc::half_to_float(half)), half);
+
+    ASSERT_EQ(knc::float_to_bfloat16(1.0F), 0x3F80);
+    ASSERT_FLOAT_EQ(knc::bfloat16_to_float(knc::float_to_bfloat16(-3.0F)), -3.0F);
+}
+
+
+TEST(ProjectionSuite, CompactProjectionTest)
+{
+    const size_t presynaptic_size = 5;
+    const size_t postsynaptic_size = 7;
+    DeltaProjection projection{knc::UID{}, knc::UID{}};
+    // Synapses are added by postsynaptic neuron, so that compact storage has to regroup them.
+    projection.add_synapses(
+        [](size_t index)
+        {
+            const size_t id_from = index % presynaptic_size;
+            const size_t id_to = index / presynaptic_size;
+            return Synapse{
+                {0.01F * static_cast<float>(index) - 0.105F, 2, knp::synapse_traits::OutputType::EXCITATORY}, id_from,
+                id_to};
+        },
+        presynaptic_size * postsynaptic_size);
+
+    for (auto format : {knc::WeightFormat::float32, knc::WeightFormat::float16, knc::WeightFormat::bfloat16,
+                        knc::WeightFormat::int8})
+    {
+        const knc::CompactProjection<knp::synapse_traits::DeltaSynapse> compact(projection, format);
+        ASSERT_EQ(compact.size(), projection.size());
+        ASSERT_EQ(compact.get_uid(), projection.get_uid());
+        ASSERT_EQ(compact.get_uniform_delay(), 2);
+        ASSERT_EQ(compact.get_uniform_output_type(), knp::synapse_traits::OutputType::EXCITATORY);
+        ASSERT_LT(compact.memory_usage().parameters_, projection.memory_usage().parameters_);
+
+        for (size_t neuron = 0; neuron < presynaptic_size; ++neuron)
+        {
+            const auto [begin, end] = compact.find_synapses(neuron);
+            ASSERT_EQ(end - begin, postsynaptic_size);
+            for (size_t index = begin; index < end; ++index)
+            {
+                ASSERT_EQ(compact.get_source(index), neuron);
+                // Synapses keep their order within a group.
+                ASSERT_EQ(compact.get_target(index), index - begin);
+                const size_t original_index = neuron + compact.get_target(index) * presynaptic_size;
+                const float weight = std::get<knc::synapse_data>(projection[original_index]).weight_;
+                const float tolerance = format == knc::WeightFormat::float32  ? 0.0F
+                                        : format == knc::WeightFormat::int8 ? compact.get_weight_scale() / 2
+                                                                             : std::abs(weight) / 128;
+                ASSERT_NEAR(compact.get_weight(index), weight, tolerance);
+            }
+        }
+        ASSERT_EQ(compact.find_synapses(presynaptic_size).first, compact.size());
+    }
+
+    // Different delays are stored for each synapse.
+    std::get<knc::synapse_data>(projection[3]).delay_ = 5;
+    const knc::CompactProjection<knp::synapse_traits::DeltaSynapse> compact(projection, knc::WeightFormat::float32);
+    ASSERT_FALSE(compact.get_uniform_delay().has_value());
+
+    const auto unpacked = compact.unpack();
+    ASSERT_EQ(unpacked.size(), projection.size());
+    const auto synapses = unpacked.find_synapses(3, DeltaProjection::Search::by_postsynaptic);
+    ASSERT_EQ(synapses.size(), presynaptic_size);
+    size_t long_delays = 0;
+    for (size_t index = 0; index < unpacked.size(); ++index)
+        long_delays += std::get<knc::synapse_data>(unpacked[index]).delay_ == 5;
+    ASSERT_EQ(long_delays, 1);
+
+    // Synapses of a neuron are sorted by delay into runs.
+    const auto [first_run, last_run] = compact.find_delay_runs(3);
+    ASSERT_EQ(last_run - first_run, 2);
+    const auto short_run = compact.get_delay_run(first_run);
+    const auto long_run = compact.get_delay_run(first_run + 1);
+    ASSERT_EQ(short_run.delay_, 2);
+    ASSERT_EQ(short_run.begin_, compact.find_synapses(3).first);
+    ASSERT_EQ(short_run.end_, long_run.begin_);
+    ASSERT_EQ(long_run.delay_, 5);
+    ASSERT_EQ(long_run.end_, compact.find_synapses(3).second);
+    ASSERT_EQ(long_run.end_ - long_run.begin_, 1);
+    ASSERT_EQ(compact.get_delay(long_run.begin_), 5);
+    ASSERT_EQ(compact.get_target(long_run.begin_), 0);
+    const auto [first_run_0, last_run_0] = compact.find_delay_runs(0);
+    ASSERT_EQ(last_run_0 - first_run_0, 1);
+}
+
+
+TEST(ProjectionSuite, UniformParametersTest)
+{
+    DeltaProjection projection{knc::UID{}, knc::UID{}};
+    projection.add_synapses(
+        [](size_t index)
+        {
+            return Synapse{
+                {1.0F, static_cast<uint32_t>(index + 1), knp::synapse_traits::OutputType::EXCITATORY}, 0, index};
+        },
+        4);
+
+    auto &uniform_params = projection.get_shared_parameters().synapses_parameters_;
+    const auto &synapse_params = std::get<knc::synapse_data>(projection[2]);
+    ASSERT_EQ(uniform_params.apply(synapse_params).delay_, 3);
+
+    uniform_params.delay_ = 2;
+    uniform_params.output_type_ = knp::synapse_traits::OutputType::INHIBITORY_CURRENT;
+    const auto params = uniform_params.apply(synapse_params);
+    ASSERT_EQ(params.delay_, 2);
+    ASSERT_EQ(params.output_type_, knp::synapse_traits::OutputType::INHIBITORY_CURRENT);
+    ASSERT_EQ(params.weight_, 1.0F);
+
+    // Compact storage keeps declared values once per projection.
+    const knc::CompactProjection<knp::synapse_traits::DeltaSynapse> compact(projection);
+    ASSERT_EQ(compact.get_uniform_delay(), 2);
+    ASSERT_EQ(compact.get_uniform_output_type(), knp::synapse_traits::OutputType::INHIBITORY_CURRENT);
+}
+
+
+TEST(ProjectionSuite, ConvolutionProjectionTest)
+{
+    // Padded convolution with two input channels and strided convolution with two output channels.
+    const std::vector<knc::ConvolutionGeometry> geometries{
+        {2, 4, 5, 1, 3, 3, 1, 1, 1, 1}, {1, 6, 6, 2, 2, 3, 2, 3, 0, 0}};
+    for (const auto &geometry : geometries)
+    {
+        std::vector<float> weights(geometry.kernel_size());
+        for (size_t i = 0; i < weights.size(); ++i) weights[i] = static_cast<float>(i + 1);
+        const knc::ConvolutionProjection<knp::synapse_traits::DeltaSynapse> projection(
+            knc::UID{}, knc::UID{}, geometry, weights, 2);
+
+        // Synapses enumerated by kernel positions.
+        std::set<std::tuple<size_t, size_t, float>> expected;
+        for (size_t out_c = 0; out_c < geometry.output_channels_; ++out_c)
+            for (size_t y = 0; y < geometry.output_height(); ++y)
+                for (size_t x = 0; x < geometry.output_width(); ++x)
+                    for (size_t in_c = 0; in_c < geometry.input_channels_; ++in_c)
+                        for (size_t ky = 0; ky < geometry.kernel_height_; ++ky)
+                            for (size_t kx = 0; kx < geometry.kernel_width_; ++kx)
+                            {
+                                const size_t in_y = y * geometry.stride_y_ + ky - geometry.padding_y_;
+                                const size_t in_x = x * geometry.stride_x_ + kx - geometry.padding_x_;
+                                // Padding positions underflow to large values.
+                                if (in_y >= geometry.input_height_ || in_x >= geometry.input_width_) continue;
+                                const size_t weight_index =
+                                    ((out_c * geometry.input_channels_ + in_c) * geometry.kernel_height_ + ky) *
+                                        geometry.kernel_width_ +
+                                    kx;
+                                expected.emplace(
+                                    (in_c * geometry.input_height_ + in_y) * geometry.input_width_ + in_x,
+                                    (out_c * geometry.output_height() + y) * geometry.output_width() + x,
+                                    weights[weight_index]);
+                            }
+
+        const auto materialized = projection.materialize();
+        ASSERT_EQ(materialized.size(), expected.size());
+        for (const auto &synapse : materialized)
+        {
+            const auto &params = std::get<knc::synapse_data>(synapse);
+            ASSERT_EQ(params.delay_, 2);
+            ASSERT_TRUE(expected.count(
+                {std::get<knc::source_neuron_id>(synapse), std::get<knc::target_neuron_id>(synapse), params.weight_}));
+        }
+        ASSERT_LT(projection.memory_usage().total(), materialized.memory_usage().total());
+    }
+
+    ASSERT_THROW(
+        knc::ConvolutionProjection<knp::synapse_traits::DeltaSynapse>(
+            knc::UID{}, knc::UID{}, knc::ConvolutionGeometry{1, 3, 3, 1, 2, 2}, std::vector<float>(3)),
+        std::invalid_argument);
+}
@@ -0,0 +1,72 @@
+/**
+ * @file statistics_test.cpp
+ * @brief Spike statistics testing.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/core/statistics.h>
+
+#include <tests_common.h>
+
+#include <stdexcept>
+#include <vector>
+
+
+TEST(StatisticsSuite, CollectorTest)
+{
+    const knp::core::UID population_uid;
+    const knp::core::UID other_uid;
+    knp::core::StatisticsCollector collector;
+    ASSERT_TRUE(collector.empty());
+
+    collector.add_population(population_uid, 4, {3, 2}, 10);
+    ASSERT_FALSE(collector.empty());
+
+    // Neuron 0 spikes with intervals 1, 2 and 7, neuron 1 spikes once. Index 5 is out of the population.
+    collector.add_spikes({{population_uid, 10}, {0, 1}});
+    collector.add_spikes({{population_uid, 11}, {0}});
+    collector.add_spikes({{population_uid, 13}, {0, 5}});
+    collector.add_spikes({{population_uid, 20}, {0}});
+    // Messages from other senders are ignored.
+    collector.add_spikes({{other_uid, 20}, {0, 1, 2, 3}});
+
+    auto statistics = collector.get_statistics(population_uid, 30);
+    ASSERT_EQ(statistics.population_uid_, population_uid);
+    ASSERT_EQ(statistics.first_step_, 10);
+    ASSERT_EQ(statistics.steps_count_, 20);
+    ASSERT_EQ(statistics.spikes_count_, 5);
+    ASSERT_EQ(statistics.neuron_spikes_counts_, (std::vector<uint64_t>{4, 1, 0, 0}));
+    // Bins: [1, 2], [3, 4], [5, ...].
+    ASSERT_EQ(statistics.isi_histogram_, (std::vector<uint64_t>{2, 0, 1}));
+    ASSERT_DOUBLE_EQ(statistics.get_firing_rate(), 5.0 / 20 / 4);
+    ASSERT_DOUBLE_EQ(statistics.get_neuron_firing_rates()[0], 4.0 / 20);
+
+    collector.reset(30);
+    collector.add_spikes({{population_uid, 31}, {0}});
+    statistics = collector.get_statistics(population_uid, 40);
+    ASSERT_EQ(statistics.first_step_, 30);
+    ASSERT_EQ(statistics.steps_count_, 10);
+    ASSERT_EQ(statistics.spikes_count_, 1);
+    // Interval between steps 20 and 31 is accounted after reset.
+    ASSERT_EQ(statistics.isi_histogram_, (std::vector<uint64_t>{0, 0, 1}));
+    ASSERT_EQ(collector.get_statistics(40).size(), 1);
+
+    collector.remove_population(population_uid);
+    ASSERT_TRUE(collector.empty());
+    ASSERT_THROW(static_cast<void>(collector.get_statistics(population_uid, 40)), std::out_of_range);
+}
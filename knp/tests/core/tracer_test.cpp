@@ -0,0 +1,98 @@
+/**
+ * @file tracer_test.cpp
+ * @brief Tracer testing.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/core/tracer.h>
+
+#include <tests_common.h>
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+
+TEST(TracerSuite, RingBufferTest)
+{
+    knp::core::Tracer tracer(4);
+
+    // Disabled tracer doesn't record events.
+    {
+        knp::core::Tracer::Scope scope(&tracer, "disabled", "test");
+    }
+    ASSERT_TRUE(tracer.get_events().empty());
+
+    tracer.enable();
+    for (size_t index = 0; index < 6; ++index)
+    {
+        knp::core::Tracer::Scope scope(&tracer, index % 2 ? "odd" : "even", "test");
+    }
+    std::thread([&tracer]() { knp::core::Tracer::Scope scope(&tracer, "other_thread", "test"); }).join();
+
+    auto events = tracer.get_events();
+    ASSERT_EQ(events.size(), 2);
+    // Only the last four events of the first thread are kept.
+    ASSERT_EQ(events[0].size(), 4);
+    ASSERT_STREQ(events[0][0].name_, "even");
+    ASSERT_LE(events[0][0].begin_ns_, events[0][0].end_ns_);
+    ASSERT_LE(events[0][0].end_ns_, events[0][3].begin_ns_);
+    ASSERT_EQ(events[1].size(), 1);
+    ASSERT_STREQ(events[1][0].name_, "other_thread");
+
+    std::stringstream stream;
+    tracer.write_chrome_trace(stream);
+    const std::string trace = stream.str();
+    ASSERT_NE(trace.find("\"traceEvents\""), std::string::npos);
+    ASSERT_NE(trace.find("\"name\": \"other_thread\", \"cat\": \"test\", \"ph\": \"X\""), std::string::npos);
+
+    tracer.clear();
+    events = tracer.get_events();
+    ASSERT_EQ(events.size(), 2);
+    ASSERT_TRUE(events[0].empty());
+}
+
+
+TEST(TracerSuite, ThreadBufferReuseTest)
+{
+    knp::core::Tracer tracer(4);
+    tracer.enable();
+
+    // Buffers of exited threads are reused.
+    for (size_t index = 0; index < 10; ++index)
+        std::thread([&tracer]() { knp::core::Tracer::Scope scope(&tracer, "thread", "test"); }).join();
+
+    const auto events = tracer.get_events();
+    ASSERT_EQ(events.size(), 1);
+    ASSERT_EQ(events[0].size(), 4);
+
+    // A destroyed tracer doesn't affect a new one on the same thread.
+    for (size_t index = 0; index < 10; ++index)
+    {
+        knp::core::Tracer other_tracer(4);
+        other_tracer.enable();
+        knp::core::Tracer::Scope scope(&other_tracer, "other", "test");
+    }
+    {
+        knp::core::Tracer::Scope scope(&tracer, "main", "test");
+    }
+    // The main thread takes the buffer released by the exited threads.
+    const auto main_events = tracer.get_events();
+    ASSERT_EQ(main_events.size(), 1);
+    ASSERT_STREQ(main_events[0].back().name_, "main");
+}
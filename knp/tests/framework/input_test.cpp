@@ -28,6 +28,8 @@
 
 #include <tests_common.h>
 
+#include <atomic>
+
 
 TEST(InputSuite, SequenceConverterTest)
 {
@@ -97,3 +99,53 @@ TEST(InputSuite, ChannelTest)
     ASSERT_EQ(message.header_.send_time_, send_time);
     ASSERT_EQ(message.neuron_indexes_, expected_indexes);
 }
+
+
+TEST(InputSuite, PrefetchingChannelTest)
+{
+    knp::core::MessageBus bus = knp::core::MessageBus::construct_bus();
+    auto endpoint = bus.create_endpoint();
+
+    // Generator sends the step number as a neuron index and fails on the step 13.
+    std::atomic<size_t> generated_count = 0;
+    knp::framework::io::input::InputChannel channel{
+        knp::core::UID(), bus.create_endpoint(),
+        [&generated_count](knp::core::Step step)
+        {
+            if (step == 13) throw std::runtime_error("Generator error.");
+            ++generated_count;
+            return knp::core::messaging::SpikeData{static_cast<knp::core::messaging::SpikeIndex>(step)};
+        }};
+    channel.set_prefetch_steps(4);
+    ASSERT_EQ(channel.get_prefetch_steps(), 4);
+
+    knp::core::UID output_uid;
+    knp::framework::io::input::connect_input(channel, endpoint, output_uid);
+
+    auto send_and_receive = [&](knp::core::Step step)
+    {
+        channel.send(step);
+        bus.route_messages();
+        endpoint.receive_all_messages();
+        auto messages = endpoint.unload_messages<knp::core::messaging::SpikeMessage>(output_uid);
+        ASSERT_EQ(messages.size(), 1);
+        EXPECT_EQ(messages[0].header_.send_time_, step);
+        EXPECT_EQ(
+            messages[0].neuron_indexes_,
+            knp::core::messaging::SpikeData{static_cast<knp::core::messaging::SpikeIndex>(step)});
+    };
+
+    for (knp::core::Step step = 0; step < 10; ++step) send_and_receive(step);
+    // Generation restarts if steps are not consecutive.
+    send_and_receive(5);
+    send_and_receive(11);
+    send_and_receive(12);
+    ASSERT_THROW(channel.send(13), std::runtime_error);
+    send_and_receive(14);
+
+    // Disabling prefetching returns the generator to the channel.
+    channel.set_prefetch_steps(0);
+    const size_t count = generated_count;
+    send_and_receive(20);
+    ASSERT_EQ(generated_count, count + 1);
+}
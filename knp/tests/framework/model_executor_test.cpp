@@ -30,7 +30,13 @@
 #include <spdlog/spdlog.h>
 #include <tests_common.h>
 
+#include <atomic>
 #include <filesystem>
+#include <future>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 
 TEST(FrameworkSuite, ModelExecutorLoad)
@@ -100,3 +106,139 @@ TEST(FrameworkSuite, ModelExecutorLoad)
     ASSERT_EQ(pop_tag, knp::core::tags::IOType::output);
     ASSERT_EQ(proj_tag, knp::core::tags::IOType::input);
 }
+
+
+TEST(FrameworkSuite, ModelExecutorRunFor)
+{
+    namespace kt = knp::testing;
+
+    kt::BLIFATPopulation population{kt::neuron_generator, 1};
+    kt::DeltaProjection loop_projection =
+        kt::DeltaProjection{population.get_uid(), population.get_uid(), kt::synapse_generator, 1};
+    kt::DeltaProjection input_projection =
+        kt::DeltaProjection{knp::core::UID{false}, population.get_uid(), kt::input_projection_gen, 1};
+
+    const knp::core::UID input_uid = input_projection.get_uid();
+    const knp::core::UID output_uid = population.get_uid();
+
+    knp::framework::Network network;
+    network.add_population(std::move(population));
+    network.add_projection<kt::DeltaProjection>(std::move(input_projection));
+    network.add_projection<kt::DeltaProjection>(std::move(loop_projection));
+
+    const knp::core::UID i_channel_uid, o_channel_uid;
+
+    knp::framework::Model model(std::move(network));
+    model.add_input_channel(i_channel_uid, input_uid);
+    model.add_output_channel(o_channel_uid, output_uid);
+
+    std::vector<knp::core::Step> generated_steps;
+    auto input_gen = [&generated_steps](knp::core::Step step) -> knp::core::messaging::SpikeData
+    {
+        generated_steps.push_back(step);
+        if (step % 5 == 0) return {0};
+        return {};
+    };
+
+    knp::framework::BackendLoader backend_loader;
+    knp::framework::ModelExecutor model_executor(
+        model, backend_loader.load(knp::testing::get_backend_path()), {{i_channel_uid, input_gen}});
+
+    auto &out_channel = model_executor.get_loader().get_output_channel(o_channel_uid);
+
+    ASSERT_THROW(model_executor.run_for(20, 0), std::invalid_argument);
+    // The last batch is shorter than the update period.
+    ASSERT_EQ(model_executor.run_for(20, 7), 20);
+    ASSERT_EQ(model_executor.get_backend()->get_step(), 20);
+
+    // Input data are generated once for each step.
+    std::vector<knp::core::Step> expected_steps(20);
+    std::iota(expected_steps.begin(), expected_steps.end(), 0);
+    ASSERT_EQ(generated_steps, expected_steps);
+
+    std::vector<knp::core::Step> results;
+    const auto spikes = out_channel.read_some_from_buffer(0, 20);
+    std::transform(
+        spikes.cbegin(), spikes.cend(), std::back_inserter(results),
+        [](const auto &spike_msg) { return spike_msg.header_.send_time_; });
+    // Batched execution produces the same spikes as `start()`.
+    const std::vector<knp::core::Step> expected_results = {1, 6, 7, 11, 12, 13, 16, 17, 18, 19};
+    ASSERT_EQ(results, expected_results);
+}
+
+
+TEST(FrameworkSuite, ModelExecutorAsync)
+{
+    namespace kt = knp::testing;
+
+    kt::BLIFATPopulation population{kt::neuron_generator, 1};
+    kt::DeltaProjection loop_projection =
+        kt::DeltaProjection{population.get_uid(), population.get_uid(), kt::synapse_generator, 1};
+    kt::DeltaProjection input_projection =
+        kt::DeltaProjection{knp::core::UID{false}, population.get_uid(), kt::input_projection_gen, 1};
+
+    const knp::core::UID input_uid = input_projection.get_uid();
+    const knp::core::UID output_uid = population.get_uid();
+
+    knp::framework::Network network;
+    network.add_population(std::move(population));
+    network.add_projection<kt::DeltaProjection>(std::move(input_projection));
+    network.add_projection<kt::DeltaProjection>(std::move(loop_projection));
+
+    const knp::core::UID i_channel_uid, o_channel_uid;
+
+    knp::framework::Model model(std::move(network));
+    model.add_input_channel(i_channel_uid, input_uid);
+    model.add_output_channel(o_channel_uid, output_uid);
+
+    auto input_gen = [](knp::core::Step step) -> knp::core::messaging::SpikeData
+    {
+        if (step % 5 == 0) return {0};
+        return {};
+    };
+
+    knp::framework::BackendLoader backend_loader;
+    knp::framework::ModelExecutor model_executor(
+        model, backend_loader.load(knp::testing::get_backend_path()), {{i_channel_uid, input_gen}});
+
+    auto &out_channel = model_executor.get_loader().get_output_channel(o_channel_uid);
+
+    model_executor.pause();
+    auto result = model_executor.start_async(16);
+    model_executor.run_until(20);
+
+    // Commands are executed while execution is paused.
+    std::promise<knp::core::Step> command_step;
+    model_executor.post([&command_step](knp::core::Backend &backend) { command_step.set_value(backend.get_step()); });
+    ASSERT_EQ(command_step.get_future().get(), 0);
+    ASSERT_TRUE(model_executor.is_paused());
+    ASSERT_THROW(model_executor.start_async(), std::logic_error);
+
+    // Commands can be posted from several threads.
+    std::atomic<size_t> commands_count = 0;
+    std::vector<std::thread> producers;
+    for (size_t thread_index = 0; thread_index < 4; ++thread_index)
+    {
+        producers.emplace_back(
+            [&model_executor, &commands_count]()
+            {
+                for (size_t index = 0; index < 100; ++index)
+                    model_executor.post([&commands_count](knp::core::Backend &) { ++commands_count; });
+            });
+    }
+    for (auto &producer : producers) producer.join();
+
+    model_executor.resume();
+    result.get();
+    ASSERT_EQ(model_executor.get_async_step(), 20);
+    ASSERT_EQ(commands_count, 400);
+    ASSERT_THROW(model_executor.post([](knp::core::Backend &) {}), std::logic_error);
+
+    std::vector<knp::core::Step> results;
+    const auto spikes = out_channel.read_some_from_buffer(0, 20);
+    std::transform(
+        spikes.cbegin(), spikes.cend(), std::back_inserter(results),
+        [](const auto &spike_msg) { return spike_msg.header_.send_time_; });
+    const std::vector<knp::core::Step> expected_results = {1, 6, 7, 11, 12, 13, 16, 17, 18, 19};
+    ASSERT_EQ(results, expected_results);
+}
@@ -0,0 +1,150 @@
+/**
+ * @file observer_test.cpp
+ * @brief Message observer testing.
+ * @kaspersky_support Artiom N.
+ * @date 19.10.2026
+ * @license Apache 2.0
+ * @copyright © 2024 AO Kaspersky Lab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <knp/core/message_bus.h>
+#include <knp/framework/monitoring/observer.h>
+
+#include <tests_common.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+using knp::core::messaging::SpikeMessage;
+using knp::framework::monitoring::MessageObserver;
+using knp::framework::monitoring::OverflowPolicy;
+
+
+// Send one message per step and update the observer.
+void run_steps(
+    knp::core::MessageBus &bus, knp::core::MessageEndpoint &sender, MessageObserver<SpikeMessage> &observer,
+    const knp::core::UID &sender_uid, knp::core::Step steps)
+{
+    for (knp::core::Step step = 0; step < steps; ++step)
+    {
+        sender.send_message(SpikeMessage{{sender_uid, step}, {static_cast<uint32_t>(step)}});
+        bus.route_messages();
+        observer.update();
+    }
+}
+
+}  // namespace
+
+
+TEST(ObserverSuite, AsyncBlockTest)
+{
+    knp::core::MessageBus bus = knp::core::MessageBus::construct_bus();
+    auto sender = bus.create_endpoint();
+    knp::core::UID sender_uid;
+
+    std::vector<knp::core::Step> steps;
+    std::thread::id processing_thread;
+    MessageObserver<SpikeMessage> observer(
+        bus.create_endpoint(),
+        [&](const std::vector<SpikeMessage> &messages)
+        {
+            processing_thread = std::this_thread::get_id();
+            for (const auto &msg : messages) steps.push_back(msg.header_.send_time_);
+        });
+    observer.subscribe({sender_uid});
+    observer.set_async(2, OverflowPolicy::block);
+    ASSERT_TRUE(observer.is_async());
+
+    run_steps(bus, sender, observer, sender_uid, 100);
+    observer.flush();
+
+    ASSERT_EQ(steps.size(), 100);
+    for (size_t i = 0; i < steps.size(); ++i) ASSERT_EQ(steps[i], i);
+    ASSERT_NE(processing_thread, std::this_thread::get_id());
+    ASSERT_EQ(observer.get_dropped_count(), 0);
+
+    // Switch back to synchronous processing.
+    observer.set_async(0);
+    ASSERT_FALSE(observer.is_async());
+    run_steps(bus, sender, observer, sender_uid, 1);
+    ASSERT_EQ(processing_thread, std::this_thread::get_id());
+    ASSERT_EQ(steps.size(), 101);
+}
+
+
+TEST(ObserverSuite, AsyncDropAndCoalesceTest)
+{
+    knp::core::MessageBus bus = knp::core::MessageBus::construct_bus();
+    auto sender = bus.create_endpoint();
+    knp::core::UID sender_uid;
+
+    for (auto policy : {OverflowPolicy::drop, OverflowPolicy::coalesce})
+    {
+        std::atomic<bool> release = false;
+        size_t messages_count = 0;
+        size_t batches_count = 0;
+        MessageObserver<SpikeMessage> observer(
+            bus.create_endpoint(),
+            [&](const std::vector<SpikeMessage> &messages)
+            {
+                // Processing is stuck until the observer thread releases it.
+                while (!release) std::this_thread::yield();
+                messages_count += messages.size();
+                ++batches_count;
+            });
+        observer.subscribe({sender_uid});
+        observer.set_async(1, policy);
+
+        // At most one batch is processed and one is queued, other batches overflow the queue.
+        run_steps(bus, sender, observer, sender_uid, 10);
+        release = true;
+        observer.flush();
+
+        if (policy == OverflowPolicy::drop)
+        {
+            ASSERT_GE(observer.get_dropped_count(), 8);
+            ASSERT_EQ(messages_count + observer.get_dropped_count(), 10);
+        }
+        else
+        {
+            ASSERT_EQ(observer.get_dropped_count(), 0);
+            ASSERT_EQ(messages_count, 10);
+            ASSERT_LE(batches_count, 3);
+        }
+    }
+}
+
+
+TEST(ObserverSuite, AsyncErrorTest)
+{
+    knp::core::MessageBus bus = knp::core::MessageBus::construct_bus();
+    auto sender = bus.create_endpoint();
+    knp::core::UID sender_uid;
+
+    MessageObserver<SpikeMessage> observer(
+        bus.create_endpoint(),
+        [](const std::vector<SpikeMessage> &) { throw std::runtime_error("Processing error."); });
+    observer.subscribe({sender_uid});
+    observer.set_async(4);
+
+    run_steps(bus, sender, observer, sender_uid, 1);
+    ASSERT_THROW(observer.flush(), std::runtime_error);
+    ASSERT_THROW(run_steps(bus, sender, observer, sender_uid, 1), std::runtime_error);
+}
@@ -89,6 +89,9 @@ TEST(OutputSuite, ChannelTest)
     auto c3_uid = knp::core::UID();
     endpoint_3.subscribe<knp::core::messaging::SpikeMessage>(c3_uid, {sender_uid});
     knp::framework::io::output::OutputChannel channel_max{c3_uid, std::move(endpoint_3)};
+    // Channels keep a limited number of steps by default.
+    ASSERT_EQ(
+        channel_max.get_max_buffered_steps(), knp::framework::io::output::OutputChannel::default_max_buffered_steps);
 
     // Do message exchange.
 
@@ -123,3 +126,52 @@ TEST(OutputSuite, ChannelTest)
     ASSERT_EQ(set_result, expected_set);
     ASSERT_EQ(index, expected_index);
 }
+
+
+TEST(OutputSuite, LimitedBufferTest)
+{
+    knp::core::MessageBus bus = knp::core::MessageBus::construct_bus();
+    auto endpoint = bus.create_endpoint();
+    knp::core::UID sender_uid;
+
+    auto channel_endpoint = bus.create_endpoint();
+    auto channel_uid = knp::core::UID();
+    channel_endpoint.subscribe<knp::core::messaging::SpikeMessage>(channel_uid, {sender_uid});
+    // Keep only the last 4 steps.
+    knp::framework::io::output::OutputChannel channel{channel_uid, std::move(channel_endpoint), 4};
+
+    auto send_and_update = [&](knp::core::Step step)
+    {
+        endpoint.send_message(knp::core::messaging::SpikeMessage{{sender_uid, step}, {1}});
+        bus.route_messages();
+        return channel.unload_messages();
+    };
+
+    for (knp::core::Step step = 0; step < 10; ++step) ASSERT_EQ(send_and_update(step), 1);
+
+    // Steps before 6 are discarded.
+    auto messages = channel.read_some_from_buffer(0, 7);
+    ASSERT_EQ(messages.size(), 2);
+    ASSERT_EQ(messages[0].header_.send_time_, 6);
+    ASSERT_EQ(messages[1].header_.send_time_, 7);
+    // Read messages are removed from the buffer.
+    ASSERT_TRUE(channel.read_some_from_buffer(0, 7).empty());
+
+    // The step is too old for the buffer limit.
+    ASSERT_EQ(send_and_update(2), 0);
+
+    channel.set_max_buffered_steps(1);
+    messages = channel.read_some_from_buffer(0, 100);
+    ASSERT_EQ(messages.size(), 1);
+    ASSERT_EQ(messages[0].header_.send_time_, 9);
+
+    // Unlimited buffer keeps all steps.
+    channel.set_max_buffered_steps(0);
+    for (knp::core::Step step = 20; step < 120; ++step) send_and_update(step);
+    // Buffered messages are copied in step order.
+    const auto buffered = channel.update();
+    ASSERT_EQ(buffered.size(), 100);
+    ASSERT_EQ(buffered.front().header_.send_time_, 20);
+    ASSERT_EQ(buffered.back().header_.send_time_, 119);
+    ASSERT_EQ(channel.read_some_from_buffer(20, 119).size(), 100);
+}
@@ -19,7 +19,9 @@
  * limitations under the License.
  */
 
+#include <knp/framework/coordinates/cartesian.h>
 #include <knp/framework/projection/creators.h>
+#include <knp/framework/projection/procedural_rules.h>
 #include <knp/synapse-traits/delta.h>
 
 #include <tests_common.h>
@@ -139,9 +141,109 @@ TEST(ProjectionConnectors, FromMap)
 
 TEST(ProjectionConnectors, FixedProbability)
 {
-    [[maybe_unused]] auto proj =  //!OCLINT
-        knp::framework::projection::creators::fixed_probability<typename knp::synapse_traits::DeltaSynapse>(
-            knp::core::UID(), knp::core::UID(), 3, 5, 0.5);
+    namespace creators = knp::framework::projection::creators;
+    using DeltaSynapse = knp::synapse_traits::DeltaSynapse;
+
+    constexpr size_t src_pop_size = 1000;
+    constexpr size_t dest_pop_size = 2000;
+    constexpr double probability = 0.01;
+
+    auto syn_gen = [](size_t index0, size_t index1)
+    {
+        return knp::core::Projection<DeltaSynapse>::SynapseParameters{
+            static_cast<float>(index0 + index1), 1, knp::synapse_traits::OutputType::EXCITATORY};
+    };
+    auto proj = creators::fixed_probability<DeltaSynapse>(
+        knp::core::UID(), knp::core::UID(), src_pop_size, dest_pop_size, probability, syn_gen, 1, 42);
+    auto parallel_proj = creators::fixed_probability<DeltaSynapse>(
+        knp::core::UID(), knp::core::UID(), src_pop_size, dest_pop_size, probability, syn_gen, 4, 42);
+
+    // Expected number of synapses is 20000 with standard deviation about 140.
+    ASSERT_GT(proj.size(), 19000);
+    ASSERT_LT(proj.size(), 21000);
+
+    // Synapses are unique, ordered by presynaptic neuron, then by postsynaptic neuron, and don't depend on the
+    // number of threads.
+    ASSERT_EQ(parallel_proj.size(), proj.size());
+    for (size_t i = 0; i < proj.size(); ++i)
+    {
+        const auto source = std::get<knp::core::source_neuron_id>(proj[i]);
+        const auto target = std::get<knp::core::target_neuron_id>(proj[i]);
+        ASSERT_EQ(source, std::get<knp::core::source_neuron_id>(parallel_proj[i]));
+        ASSERT_EQ(target, std::get<knp::core::target_neuron_id>(parallel_proj[i]));
+        ASSERT_EQ(std::get<knp::core::synapse_data>(parallel_proj[i]).weight_, static_cast<float>(source + target));
+        if (i)
+        {
+            ASSERT_LT(
+                std::get<knp::core::source_neuron_id>(proj[i - 1]) * dest_pop_size +
+                    std::get<knp::core::target_neuron_id>(proj[i - 1]),
+                source * dest_pop_size + target);
+        }
+    }
+
+    ASSERT_EQ(creators::fixed_probability<DeltaSynapse>(knp::core::UID(), knp::core::UID(), 3, 5, 1).size(), 15);
+    ASSERT_EQ(creators::fixed_probability<DeltaSynapse>(knp::core::UID(), knp::core::UID(), 3, 5, 0).size(), 0);
+    ASSERT_THROW(
+        static_cast<void>(creators::fixed_probability<DeltaSynapse>(knp::core::UID(), knp::core::UID(), 3, 5, 1.5)),
+        std::logic_error);
+}
+
+
+TEST(ProjectionConnectors, ParallelFixedNumberPre)
+{
+    namespace creators = knp::framework::projection::creators;
+    using DeltaSynapse = knp::synapse_traits::DeltaSynapse;
+
+    auto syn_gen = [](size_t index0, size_t index1)
+    {
+        return knp::core::Projection<DeltaSynapse>::SynapseParameters{
+            static_cast<float>(index0 + index1), 1, knp::synapse_traits::OutputType::EXCITATORY};
+    };
+    auto proj = creators::fixed_number_pre<DeltaSynapse>(
+        knp::core::UID(), knp::core::UID(), 100, 50, 10, syn_gen, 1, 42);
+    auto parallel_proj = creators::fixed_number_pre<DeltaSynapse>(
+        knp::core::UID(), knp::core::UID(), 100, 50, 10, syn_gen, 4, 42);
+
+    // Counter-based generator makes the same connections regardless of the number of threads.
+    ASSERT_EQ(proj.size(), 500);
+    ASSERT_EQ(parallel_proj.size(), proj.size());
+    for (size_t i = 0; i < proj.size(); ++i)
+    {
+        ASSERT_EQ(
+            std::get<knp::core::source_neuron_id>(proj[i]), std::get<knp::core::source_neuron_id>(parallel_proj[i]));
+        ASSERT_EQ(
+            std::get<knp::core::target_neuron_id>(proj[i]), std::get<knp::core::target_neuron_id>(parallel_proj[i]));
+        ASSERT_EQ(
+            std::get<knp::core::synapse_data>(parallel_proj[i]).weight_,
+            static_cast<float>(
+                std::get<knp::core::source_neuron_id>(proj[i]) + std::get<knp::core::target_neuron_id>(proj[i])));
+    }
+    ASSERT_EQ(parallel_proj.find_synapses(0, knp::core::Projection<DeltaSynapse>::Search::by_postsynaptic).size(), 10);
+}
+
+
+TEST(ProjectionConnectors, BulkGenerationOrder)
+{
+    using DeltaSynapse = knp::synapse_traits::DeltaSynapse;
+    using Synapse = knp::core::Projection<DeltaSynapse>::Synapse;
+
+    // Every third synapse is generated.
+    auto generator = [](size_t index) -> std::optional<Synapse>
+    {
+        if (index % 3) return std::nullopt;
+        return Synapse{{}, index, index / 3};
+    };
+
+    for (size_t threads_count : {1, 3, 8})
+    {
+        auto synapses =
+            knp::framework::projection::bulk::generate_synapses<DeltaSynapse>(generator, 1000, threads_count);
+        ASSERT_EQ(synapses.size(), 334);
+        for (size_t i = 0; i < synapses.size(); ++i)
+        {
+            ASSERT_EQ(std::get<knp::core::source_neuron_id>(synapses[i]), i * 3);
+        }
+    }
 }
 
 
@@ -244,3 +346,62 @@ TEST(ProjectionConnectors, CloneProjection)
         ASSERT_EQ(std::get<knp::core::source_neuron_id>(proj[i]), std::get<knp::core::source_neuron_id>(new_proj[i]));
     }
 }
+
+
+TEST(ProjectionConnectors, ProceduralProjection)
+{
+    using DeltaSynapse = knp::synapse_traits::DeltaSynapse;
+    using Synapse = knp::core::ProceduralProjection<DeltaSynapse>::Synapse;
+    namespace procedural = knp::framework::projection::procedural;
+    constexpr size_t src_pop_size = 50;
+    constexpr size_t dest_pop_size = 200;
+
+    knp::core::ProceduralProjection<DeltaSynapse> projection(
+        knp::core::UID(), knp::core::UID(), src_pop_size,
+        procedural::fixed_probability<DeltaSynapse>(dest_pop_size, 0.1), 42);
+
+    // Synapses of a neuron are the same on every generation.
+    std::vector<Synapse> synapses;
+    std::vector<Synapse> regenerated;
+    projection.generate_synapses(7, synapses);
+    projection.generate_synapses(8, regenerated);
+    projection.generate_synapses(7, regenerated);
+    ASSERT_FALSE(synapses.empty());
+    ASSERT_EQ(synapses.size(), regenerated.size());
+    for (size_t i = 0; i < synapses.size(); ++i)
+    {
+        ASSERT_EQ(std::get<knp::core::source_neuron_id>(synapses[i]), 7);
+        ASSERT_EQ(
+            std::get<knp::core::target_neuron_id>(synapses[i]), std::get<knp::core::target_neuron_id>(regenerated[i]));
+    }
+    projection.generate_synapses(src_pop_size, synapses);
+    ASSERT_TRUE(synapses.empty());
+
+    const auto materialized = projection.materialize();
+    ASSERT_EQ(materialized.get_uid(), projection.get_uid());
+    ASSERT_GT(materialized.size(), src_pop_size * dest_pop_size / 20);
+    ASSERT_LT(materialized.size(), src_pop_size * dest_pop_size / 5);
+    ASSERT_LT(projection.memory_usage().total(), materialized.memory_usage().total());
+
+    knp::core::ProceduralProjection<DeltaSynapse> fixed_number_projection(
+        knp::core::UID(), knp::core::UID(), src_pop_size,
+        procedural::fixed_number_post<DeltaSynapse>(dest_pop_size, 5), 1);
+    ASSERT_EQ(fixed_number_projection.materialize().size(), src_pop_size * 5);
+
+    // Neurons on a line are connected only to the nearest neurons.
+    using Point = knp::framework::coordinates::cartesian::d2::coordinate<float>;
+    std::vector<Point> points;
+    for (size_t i = 0; i < src_pop_size; ++i) points.emplace_back(static_cast<float>(i), 0.0F);
+    knp::core::ProceduralProjection<DeltaSynapse> distance_projection(
+        knp::core::UID(), knp::core::UID(), src_pop_size,
+        procedural::distance_based<DeltaSynapse>(
+            points, points, [](double distance) { return distance < 1.5 ? 1.0 : 0.0; }),
+        3);
+    distance_projection.generate_synapses(10, synapses);
+    ASSERT_EQ(synapses.size(), 3);
+    for (const auto &synapse : synapses)
+    {
+        ASSERT_GE(std::get<knp::core::target_neuron_id>(synapse), 9);
+        ASSERT_LE(std::get<knp::core::target_neuron_id>(synapse), 11);
+    }
+}
@@ -130,3 +130,128 @@ TEST_F(SaveLoadNetworkSuite, SaveLoadTest)
     auto network_loaded = knp::framework::sonata::load_network(path_to_network_);
     ASSERT_TRUE(are_networks_similar(network, network_loaded));
 }
+
+
+TEST_F(SaveLoadNetworkSuite, SaveLoadCompressedTest)
+{
+    path_to_network_ = ".";
+    auto network = make_simple_network();
+    knp::framework::sonata::SaveOptions options;
+    options.chunk_size_ = 2;
+    options.compression_level_ = 6;
+    options.shuffle_ = true;
+    options.compact_constant_datasets_ = true;
+    options.parallel_ = true;
+    knp::framework::sonata::save_network(network, path_to_network_, options);
+    auto network_loaded = knp::framework::sonata::load_network(path_to_network_);
+    ASSERT_TRUE(are_networks_similar(network, network_loaded));
+}
+
+
+TEST_F(SaveLoadNetworkSuite, SaveLoadIndexTest)
+{
+    using DeltaProjection = knp::core::Projection<knp::synapse_traits::DeltaSynapse>;
+    path_to_network_ = ".";
+    const knp::core::UID uid_from, uid_to;
+    // Synapses of the same presynaptic neuron are not adjacent, so the index contains several ranges per neuron.
+    const DeltaProjection projection{
+        uid_from, uid_to,
+        [](size_t index) {
+            return DeltaProjection::Synapse{{}, index % 3, index % 5};
+        },
+        15};
+    knp::framework::Network network;
+    network.add_projection(projection);
+    knp::framework::sonata::save_network(network, path_to_network_);
+    auto network_loaded = knp::framework::sonata::load_network(path_to_network_);
+
+    const auto &loaded = std::get<DeltaProjection>(network_loaded.get_projection(projection.get_uid()));
+    for (size_t neuron = 0; neuron < 5; ++neuron)
+    {
+        for (auto search : {DeltaProjection::Search::by_presynaptic, DeltaProjection::Search::by_postsynaptic})
+        {
+            auto expected = projection.find_synapses(neuron, search);
+            auto found = loaded.find_synapses(neuron, search);
+            std::sort(expected.begin(), expected.end());
+            std::sort(found.begin(), found.end());
+            ASSERT_EQ(expected, found);
+        }
+    }
+}
+
+
+TEST_F(SaveLoadNetworkSuite, LazyLoadTest)
+{
+    using DeltaProjection = knp::core::Projection<knp::synapse_traits::DeltaSynapse>;
+    path_to_network_ = ".";
+    auto network = make_simple_network();
+    knp::framework::sonata::save_network(network, path_to_network_);
+
+    knp::framework::sonata::LoadOptions options;
+    options.lazy_projections_ = true;
+    auto network_loaded = knp::framework::sonata::load_network(path_to_network_, options);
+    ASSERT_EQ(network_loaded.projections_count(), network.projections_count());
+
+    for (const auto &projection : network.get_projections())
+    {
+        const auto &original = std::get<DeltaProjection>(projection);
+        auto &loaded = std::get<DeltaProjection>(network_loaded.get_projection(original.get_uid()));
+        ASSERT_FALSE(loaded.is_loaded());
+        ASSERT_EQ(loaded.size(), 0);
+        ASSERT_EQ(loaded.get_presynaptic(), original.get_presynaptic());
+        ASSERT_EQ(loaded.get_postsynaptic(), original.get_postsynaptic());
+        loaded.load_synapses();
+        ASSERT_TRUE(loaded.is_loaded());
+        ASSERT_EQ(loaded.size(), original.size());
+    }
+    ASSERT_TRUE(are_networks_similar(network, network_loaded));
+}
+
+
+TEST_F(SaveLoadNetworkSuite, SaveLoadUniformParametersTest)
+{
+    using DeltaProjection = knp::core::Projection<knp::synapse_traits::DeltaSynapse>;
+    path_to_network_ = ".";
+    auto generator = [](size_t index)
+    {
+        return DeltaProjection::Synapse{
+            {static_cast<float>(index), static_cast<uint32_t>(index + 1), knp::synapse_traits::OutputType::EXCITATORY},
+            index,
+            index};
+    };
+    const knp::core::UID uid_from, uid_to;
+    DeltaProjection uniform_projection{uid_from, uid_to, generator, 5};
+    auto &uniform_params = uniform_projection.get_shared_parameters().synapses_parameters_;
+    uniform_params.weight_ = 0.5F;
+    uniform_params.delay_ = 3;
+    uniform_params.output_type_ = knp::synapse_traits::OutputType::INHIBITORY_CURRENT;
+    // Parameters that are not declared uniform stay undeclared after loading.
+    DeltaProjection weight_projection{uid_from, uid_to, generator, 5};
+    weight_projection.get_shared_parameters().synapses_parameters_.weight_ = 2.0F;
+
+    knp::framework::Network network;
+    network.add_projection(uniform_projection);
+    network.add_projection(weight_projection);
+    knp::framework::sonata::save_network(network, path_to_network_);
+    auto network_loaded = knp::framework::sonata::load_network(path_to_network_);
+
+    for (const auto *saved : {&uniform_projection, &weight_projection})
+    {
+        const auto &loaded = std::get<DeltaProjection>(network_loaded.get_projection(saved->get_uid()));
+        const auto &saved_params = saved->get_shared_parameters().synapses_parameters_;
+        const auto &loaded_params = loaded.get_shared_parameters().synapses_parameters_;
+        ASSERT_EQ(saved_params.weight_, loaded_params.weight_);
+        ASSERT_EQ(saved_params.delay_, loaded_params.delay_);
+        ASSERT_EQ(saved_params.output_type_, loaded_params.output_type_);
+
+        ASSERT_EQ(saved->size(), loaded.size());
+        for (size_t i = 0; i < saved->size(); ++i)
+        {
+            const auto saved_synapse = saved_params.apply(std::get<knp::core::synapse_data>((*saved)[i]));
+            const auto loaded_synapse = loaded_params.apply(std::get<knp::core::synapse_data>(loaded[i]));
+            ASSERT_EQ(saved_synapse.weight_, loaded_synapse.weight_);
+            ASSERT_EQ(saved_synapse.delay_, loaded_synapse.delay_);
+            ASSERT_EQ(saved_synapse.output_type_, loaded_synapse.output_type_);
+        }
+    }
+}